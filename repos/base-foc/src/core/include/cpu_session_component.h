@@ -64,6 +64,17 @@ namespace Genode {
 			unsigned            const _trace_control_index;
 			Trace::Source             _trace_source;
 
+			/**
+			 * Return instruction pointer of the thread, or 0 if unavailable
+			 */
+			Trace::Instruction_pointer _instruction_pointer() const
+			{
+				/* 'state' is not a const function */
+				try {
+					return const_cast<Platform_thread &>(_platform_thread).state().ip; }
+				catch (...) { return Trace::Instruction_pointer(); }
+			}
+
 		public:
 
 			Cpu_thread_component(size_t const weight,
@@ -92,7 +103,8 @@ namespace Genode {
 			{
 				return { _session_label, _name,
 				         _platform_thread.execution_time(),
-				         _platform_thread.affinity() };
+				         _platform_thread.affinity(),
+				         Trace::Page_faults(), _instruction_pointer() };
 			}
 
 
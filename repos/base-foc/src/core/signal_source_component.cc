@@ -69,10 +69,28 @@ Signal_source::Signal Signal_source_component::wait_for_signal()
 }
 
 
+Signal_source::Signal_batch Signal_source_component::wait_for_signals()
+{
+	Signal_batch batch;
+
+	/*
+	 * The client blocks on its semaphore, not in core. Hence, the batch
+	 * variant returns the pending signals without blocking, like
+	 * 'wait_for_signal'.
+	 */
+	while (!_signal_queue.empty() && !batch.full()) {
+		Signal_context_component *context = _signal_queue.dequeue();
+		batch.add(Signal(context->imprint(), context->cnt()));
+		context->reset_signal_cnt();
+	}
+	return batch;
+}
+
+
 Signal_source_component::Signal_source_component(Rpc_entrypoint *ep)
 :
 	Signal_source_rpc_object(cap_map()->insert(platform_specific()->cap_id_alloc()->alloc())),
-	_entrypoint(ep), _finalizer(*this),
+	_entrypoint(ep), _reply_batched(false), _finalizer(*this),
 	_finalizer_cap(_entrypoint->manage(&_finalizer))
 {
 	using namespace Fiasco;
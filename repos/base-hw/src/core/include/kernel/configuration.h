@@ -29,6 +29,13 @@ namespace Kernel
 
 	/* time slice for the round-robin mode and the idle in CPU scheduling */
 	constexpr unsigned cpu_fill_ms = 10;
+
+	/*
+	 * Wether CPUs that would idle take over fill-only threads of other CPUs,
+	 * disabled by default as it migrates threads away from the CPU they were
+	 * placed on by their CPU session
+	 */
+	constexpr bool cpu_balancing = false;
 }
 
 #endif /* _KERNEL__CONFIGURATION_H_ */
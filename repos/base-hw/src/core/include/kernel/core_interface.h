@@ -101,15 +101,18 @@ namespace Kernel
 	 * \param cpu_id  kernel name of the targeted CPU
 	 * \param pd      pointer to pd kernel object
 	 * \param utcb    core local pointer to userland thread-context
+	 * \param cpu_cnt  number of CPUs, starting with 'cpu_id', the thread
+	 *                 may be moved to by the kernel
 	 *
 	 * \retval   0  suceeded
 	 * \retval !=0  failed
 	 */
 	inline int start_thread(Thread * const thread, unsigned const cpu_id,
-	                        Pd * const pd, Native_utcb * const utcb)
+	                        Pd * const pd, Native_utcb * const utcb,
+	                        unsigned const cpu_cnt = 1)
 	{
 		return call(call_id_start_thread(), (Call_arg)thread, cpu_id,
-		            (Call_arg)pd, (Call_arg)utcb);
+		            (Call_arg)pd, (Call_arg)utcb, cpu_cnt);
 	}
 
 
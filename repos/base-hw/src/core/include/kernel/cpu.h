@@ -121,8 +121,11 @@ class Kernel::Cpu_job : public Cpu_share
 {
 	protected:
 
-		Cpu *          _cpu;
-		Cpu_lazy_state _lazy_state;
+		Cpu *              _cpu;
+		Cpu_lazy_state     _lazy_state;
+		unsigned           _cpu_first = 0;
+		unsigned           _cpu_count = 1;
+		unsigned long long _execution_time = 0; /* in timer tics */
 
 		/**
 		 * Handle interrupt exception that occured during execution on CPU 'id'
@@ -149,6 +152,11 @@ class Kernel::Cpu_job : public Cpu_share
 		 */
 		bool _helping_possible(Cpu_job * const j) { return j->_cpu == _cpu; }
 
+		/**
+		 * Return wether the job may currently be moved to another CPU
+		 */
+		virtual bool _migratable() { return false; }
+
 	public:
 
 		/**
@@ -178,8 +186,31 @@ class Kernel::Cpu_job : public Cpu_share
 
 		/**
 		 * Link job to CPU 'cpu'
+		 *
+		 * \param cpu_count  number of CPUs, starting with 'cpu', that may
+		 *                   execute the job if it owns no CPU claim
+		 */
+		void affinity(Cpu * const cpu, unsigned const cpu_count = 1);
+
+		/**
+		 * Return wether the job may be moved to CPU 'cpu'
+		 */
+		bool balanceable_to(Cpu * const cpu);
+
+		/**
+		 * Move the ready job from its current CPU to CPU 'cpu'
 		 */
-		void affinity(Cpu * const cpu);
+		void migrate(Cpu * const cpu);
+
+		/**
+		 * Account 'tics' timer tics to the execution time of the job
+		 */
+		void consumed(unsigned const tics) { _execution_time += tics; }
+
+		/**
+		 * Return execution time consumed by the job in microseconds
+		 */
+		unsigned long long execution_time() const;
 
 		/**
 		 * Set CPU quota of the job to 'q'
@@ -318,6 +349,7 @@ class Kernel::Cpu : public Genode::Cpu,
 
 		unsigned id() const { return _id; }
 		Cpu_scheduler * scheduler() { return &_scheduler; }
+		Cpu_job const * idle() const { return &_idle; }
 };
 
 class Kernel::Cpu_pool
@@ -346,6 +378,15 @@ class Kernel::Cpu_pool
 		 */
 		Cpu * executing_cpu() const { return cpu(Cpu::executing_id()); }
 
+		/**
+		 * Let CPU 'cpu', that would idle otherwise, take over a job
+		 *
+		 * The job is one of the ready fill-only jobs that wait for another
+		 * CPU. Claims as well as jobs that are bound to other CPUs by their
+		 * affinity remain untouched.
+		 */
+		void balance(Cpu * const cpu);
+
 		/*
 		 * Accessors
 		 */
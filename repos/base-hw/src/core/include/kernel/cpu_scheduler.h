@@ -218,6 +218,24 @@ class Kernel::Cpu_scheduler
 		 */
 		void quota(Share * const s, unsigned const q);
 
+		/**
+		 * Return first ready share that might be handed to another scheduler
+		 *
+		 * \param f  functor of type 'bool (Share *)' that finally decides
+		 *           about each share that is neither the head nor a claim
+		 *
+		 * \return  share or 0 if there is no suitable share
+		 */
+		template <typename F> Share * fill_candidate(F f)
+		{
+			for (Fill * i = _fills.head(); i; i = Fill_list::next(i)) {
+				Share * const s = _share(i);
+				if (s == _head || s->_quota) { continue; }
+				if (f(s)) { return s; }
+			}
+			return 0;
+		}
+
 		/*
 		 * Accessors
 		 */
@@ -47,7 +47,7 @@ namespace Kernel
 
 	/**
 	 * A tree of object identity references to retrieve the capabilities
-	 * of one PD fastly.
+	 * of one PD fastly, fronted by a table of recently used references
 	 */
 	class Object_identity_reference_tree;
 
@@ -148,8 +148,27 @@ class Kernel::Object_identity_reference
 class Kernel::Object_identity_reference_tree
 : public Genode::Avl_tree<Kernel::Object_identity_reference>
 {
+	private:
+
+		using Reference = Object_identity_reference;
+		using Tree      = Genode::Avl_tree<Reference>;
+
+		/*
+		 * Capability IDs are allocated densely per PD. Thus, a table that
+		 * is indexed by the low bits of the ID holds the reference of
+		 * almost every ID in use and spares the tree walk.
+		 */
+		enum { TABLE_SIZE = 256 };
+
+		Reference * _table[TABLE_SIZE] { };
+
+		static unsigned _index(capid_t const id) { return id % TABLE_SIZE; }
+
 	public:
 
+		void insert(Reference * const r);
+		void remove(Reference * const r);
+
 		Object_identity_reference * find(capid_t id);
 
 		template <typename KOBJECT>
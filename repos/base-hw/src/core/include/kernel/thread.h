@@ -110,6 +110,11 @@ class Kernel::Thread
 
 		void _init();
 
+		/**
+		 * Cpu_job interface
+		 */
+		bool _migratable();
+
 		/**
 		 * Notice that another thread yielded the CPU to this thread
 		 */
@@ -181,7 +181,8 @@ namespace Genode {
 			/**
 			 * Return execution time consumed by the thread
 			 */
-			unsigned long long execution_time() const { return 0; }
+			unsigned long long execution_time() const {
+				return kernel_object()->execution_time(); }
 
 
 			/***************
@@ -173,6 +173,7 @@ class Genode::Cpu : public Arm
 		 *************/
 
 		static void prepare_proceeding(Cpu_lazy_state *, Cpu_lazy_state *) { }
+		static bool lazy_state_loaded(Cpu_lazy_state *) { return false; }
 		static void wait_for_interrupt() { /* FIXME */ }
 		static void data_synchronization_barrier() { /* FIXME */ }
 		static void invalidate_control_flow_predictions() { /* FIXME */ }
@@ -437,6 +437,7 @@ class Genode::Cpu : public Arm_v7
 		static void tlb_insertions() { inval_branch_predicts(); }
 		static void translation_added(addr_t, size_t) { }
 		static void prepare_proceeding(Cpu_lazy_state *, Cpu_lazy_state *) { }
+		static bool lazy_state_loaded(Cpu_lazy_state *) { return false; }
 };
 
 void Genode::Arm_v7::finish_init_phys_kernel() { }
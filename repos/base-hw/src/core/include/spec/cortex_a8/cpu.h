@@ -80,6 +80,7 @@ class Genode::Cpu : public Arm_v7
 		 *************/
 
 		static void prepare_proceeding(Cpu_lazy_state *, Cpu_lazy_state *) { }
+		static bool lazy_state_loaded(Cpu_lazy_state *) { return false; }
 };
 
 void Genode::Arm_v7::finish_init_phys_kernel() { }
@@ -261,6 +261,12 @@ class Genode::Cpu : public Arm_v7
 			_toggle_advanced_fp_simd(false);
 		}
 
+		/**
+		 * Return wether 'state' is held by the advanced FP/SIMD registers
+		 */
+		bool lazy_state_loaded(Cpu_lazy_state * const state) const {
+			return _advanced_fp_simd_state == state; }
+
 		/**
 		 * Return wether to retry an undefined user instruction after this call
 		 *
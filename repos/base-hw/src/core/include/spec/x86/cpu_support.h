@@ -411,6 +411,12 @@ class Genode::Cpu
 		 */
 		bool retry_undefined_instr(Cpu_lazy_state *) { return false; }
 
+		/**
+		 * Return whether 'state' is held by the FPU registers
+		 */
+		bool lazy_state_loaded(Cpu_lazy_state * const state) const {
+			return _fpu_state == state; }
+
 		/**
 		 * Return whether to retry an FPU instruction after this call
 		 */
@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <rm_session/rm_session.h>
 #include <base/printf.h>
+#include <util/misc_math.h>
 
 namespace Genode
 {
@@ -89,8 +90,18 @@ namespace Genode
 	 */
 	inline size_t constrain_map_size_log2(size_t size_log2)
 	{
-		if (size_log2<20) return 12;
-		return 20;
+		/*
+		 * The translation tables accept mappings of any page-granular size.
+		 * Below the section size, we resolve a fault with up to
+		 * 'FAULT_AROUND_SIZE_LOG2' bytes around the fault address so that
+		 * the neighbouring pages of the same dataspace do not fault again.
+		 * Larger sizes are limited to sections. RM sessions can narrow the
+		 * window further via the 'fault_around' session argument.
+		 */
+		enum { SECTION_SIZE_LOG2 = 20, FAULT_AROUND_SIZE_LOG2 = 16 };
+
+		if (size_log2 >= SECTION_SIZE_LOG2) return SECTION_SIZE_LOG2;
+		return min(size_log2, (size_t)FAULT_AROUND_SIZE_LOG2);
 	}
 
 	/**
@@ -103,10 +103,41 @@ void Cpu_job::_interrupt(unsigned const cpu_id)
 }
 
 
-void Cpu_job::affinity(Cpu * const cpu)
+void Cpu_job::affinity(Cpu * const cpu, unsigned const cpu_count)
 {
+	_cpu       = cpu;
+	_cpu_first = cpu->id();
+	_cpu_count = cpu_count;
+	_cpu->scheduler()->insert(this);
+}
+
+
+bool Cpu_job::balanceable_to(Cpu * const cpu)
+{
+	if (cpu->id() < _cpu_first || cpu->id() >= _cpu_first + _cpu_count) {
+		return false; }
+
+	/* FPU state that resides in the registers of our CPU can't follow us */
+	if (_cpu->lazy_state_loaded(&_lazy_state)) { return false; }
+	return _migratable();
+}
+
+
+void Cpu_job::migrate(Cpu * const cpu)
+{
+	_cpu->scheduler()->unready(this);
+	_cpu->scheduler()->remove(this);
 	_cpu = cpu;
 	_cpu->scheduler()->insert(this);
+	_cpu->scheduler()->ready(this);
+}
+
+
+unsigned long long Cpu_job::execution_time() const
+{
+	unsigned long long const tics_per_ms = cpu_pool()->timer()->ms_to_tics(1);
+	return (_execution_time / tics_per_ms) * 1000 +
+	       (_execution_time % tics_per_ms) * 1000 / tics_per_ms;
 }
 
 
@@ -188,8 +219,13 @@ void Cpu::exception()
 	unsigned const old_time = _scheduler.head_quota();
 	unsigned const new_time = _timer->value(_id);
 	unsigned quota = old_time > new_time ? old_time - new_time : 1;
+	old_job->consumed(quota);
 	_scheduler.update(quota);
 
+	/* rather take over work of another CPU than idle */
+	if (cpu_balancing && NR_OF_CPUS > 1 && _scheduler.head() == &_idle) {
+		cpu_pool()->balance(this); }
+
 	/* get new job */
 	Job * const new_job = scheduled_job();
 	quota = _scheduler.head_quota();
@@ -275,6 +311,27 @@ Cpu * Cpu_pool::cpu(unsigned const id) const
 }
 
 
+void Cpu_pool::balance(Cpu * const target)
+{
+	for (unsigned i = 1; i < NR_OF_CPUS; i++) {
+
+		/* start with the successor of the target to spread the load */
+		Cpu * const source = cpu((target->id() + i) % NR_OF_CPUS);
+		Cpu_share * const share = source->scheduler()->fill_candidate(
+			[&] (Cpu_share * const s) {
+				Cpu_job * const job = static_cast<Cpu_job *>(s);
+				return job != source->scheduled_job() &&
+				       job->balanceable_to(target);
+			});
+		if (!share) { continue; }
+
+		static_cast<Cpu_job *>(share)->migrate(target);
+		target->scheduler()->update(0);
+		return;
+	}
+}
+
+
 Cpu_pool::Cpu_pool()
 {
 	for (unsigned id = 0; id < NR_OF_CPUS; id++) {
@@ -47,8 +47,16 @@ Object_identity_reference::find(Pd * pd)
 	if (!_identity) return nullptr;
 
 	for (Object_identity_reference * oir = _identity->first();
-	     oir; oir = oir->next())
-		if (pd == &(oir->_pd)) return oir;
+	     oir; oir = oir->next()) {
+		if (pd != &(oir->_pd)) continue;
+
+		/* move to front as the same object is often delegated repeatedly */
+		if (oir != _identity->first()) {
+			_identity->remove(oir);
+			_identity->insert(oir);
+		}
+		return oir;
+	}
 	return nullptr;
 }
 
@@ -97,5 +105,31 @@ Object_identity_reference::~Object_identity_reference()
 }
 
 
-Object_identity_reference * Object_identity_reference_tree::find(capid_t id) {
-	return (first()) ? first()->find(id) : nullptr; }
+/************************************
+ ** Object_identity_reference_tree **
+ ************************************/
+
+void Object_identity_reference_tree::insert(Reference * const r)
+{
+	Tree::insert(r);
+	_table[_index(r->capid())] = r;
+}
+
+
+void Object_identity_reference_tree::remove(Reference * const r)
+{
+	Reference * & entry = _table[_index(r->capid())];
+	if (entry == r) entry = nullptr;
+	Tree::remove(r);
+}
+
+
+Object_identity_reference * Object_identity_reference_tree::find(capid_t id)
+{
+	Reference * & entry = _table[_index(id)];
+	if (entry && entry->capid() == id) return entry;
+
+	Reference * const r = (first()) ? first()->find(id) : nullptr;
+	if (r) entry = r;
+	return r;
+}
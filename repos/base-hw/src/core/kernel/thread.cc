@@ -208,6 +208,15 @@ void Thread::_call_thread_quota()
 }
 
 
+bool Thread::_migratable()
+{
+	/* our helpers lend us their CPU share only on our current CPU */
+	bool helped = false;
+	for_each_helper([&] (Ipc_node * const) { helped = true; });
+	return _state == ACTIVE && !helped;
+}
+
+
 void Thread::_call_start_thread()
 {
 	/* lookup CPU */
@@ -222,7 +231,11 @@ void Thread::_call_start_thread()
 
 	assert(thread->_state == AWAITS_START)
 
-	thread->affinity(cpu);
+	/* the thread may be balanced only among existing CPUs */
+	unsigned const cpu_count =
+		Genode::min(Genode::max((unsigned)user_arg_5(), 1U),
+		            NR_OF_CPUS - cpu->id());
+	thread->affinity(cpu, cpu_count);
 
 	/* join protection domain */
 	thread->_pd = (Pd *) user_arg_3();
@@ -15,6 +15,7 @@
 /* Genode includes */
 #include <base/printf.h>
 #include <base/sleep.h>
+#include <base/snprintf.h>
 #include <kernel/log.h>
 
 /* core includes */
@@ -26,8 +27,10 @@
 #include <util.h>
 #include <pic.h>
 #include <kernel/kernel.h>
+#include <kernel/cpu.h>
 #include <translation_table.h>
 #include <trustzone.h>
+#include <trace/source_registry.h>
 
 using namespace Genode;
 
@@ -155,6 +158,39 @@ Platform::Platform()
 		_rom_fs.insert(rom_module);
 	}
 
+	/* add the idle jobs of the kernel to trace sources */
+	for (unsigned i = 0; i < NR_OF_CPUS; i++) {
+
+		struct Idle_trace_source : Trace::Source::Info_accessor, Trace::Control,
+		                           Trace::Source
+		{
+			Affinity::Location const affinity;
+
+			/**
+			 * Trace::Source::Info_accessor interface
+			 */
+			Info trace_source_info() const override
+			{
+				char name[32];
+				snprintf(name, sizeof(name), "idle%d", affinity.xpos());
+
+				Kernel::Cpu * const cpu = Kernel::cpu_pool()->cpu(affinity.xpos());
+
+				return { Trace::Session_label("kernel"), Trace::Thread_name(name),
+				         Trace::Execution_time(cpu->idle()->execution_time()),
+				         affinity };
+			}
+
+			Idle_trace_source(Affinity::Location affinity)
+			:
+				Trace::Source(*this, *this), affinity(affinity)
+			{ }
+		};
+
+		Trace::sources().insert(new (core_mem_alloc())
+			Idle_trace_source(Affinity::Location(i, 0, 1, 1)));
+	}
+
 	/* print ressource summary */
 	if (VERBOSE) {
 		printf("Core virtual memory allocator\n");
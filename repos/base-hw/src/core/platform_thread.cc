@@ -164,6 +164,10 @@ int Platform_thread::start(void * const ip, void * const sp)
 	unsigned const cpu =
 		_location.valid() ? _location.xpos() : Cpu::primary_id();
 
+	/* the kernel may balance the thread within the width of its location */
+	unsigned const cpu_cnt =
+		_location.valid() ? min(_location.width(), NR_OF_CPUS - cpu) : 1;
+
 	Native_utcb * utcb = Thread_base::myself()->utcb();
 
 	/* reset capability counter */
@@ -174,7 +178,7 @@ int Platform_thread::start(void * const ip, void * const sp)
 		utcb->cap_add(_utcb.dst());
 	}
 	Kernel::start_thread(kernel_object(), cpu, _pd->kernel_pd(),
-	                     _utcb_core_addr);
+	                     _utcb_core_addr, cpu_cnt);
 	return 0;
 }
 
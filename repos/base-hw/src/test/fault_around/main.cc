@@ -0,0 +1,118 @@
+/*
+ * \brief  Test for resolving page faults with neighbouring pages
+ * \author agent
+ * \date   2015-11-27
+ *
+ * The test touches each page of a freshly attached RAM dataspace and
+ * obtains the number of page faults core resolved for the address space via
+ * the TRACE service. With fault-around in place, each fault maps several
+ * pages. A second pass attaches the dataspace to an RM session that
+ * restricts the fault-around window to a single page.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <rm_session/connection.h>
+#include <trace_session/connection.h>
+#include <util/string.h>
+
+using namespace Genode;
+
+
+static Trace::Page_faults page_faults(Trace::Connection &trace)
+{
+	enum { MAX_SUBJECTS = 32 };
+	static Trace::Subject_id subjects[MAX_SUBJECTS];
+
+	size_t const num_subjects = trace.subjects(subjects, MAX_SUBJECTS);
+
+	/* all threads of the address space share the same statistics */
+	for (size_t i = 0; i < num_subjects; i++) {
+		Trace::Subject_info const info = trace.subject_info(subjects[i]);
+		if (strcmp(info.session_label().string(), "init -> test") == 0)
+			return info.page_faults();
+	}
+
+	PERR("trace subject of test not found");
+	throw -1;
+}
+
+
+/**
+ * Touch each page at 'ptr' and return number of resolved page faults
+ */
+static unsigned long touch(Trace::Connection &trace, char *ptr, size_t size)
+{
+	enum { PAGE_SIZE = 4096 };
+
+	Trace::Page_faults const before = page_faults(trace);
+
+	for (size_t i = 0; i < size; i += PAGE_SIZE)
+		ptr[i] = 1;
+
+	Trace::Page_faults const after = page_faults(trace);
+
+	unsigned long const faults = after.faults - before.faults;
+	unsigned long const pages  = after.pages  - before.pages;
+
+	printf("touched %zu pages, %lu page faults, %lu pages mapped\n",
+	       size/PAGE_SIZE, faults, pages);
+
+	return faults;
+}
+
+
+int main()
+{
+	printf("--- fault-around test ---\n");
+
+	enum { DS_SIZE = 4*1024*1024, PAGE_SIZE = 4096, PAGE_SIZE_LOG2 = 12 };
+
+	static Trace::Connection trace(64*1024, 4*1024, 0);
+
+	/* default fault-around window */
+	{
+		Ram_dataspace_capability ds = env()->ram_session()->alloc(DS_SIZE);
+		char *ptr = env()->rm_session()->attach(ds);
+
+		unsigned long const faults = touch(trace, ptr, DS_SIZE);
+
+		env()->rm_session()->detach(ptr);
+		env()->ram_session()->free(ds);
+
+		if (faults == 0 || faults >= DS_SIZE/PAGE_SIZE) {
+			PERR("no page faults resolved with more than one page");
+			return -1;
+		}
+	}
+
+	/* fault-around window restricted to one page by a managed dataspace */
+	{
+		Ram_dataspace_capability ds = env()->ram_session()->alloc(DS_SIZE);
+		Rm_connection rm(0, DS_SIZE, PAGE_SIZE_LOG2);
+		rm.attach_at(ds, 0);
+		char *ptr = env()->rm_session()->attach(rm.dataspace());
+
+		unsigned long const faults = touch(trace, ptr, DS_SIZE);
+
+		env()->rm_session()->detach(ptr);
+		rm.detach((addr_t)0);
+		env()->ram_session()->free(ds);
+
+		if (faults != DS_SIZE/PAGE_SIZE) {
+			PERR("fault-around window of RM session not respected");
+			return -1;
+		}
+	}
+
+	printf("--- test finished ---\n");
+	return 0;
+}
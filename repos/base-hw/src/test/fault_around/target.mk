@@ -0,0 +1,3 @@
+TARGET = test-fault_around
+SRC_CC = main.cc
+LIBS   = base
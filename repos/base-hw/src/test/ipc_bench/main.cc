@@ -0,0 +1,174 @@
+/*
+ * \brief  Micro-benchmark of RPCs that delegate capabilities
+ * \author agent
+ * \date   2015-12-08
+ *
+ * The program acts as server or client depending on its configuration. As
+ * both run in different protection domains, the kernel has to translate
+ * each delegated capability from the cap space of the sender to the one of
+ * the receiver.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/sleep.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/connection.h>
+#include <cap_session/connection.h>
+#include <root/component.h>
+#include <timer_session/connection.h>
+#include <os/config.h>
+
+namespace Ipc_bench {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Session_client;
+	struct Session_component;
+	struct Root;
+	struct Connection;
+}
+
+
+struct Ipc_bench::Session : Genode::Session
+{
+	static const char *service_name() { return "Ipc_bench"; }
+
+	virtual void null() = 0;
+	virtual void take(Dataspace_capability ds) = 0;
+	virtual Dataspace_capability give() = 0;
+
+	GENODE_RPC(Rpc_null, void, null);
+	GENODE_RPC(Rpc_take, void, take, Dataspace_capability);
+	GENODE_RPC(Rpc_give, Dataspace_capability, give);
+	GENODE_RPC_INTERFACE(Rpc_null, Rpc_take, Rpc_give);
+};
+
+
+struct Ipc_bench::Session_client : Genode::Rpc_client<Session>
+{
+	Session_client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	void null() override { call<Rpc_null>(); }
+	void take(Dataspace_capability ds) override { call<Rpc_take>(ds); }
+	Dataspace_capability give() override { return call<Rpc_give>(); }
+};
+
+
+struct Ipc_bench::Connection : Genode::Connection<Session>, Session_client
+{
+	Connection()
+	:
+		Genode::Connection<Session>(session("ram_quota=4K")),
+		Session_client(cap())
+	{ }
+};
+
+
+struct Ipc_bench::Session_component : Genode::Rpc_object<Session>
+{
+	Ram_dataspace_capability const ds = env()->ram_session()->alloc(4096);
+
+	~Session_component() { env()->ram_session()->free(ds); }
+
+	void null() override { }
+	void take(Dataspace_capability) override { }
+	Dataspace_capability give() override { return ds; }
+};
+
+
+struct Ipc_bench::Root : Genode::Root_component<Session_component>
+{
+	Session_component *_create_session(const char *) override {
+		return new (md_alloc()) Session_component(); }
+
+	Root(Rpc_entrypoint &ep, Allocator &md_alloc)
+	: Root_component<Session_component>(&ep, &md_alloc) { }
+};
+
+
+using namespace Genode;
+
+
+template <typename FN>
+static void measure(Timer::Connection &timer, char const *name, FN const &fn)
+{
+	enum { ROUNDS = 100*1000 };
+
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < ROUNDS; i++)
+		fn(i);
+
+	unsigned long const ms = timer.elapsed_ms() - start_ms;
+
+	printf("%-28s %6lu ns per call\n", name, (ms*1000*1000)/ROUNDS);
+}
+
+
+static void client()
+{
+	enum { NUM_DS = 64 };
+
+	static Timer::Connection     timer;
+	static Ipc_bench::Connection bench;
+
+	static Ram_dataspace_capability ds[NUM_DS];
+	for (unsigned i = 0; i < NUM_DS; i++)
+		ds[i] = env()->ram_session()->alloc(4096);
+
+	printf("--- IPC benchmark ---\n");
+
+	measure(timer, "null RPC", [&] (unsigned) {
+		bench.null(); });
+
+	measure(timer, "delegate the same cap", [&] (unsigned) {
+		bench.take(ds[0]); });
+
+	measure(timer, "delegate alternating caps", [&] (unsigned i) {
+		bench.take(ds[i % NUM_DS]); });
+
+	measure(timer, "receive the same cap", [&] (unsigned) {
+		bench.give(); });
+
+	printf("--- IPC benchmark finished ---\n");
+}
+
+
+static void server()
+{
+	enum { STACK_SIZE = 4096*sizeof(long) };
+
+	static Cap_connection  cap;
+	static Rpc_entrypoint  ep(&cap, STACK_SIZE, "ipc_bench_ep");
+	static Ipc_bench::Root root(ep, *env()->heap());
+
+	env()->parent()->announce(ep.manage(&root));
+}
+
+
+int main()
+{
+	bool is_server = false;
+	try {
+		is_server = config()->xml_node().attribute("role").has_value("server"); }
+	catch (...) { }
+
+	if (is_server)
+		server();
+	else
+		client();
+
+	sleep_forever();
+	return 0;
+}
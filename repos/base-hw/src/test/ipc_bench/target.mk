@@ -0,0 +1,3 @@
+TARGET = test-ipc_bench
+SRC_CC = main.cc
+LIBS   = base config
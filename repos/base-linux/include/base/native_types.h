@@ -75,7 +75,18 @@ namespace Genode {
 		 */
 		Thread_meta_data *meta_data;
 
-		Native_thread() : is_ipc_server(false), futex_counter(0), meta_data(0) { }
+		/**
+		 * Socket pair used for receiving the replies of RPC calls
+		 *
+		 * The reply channel is created at the first RPC call of the thread
+		 * and reused for all subsequent calls.
+		 */
+		int reply_sd[2];
+
+		Native_thread() : is_ipc_server(false), futex_counter(0), meta_data(0)
+		{
+			reply_sd[0] = reply_sd[1] = -1;
+		}
 	};
 
 	inline bool operator == (Native_thread_id t1, Native_thread_id t2) {
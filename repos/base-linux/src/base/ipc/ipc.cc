@@ -301,46 +301,73 @@ static void extract_sds_from_message(unsigned start_index, Message const &msg,
 
 
 /**
- * Send request to server and wait for reply
+ * Reply channel of the calling thread
+ *
+ * Each thread keeps a socket pair for receiving replies. The remote socket is
+ * passed along with each request and the server closes its copy of the
+ * socket after replying. Reusing the channel for all calls of the thread
+ * saves the creation and destruction of a socket pair per call.
  */
-static inline void lx_call(int dst_sd,
-                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
-                           Genode::Msgbuf_base &recv_msgbuf)
+struct Reply_channel
 {
-	int ret;
-	Message send_msg(send_msgbuf.buf, send_msg_len);
+	enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
 
-	/*
-	 * Create reply channel
+	int * const sd;
+
+	static int *_sds_of_myself()
+	{
+		Genode::Thread_base *thread = Genode::Thread_base::myself();
+		if (thread)
+			return thread->tid().reply_sd;
+
+		/* the main thread has no 'Thread_base' object */
+		static int main_thread_sd[2] = { -1, -1 };
+		return main_thread_sd;
+	}
+
+	Reply_channel() : sd(_sds_of_myself())
+	{
+		if (sd[LOCAL_SOCKET] != -1)
+			return;
+
+		int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
+		if (ret < 0) {
+			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
+			PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
+			throw Genode::Ipc_error();
+		}
+	}
+
+	/**
+	 * Close the channel
 	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
+	 * This must be done whenever a call was aborted because a late reply
+	 * to the aborted call must not be mistaken as reply to the next call.
 	 */
-	struct Reply_channel
+	void discard()
 	{
-		enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
-		int sd[2];
+		if (sd[LOCAL_SOCKET]  != -1) lx_close(sd[LOCAL_SOCKET]);
+		if (sd[REMOTE_SOCKET] != -1) lx_close(sd[REMOTE_SOCKET]);
 
-		Reply_channel()
-		{
-			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
+		sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
+	}
 
-			int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
-			if (ret < 0) {
-				PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
-				throw Genode::Ipc_error();
-			}
-		}
+	int local_socket()  const { return sd[LOCAL_SOCKET];  }
+	int remote_socket() const { return sd[REMOTE_SOCKET]; }
+};
 
-		~Reply_channel()
-		{
-			if (sd[LOCAL_SOCKET]  != -1) lx_close(sd[LOCAL_SOCKET]);
-			if (sd[REMOTE_SOCKET] != -1) lx_close(sd[REMOTE_SOCKET]);
-		}
 
-		int local_socket()  const { return sd[LOCAL_SOCKET];  }
-		int remote_socket() const { return sd[REMOTE_SOCKET]; }
+/**
+ * Send request to server and wait for reply
+ */
+static inline void lx_call(int dst_sd,
+                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
+                           Genode::Msgbuf_base &recv_msgbuf)
+{
+	int ret;
+	Message send_msg(send_msgbuf.buf, send_msg_len);
 
-	} reply_channel;
+	Reply_channel reply_channel;
 
 	/* assemble message */
 
@@ -355,6 +382,7 @@ static inline void lx_call(int dst_sd,
 	if (ret < 0) {
 		PRAW("[%d] lx_sendmsg to sd %d failed with %d in lx_call()",
 		     lx_getpid(), dst_sd, ret);
+		reply_channel.discard();
 		throw Genode::Ipc_error();
 	}
 
@@ -366,11 +394,14 @@ static inline void lx_call(int dst_sd,
 	ret = lx_recvmsg(reply_channel.local_socket(), recv_msg.msg(), 0);
 
 	/* system call got interrupted by a signal */
-	if (ret == -LX_EINTR)
+	if (ret == -LX_EINTR) {
+		reply_channel.discard();
 		throw Genode::Blocking_canceled();
+	}
 
 	if (ret < 0) {
 		PRAW("[%d] lx_recvmsg failed with %d in lx_call()", lx_getpid(), ret);
+		reply_channel.discard();
 		throw Genode::Ipc_error();
 	}
 
@@ -47,44 +47,38 @@ class Genode::Socket_descriptor_registry
 
 	private:
 
+		/*
+		 * Each IPC call looks up the global ID of each received socket
+		 * descriptor. Hence, entries are organized in two hash tables, one
+		 * keyed by the global ID and one keyed by the socket descriptor,
+		 * instead of scanning the whole registry per lookup.
+		 */
+
+		enum { NUM_BUCKETS = 64, INVALID = -1 };
+
 		struct Entry
 		{
 			int fd;
 			int global_id;
 
+			int next_by_fd;   /* next entry in fd bucket, or free list */
+			int next_by_id;   /* next entry in global-ID bucket */
+
 			/**
 			 * Default constructor creates empty entry
 			 */
-			Entry() : fd(-1), global_id(-1) { }
-
-			Entry(int fd, int global_id) : fd(fd), global_id(global_id) { }
-
-			bool is_free() const { return fd == -1; }
-
-			void mark_as_free() { fd = -1; }
+			Entry() : fd(-1), global_id(-1), next_by_fd(INVALID), next_by_id(INVALID) { }
 		};
 
 		Entry _entries[MAX_FDS];
 
-		Genode::Lock mutable _lock;
-
-		Entry &_find_free_entry()
-		{
-			for (unsigned i = 0; i < MAX_FDS; i++)
-				if (_entries[i].is_free())
-					return _entries[i];
-
-			throw Limit_reached();
-		}
+		int _fd_buckets[NUM_BUCKETS];
+		int _id_buckets[NUM_BUCKETS];
+		int _free_list;
 
-		Entry &_find_entry_by_fd(int fd)
-		{
-			for (unsigned i = 0; i < MAX_FDS; i++)
-				if (_entries[i].fd == fd)
-					return _entries[i];
+		Genode::Lock mutable _lock;
 
-			throw Limit_reached();
-		}
+		static unsigned _bucket(int key) { return (unsigned)key % NUM_BUCKETS; }
 
 		/**
 		 * Lookup file descriptor that belongs to specified global ID
@@ -93,24 +87,60 @@ class Genode::Socket_descriptor_registry
 		 */
 		int _lookup_fd_by_global_id(int global_id) const
 		{
-			for (unsigned i = 0; i < MAX_FDS; i++)
+			for (int i = _id_buckets[_bucket(global_id)]; i != INVALID;
+			     i = _entries[i].next_by_id)
 				if (_entries[i].global_id == global_id)
 					return _entries[i].fd;
 
 			return -1;
 		}
 
+		/**
+		 * Remove entry 'idx' from the bucket chain starting at 'link'
+		 */
+		template <typename NEXT_FN>
+		void _unlink(int *link, int idx, NEXT_FN const &next)
+		{
+			for (; *link != INVALID; link = &next(_entries[*link]))
+				if (*link == idx) {
+					*link = next(_entries[idx]);
+					return;
+				}
+		}
+
 	public:
 
+		Socket_descriptor_registry() : _free_list(INVALID)
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				_fd_buckets[i] = _id_buckets[i] = INVALID;
+
+			for (int i = MAX_FDS - 1; i >= 0; i--) {
+				_entries[i].next_by_fd = _free_list;
+				_free_list = i;
+			}
+		}
+
 		void disassociate(int sd)
 		{
 			Genode::Lock::Guard guard(_lock);
 
-			for (unsigned i = 0; i < MAX_FDS; i++)
-				if (_entries[i].fd == sd) {
-					_entries[i].mark_as_free();
-					return;
-				}
+			int i = _fd_buckets[_bucket(sd)];
+			for (; i != INVALID && _entries[i].fd != sd; i = _entries[i].next_by_fd);
+
+			if (i == INVALID)
+				return;
+
+			Entry &entry = _entries[i];
+
+			_unlink(&_fd_buckets[_bucket(entry.fd)], i,
+			        [] (Entry &e) -> int & { return e.next_by_fd; });
+			_unlink(&_id_buckets[_bucket(entry.global_id)], i,
+			        [] (Entry &e) -> int & { return e.next_by_id; });
+
+			entry = Entry();
+			entry.next_by_fd = _free_list;
+			_free_list = i;
 		}
 
 		/**
@@ -137,13 +167,24 @@ class Genode::Socket_descriptor_registry
 
 			int const existing_sd = _lookup_fd_by_global_id(global_id);
 
-			if (existing_sd < 0) {
-				Entry &entry = _find_free_entry();
-				entry = Entry(sd, global_id);
-				return sd;
-			} else {
+			if (existing_sd >= 0)
 				return existing_sd;
-			}
+
+			if (_free_list == INVALID)
+				throw Limit_reached();
+
+			int const i = _free_list;
+			Entry &entry = _entries[i];
+			_free_list = entry.next_by_fd;
+
+			entry.fd         = sd;
+			entry.global_id  = global_id;
+			entry.next_by_fd = _fd_buckets[_bucket(sd)];
+			entry.next_by_id = _id_buckets[_bucket(global_id)];
+
+			_fd_buckets[_bucket(sd)]        = i;
+			_id_buckets[_bucket(global_id)] = i;
+			return sd;
 		}
 };
 
@@ -104,11 +104,16 @@ namespace Genode {
 			void          pager(Pager_object *) { }
 			int           start(void *ip, void *sp) { return 0; }
 
-			Thread_state state()
-			{
-				PDBG("Not implemented");
-				throw Cpu_session::State_access_failed();
-			}
+			/**
+			 * Return stack and instruction pointer of the blocked thread
+			 *
+			 * The state is obtained from the 'syscall' file of the thread
+			 * in the proc file system. It is available only while the
+			 * thread is blocked in the kernel.
+			 *
+			 * \throw Cpu_session::State_access_failed
+			 */
+			Thread_state state();
 
 			void state(Thread_state)
 			{
@@ -48,7 +48,8 @@ namespace Genode {
 			                     size_t             ram_quota,
 			                     Pager_entrypoint  *pager_ep,
 			                     addr_t             vm_start,
-			                     size_t             vm_size) { }
+			                     size_t             vm_size,
+			                     size_t             fault_around_size_log2) { }
 
 			void upgrade_ram_quota(size_t ram_quota) { }
 
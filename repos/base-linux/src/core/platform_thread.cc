@@ -15,6 +15,7 @@
 #include <util/token.h>
 #include <util/misc_math.h>
 #include <base/printf.h>
+#include <base/snprintf.h>
 
 /* local includes */
 #include "platform_thread.h"
@@ -116,6 +117,50 @@ void Platform_thread::resume()
 }
 
 
+Thread_state Platform_thread::state()
+{
+	if (_pid == ~0UL || _tid == ~0UL)
+		throw Cpu_session::State_access_failed();
+
+	char path[64];
+	snprintf(path, sizeof(path), "/proc/%ld/task/%ld/syscall", _pid, _tid);
+
+	int const fd = lx_open(path, O_RDONLY | LX_O_CLOEXEC);
+	if (fd < 0)
+		throw Cpu_session::State_access_failed();
+
+	char buf[256];
+	int const n = lx_read(fd, buf, sizeof(buf) - 1);
+	lx_close(fd);
+
+	if (n <= 0)
+		throw Cpu_session::State_access_failed();
+
+	buf[n] = 0;
+
+	/*
+	 * The file contains the syscall number and arguments followed by the
+	 * stack and instruction pointer, or "running" if the thread executes.
+	 */
+	char const *fields[10];
+	unsigned    num_fields = 0;
+	for (char *p = buf; *p && num_fields < 10; ) {
+		while (*p == ' ' || *p == '\n') *p++ = 0;
+		if (!*p) break;
+		fields[num_fields++] = p;
+		while (*p && *p != ' ' && *p != '\n') p++;
+	}
+
+	if (num_fields < 3)
+		throw Cpu_session::State_access_failed();
+
+	Thread_state s;
+	ascii_to_unsigned(fields[num_fields - 2], s.sp, 0);
+	ascii_to_unsigned(fields[num_fields - 1], s.ip, 0);
+	return s;
+}
+
+
 int Platform_thread::client_sd()
 {
 	/* construct socket pair on first call */
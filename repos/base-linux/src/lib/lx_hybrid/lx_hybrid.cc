@@ -126,6 +126,46 @@ static pthread_key_t tls_key()
 }
 
 
+/**
+ * Release resources of an adopted thread when the thread exits
+ *
+ * The 'Thread_base' object of an adopted thread is never destructed.
+ * Hence, the reply channel of the thread, which is created on the
+ * thread's first IPC call, must be closed here.
+ */
+static void release_adopted_thread(void *arg)
+{
+	Native_thread &native_thread = ((Thread_base *)arg)->tid();
+
+	for (unsigned i = 0; i < 2; i++) {
+		if (native_thread.reply_sd[i] != -1) {
+			lx_close(native_thread.reply_sd[i]);
+			native_thread.reply_sd[i] = -1;
+		}
+	}
+}
+
+
+/**
+ * Return TLS key referring to the 'Thread_base' of an adopted thread
+ */
+static pthread_key_t adopted_tls_key()
+{
+	struct Tls_key
+	{
+		pthread_key_t key;
+
+		Tls_key()
+		{
+			pthread_key_create(&key, release_adopted_thread);
+		}
+	};
+
+	static Tls_key inst;
+	return inst.key;
+}
+
+
 namespace Genode {
 
 	struct Thread_meta_data
@@ -382,6 +422,9 @@ Thread_base *Thread_base::myself()
 	meta_data->thread_base->tid() = Native_thread();
 	adopt_thread(meta_data);
 
+	/* close the reply channel of the thread once it exits */
+	pthread_setspecific(adopted_tls_key(), thread);
+
 	return thread;
 }
 
@@ -456,6 +499,13 @@ Thread_base::~Thread_base()
 
 	_tid.meta_data = 0;
 
+	/* release reply channel used for RPC calls */
+	for (unsigned i = 0; i < 2; i++)
+		if (_tid.reply_sd[i] != -1) {
+			lx_close(_tid.reply_sd[i]);
+			_tid.reply_sd[i] = -1;
+		}
+
 	/* inform core about the killed thread */
 	cpu_session(_cpu_session)->kill_thread(_thread_cap);
 }
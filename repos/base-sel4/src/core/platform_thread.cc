@@ -177,7 +177,7 @@ void Platform_thread::state(Thread_state s)
 
 Thread_state Platform_thread::state()
 {
-	PDBG("not implemented");
+	/* not implemented, queried periodically via the TRACE session */
 	throw Cpu_session::State_access_failed();
 }
 
@@ -32,51 +32,41 @@ class Genode::Slab_block
 {
 	public:
 
-		Slab_block *next;  /* next block     */
-		Slab_block *prev;  /* previous block */
+		Slab_block *next;  /* next block in list of slab allocator     */
+		Slab_block *prev;  /* previous block in list of slab allocator */
 
 	private:
 
-		enum { FREE, USED };
+		friend class Slab;
 
-		Slab    *_slab;    /* back reference to slab allocator */
-		unsigned _avail;   /* free entries of this block       */
+		enum { NO_FREE_ENTRY = ~0U };
+
+		Slab    *_slab;        /* back reference to slab allocator */
+		unsigned _avail;       /* free entries of this block       */
+		unsigned _first_free;  /* index of first free entry        */
 
 		/*
-		 * Each slab block consists of three areas, a fixed-size header
-		 * that contains the member variables declared above, a byte array
-		 * called state table that holds the allocation state for each slab
-		 * entry, and an area holding the actual slab entries. The number
-		 * of state-table elements corresponds to the maximum number of slab
-		 * entries per slab block (the '_num_elem' member variable of the
-		 * Slab allocator).
+		 * Each slab block consists of a fixed-size header that contains the
+		 * member variables declared above, followed by the slab entries.
+		 * The free entries of the block form a singly linked list starting
+		 * at '_first_free'.
 		 */
 
-		char _data[];  /* dynamic data (state table and slab entries) */
+		char _data[];  /* dynamic data (slab entries) */
 
 		/*
 		 * Caution! no member variables allowed below this line!
 		 */
 
-		/**
-		 * Return the allocation state of a slab entry
-		 */
-		inline bool state(int idx) { return _data[idx]; }
-
-		/**
-		 * Set the allocation state of a slab entry
-		 */
-		inline void state(int idx, bool state) { _data[idx] = state; }
-
 		/**
 		 * Request address of slab entry by its index
 		 */
-		Slab_entry *slab_entry(int idx);
+		Slab_entry *slab_entry(unsigned idx);
 
 		/**
 		 * Determine block index of specified slab entry
 		 */
-		int slab_entry_idx(Slab_entry *e);
+		unsigned slab_entry_idx(Slab_entry *e);
 
 	public:
 
@@ -104,21 +94,14 @@ class Genode::Slab_block
 		void *alloc();
 
 		/**
-		 * Return a used slab block entry
+		 * Return slab entry to block
 		 */
-		Slab_entry *first_used_entry();
+		void free(Slab_entry *e);
 
 		/**
-		 * These functions are called by Slab_entry.
-		 */
-		void inc_avail(Slab_entry *e);
-		void dec_avail();
-
-		/**
-		 * Debug and test hooks
+		 * Return a used slab block entry
 		 */
-		void dump();
-		int check_bounds();
+		Slab_entry *first_used_entry();
 };
 
 
@@ -126,8 +109,17 @@ class Genode::Slab_entry
 {
 	private:
 
-		Slab_block *_sb;
-		char        _data[];
+		/*
+		 * While the entry is in use, '_sb' refers to the slab block that
+		 * contains the entry. While the entry is free, the same word holds
+		 * the index of the next free entry of the block.
+		 */
+		union {
+			Slab_block   *_sb;
+			unsigned long _next_free;
+		};
+
+		char _data[];
 
 		/*
 		 * Caution! no member variables allowed below this line!
@@ -135,19 +127,18 @@ class Genode::Slab_entry
 
 	public:
 
-		void init() { _sb = 0; }
+		void occupy(Slab_block *sb) { _sb = sb; }
 
-		void occupy(Slab_block *sb)
-		{
-			_sb = sb;
-			_sb->dec_avail();
-		}
+		void release(unsigned long next_free) { _next_free = next_free; }
 
-		void free()
-		{
-			_sb->inc_avail(this);
-			_sb = 0;
-		}
+		unsigned long next_free() const { return _next_free; }
+
+		/**
+		 * Return true if the entry is in use within block 'sb'
+		 */
+		bool used_in(Slab_block const *sb) const { return _sb == sb; }
+
+		Slab_block *block() const { return _sb; }
 
 		void *addr() { return _data; }
 
@@ -163,17 +154,51 @@ class Genode::Slab_entry
 
 /**
  * Slab allocator
+ *
+ * The slab blocks are kept in three lists, holding the blocks with free
+ * and used entries (partial), blocks without free entries (full), and
+ * completely unused blocks (empty). Entries are always allocated from a
+ * partially used block if possible, which keeps the number of partially
+ * used blocks low. If enabled at construction time, empty blocks are
+ * returned to the backing store with a hysteresis of one cached empty
+ * block.
  */
 class Genode::Slab : public Allocator
 {
 	private:
 
+		/**
+		 * Doubly linked list of slab blocks
+		 */
+		struct Block_list
+		{
+			Slab_block *first = nullptr;
+			unsigned    count = 0;
+
+			void insert(Slab_block *sb);
+			void remove(Slab_block *sb);
+		};
+
+		enum {
+			/*
+			 * Number of free entries that must be available at any time,
+			 * see 'alloc'
+			 */
+			RESERVED_ENTRIES = 3,
+
+			/* number of empty blocks kept before releasing blocks */
+			MAX_EMPTY_BLOCKS = 1,
+		};
+
 		size_t      _slab_size;     /* size of one slab entry               */
 		size_t      _block_size;    /* size of slab block                   */
 		size_t      _num_elem;      /* number of slab entries per block     */
-		Slab_block *_first_sb;      /* first slab block                     */
+		size_t      _total_avail;   /* free entries of all blocks           */
 		Slab_block *_initial_sb;    /* initial (static) slab block          */
 		bool        _alloc_state;   /* indicator for 'currently in service' */
+		bool const  _release;       /* release empty blocks to backing store */
+
+		Block_list _partial, _full, _empty;
 
 		Allocator *_backing_store;
 
@@ -182,6 +207,26 @@ class Genode::Slab : public Allocator
 		 */
 		Slab_block *_new_slab_block();
 
+		/**
+		 * Return list a block with 'avail' free entries belongs to
+		 */
+		Block_list &_list(unsigned avail);
+
+		/**
+		 * Move block to the list matching its new number of free entries
+		 */
+		void _requeue(Slab_block *sb, unsigned old_avail);
+
+		/**
+		 * Release empty blocks exceeding 'MAX_EMPTY_BLOCKS'
+		 */
+		void _release_empty_blocks();
+
+		/**
+		 * Return entry 'e' of block 'sb'
+		 */
+		void _free(Slab_block *sb, Slab_entry *e);
+
 	public:
 
 		inline size_t slab_size()  const { return _slab_size;  }
@@ -196,9 +241,17 @@ class Genode::Slab : public Allocator
 		 * block that is used for the first couple of allocations,
 		 * especially for the allocation of the second slab
 		 * block.
+		 *
+		 * \param release_empty_blocks  return empty blocks to the backing
+		 *                              store
+		 *
+		 * Releasing blocks must stay disabled if the backing store does
+		 * not reclaim freed memory or if it may call back into this slab
+		 * allocator while freeing a block, e.g., if the slab holds the
+		 * meta data of the backing store itself.
 		 */
 		Slab(size_t slab_size, size_t block_size, Slab_block *initial_sb,
-		     Allocator *backing_store = 0);
+		     Allocator *backing_store = 0, bool release_empty_blocks = false);
 
 		/**
 		 * Destructor
@@ -206,25 +259,15 @@ class Genode::Slab : public Allocator
 		~Slab();
 
 		/**
-		 * Debug function for dumping the current slab block list
+		 * Insert unused block into slab allocator
 		 *
-		 * \noapi
-		 */
-		void dump_sb_list();
-
-		/**
-		 * Remove block from slab block list
-		 *
-		 * \noapi
-		 */
-		void remove_sb(Slab_block *sb);
-
-		/**
-		 * Insert block into slab block list
+		 * This function is meant for slab allocators without backing store,
+		 * which obtain their blocks from elsewhere. The block must be
+		 * configured for this slab allocator.
 		 *
 		 * \noapi
 		 */
-		void insert_sb(Slab_block *sb, Slab_block *at = 0);
+		void insert_sb(Slab_block *sb);
 
 		/**
 		 * Free slab entry
@@ -239,7 +282,8 @@ class Genode::Slab : public Allocator
 		/**
 		 * Return true if number of free slab entries is higher than n
 		 */
-		bool num_free_entries_higher_than(int n);
+		bool num_free_entries_higher_than(int n) const {
+			return _total_avail > (size_t)n; }
 
 		/**
 		 * Define/request backing-store allocator
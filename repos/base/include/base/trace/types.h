@@ -32,6 +32,8 @@ namespace Genode { namespace Trace {
 	struct Policy_id;
 	struct Subject_id;
 	struct Execution_time;
+	struct Page_faults;
+	struct Instruction_pointer;
 	struct Subject_info;
 } }
 
@@ -78,6 +80,36 @@ struct Genode::Trace::Execution_time
 };
 
 
+/**
+ * Page faults resolved by core for the address space of a trace subject
+ */
+struct Genode::Trace::Page_faults
+{
+	unsigned long faults;  /* number of resolved page faults */
+	unsigned long pages;   /* number of pages mapped for resolving them */
+
+	Page_faults() : faults(0), pages(0) { }
+	Page_faults(unsigned long faults, unsigned long pages)
+	: faults(faults), pages(pages) { }
+};
+
+
+/**
+ * Instruction pointer of trace subject sampled at the time of the query
+ *
+ * A value of 0 denotes that the kernel does not provide the thread state.
+ */
+struct Genode::Trace::Instruction_pointer
+{
+	addr_t value;
+
+	Instruction_pointer() : value(0) { }
+	Instruction_pointer(addr_t value) : value(value) { }
+
+	bool valid() const { return value != 0; }
+};
+
+
 /**
  * Subject information
  */
@@ -108,6 +140,8 @@ class Genode::Trace::Subject_info
 		Policy_id          _policy_id;
 		Execution_time     _execution_time;
 		Affinity::Location _affinity;
+		Page_faults         _page_faults;
+		Instruction_pointer _instruction_pointer;
 
 	public:
 
@@ -117,11 +151,15 @@ class Genode::Trace::Subject_info
 		             Thread_name   const &thread_name,
 		             State state, Policy_id policy_id,
 		             Execution_time execution_time,
-		             Affinity::Location affinity)
+		             Affinity::Location affinity,
+		             Page_faults page_faults = Page_faults(),
+		             Instruction_pointer instruction_pointer = Instruction_pointer())
 		:
 			_session_label(session_label), _thread_name(thread_name),
 			_state(state), _policy_id(policy_id),
-			_execution_time(execution_time), _affinity(affinity)
+			_execution_time(execution_time), _affinity(affinity),
+			_page_faults(page_faults),
+			_instruction_pointer(instruction_pointer)
 		{ }
 
 		Session_label const &session_label()  const { return _session_label; }
@@ -130,6 +168,10 @@ class Genode::Trace::Subject_info
 		Policy_id            policy_id()      const { return _policy_id; }
 		Execution_time       execution_time() const { return _execution_time; }
 		Affinity::Location   affinity()       const { return _affinity; }
+		Page_faults          page_faults()    const { return _page_faults; }
+
+		Instruction_pointer instruction_pointer() const {
+			return _instruction_pointer; }
 };
 
 #endif /* _INCLUDE__BASE__TRACE__TYPES_H_ */
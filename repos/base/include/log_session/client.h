@@ -27,6 +27,13 @@ struct Genode::Log_session_client : Rpc_client<Log_session>
 
 	size_t write(String const &string) override {
 		return call<Rpc_write>(string); }
+
+	Dataspace_capability ring() override { return call<Rpc_ring>(); }
+
+	Signal_context_capability ring_sigh() override {
+		return call<Rpc_ring_sigh>(); }
+
+	void drain() override { call<Rpc_drain>(); }
 };
 
 #endif /* _INCLUDE__LOG_SESSION__CLIENT_H_ */
@@ -24,7 +24,7 @@ struct Genode::Log_connection : Connection<Log_session>, Log_session_client
 {
 	Log_connection()
 	:
-		Connection<Log_session>(session("ram_quota=8K")),
+		Connection<Log_session>(session("ram_quota=16K")),
 		Log_session_client(cap())
 	{ }
 };
@@ -0,0 +1,226 @@
+/*
+ * \brief  Ring of log messages shared between LOG client and server
+ * \author agent
+ * \date   2015-12-09
+ *
+ * The ring allows a LOG client to pass messages to the server without
+ * blocking on an RPC per message. The client is the only producer, the
+ * server is the only consumer that drains all pending messages at once.
+ * The server announces that it waits for new messages by setting a flag in
+ * the ring. Only then, the client has to wake up the server via a signal.
+ *
+ * As the ring resides in memory shared by both parties, the consumer
+ * sanitizes each value read from the ring.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__LOG_SESSION__LOG_RING_H_
+#define _INCLUDE__LOG_SESSION__LOG_RING_H_
+
+#include <base/stdint.h>
+#include <util/string.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
+
+namespace Genode { class Log_ring; }
+
+
+class Genode::Log_ring
+{
+	public:
+
+		enum Severity { LOG, INFO, WARNING, ERROR };
+
+		typedef uint64_t Timestamp;
+
+		/**
+		 * Size of the dataspace that holds the ring
+		 */
+		enum { DS_SIZE = 8*1024 };
+
+		/**
+		 * Maximum length of one message
+		 */
+		enum { MAX_LEN = 256 };
+
+		struct Message
+		{
+			Timestamp   timestamp;
+			Severity    severity;
+			char const *text;
+			size_t      len;
+		};
+
+	private:
+
+		/*
+		 * Each message is stored as header followed by the text. Messages
+		 * never wrap around the end of the buffer. Instead, the remainder of
+		 * the buffer is skipped via a padding header.
+		 */
+		struct Header
+		{
+			Timestamp timestamp;
+			uint32_t  severity;
+			uint32_t  len;
+		};
+
+		enum { PADDING = ~0U, ALIGN = sizeof(Header) };
+
+		/*
+		 * Byte positions counting up to twice the capacity, which allows for
+		 * distinguishing a full from an empty ring
+		 */
+		uint32_t volatile _head = 0;
+		uint32_t volatile _tail = 0;
+
+		/* set by the consumer if it waits for a signal of the producer */
+		int volatile _consumer_waiting = 0;
+
+		char _buf[DS_SIZE - 4*sizeof(uint32_t)] __attribute__((aligned(8)));
+
+		enum { CAPACITY = sizeof(_buf) - sizeof(_buf) % ALIGN };
+
+		static size_t _record_size(size_t len) {
+			return sizeof(Header) + ((len + ALIGN - 1) & ~(ALIGN - 1)); }
+
+		Header *_header(uint32_t pos) {
+			return (Header *)(_buf + pos % CAPACITY); }
+
+		static uint32_t _used(uint32_t head, uint32_t tail) {
+			return (head + 2*CAPACITY - tail) % (2*CAPACITY); }
+
+		static uint32_t _advanced(uint32_t pos, size_t n) {
+			return (pos + n) % (2*CAPACITY); }
+
+	public:
+
+		/**
+		 * Append message, called by the producer only
+		 *
+		 * \return  false if the ring lacks space for the message
+		 */
+		bool add(Severity severity, Timestamp timestamp,
+		         char const *text, size_t len)
+		{
+			len = min(len, (size_t)MAX_LEN);
+
+			uint32_t const head = _head;
+			uint32_t const used = _used(head, _tail);
+
+			/* skip the end of the buffer if the message does not fit */
+			size_t const to_end  = CAPACITY - head % CAPACITY;
+			size_t const size    = _record_size(len);
+			size_t const padding = to_end < size ? to_end : 0;
+
+			if (head >= 2*CAPACITY || used + padding + size > CAPACITY)
+				return false;
+
+			if (padding)
+				_header(head)->len = PADDING;
+
+			Header &h = *_header(_advanced(head, padding));
+			h.timestamp = timestamp;
+			h.severity  = severity;
+			h.len       = len;
+			memcpy(&h + 1, text, len);
+
+			/* make the message visible before publishing the new head */
+			memory_barrier();
+			_head = _advanced(head, padding + size);
+			return true;
+		}
+
+		/**
+		 * Return true if the consumer must be woken up, called by the producer
+		 *
+		 * The call is expected after adding a message. It clears the flag
+		 * set by the consumer so that the consumer gets woken up only once.
+		 */
+		bool wakeup_consumer()
+		{
+			/*
+			 * The atomic operation orders the read of the flag after the
+			 * publication of the head, which pairs with the consumer setting
+			 * the flag before looking at the head.
+			 */
+			memory_barrier();
+			return cmpxchg(&_consumer_waiting, 1, 0);
+		}
+
+		/**
+		 * Request a wakeup for the next message, called by the consumer
+		 *
+		 * \return  true if the ring is empty, otherwise, the consumer must
+		 *          drain the ring again instead of waiting
+		 */
+		bool wait_for_producer()
+		{
+			cmpxchg(&_consumer_waiting, 0, 1);
+			return _head == _tail;
+		}
+
+		/**
+		 * Consume all pending messages, called by the consumer only
+		 *
+		 * \param fn  functor called with each 'Message const &'
+		 * \return    number of messages passed to 'fn'
+		 */
+		template <typename FN>
+		unsigned for_each(FN const &fn)
+		{
+			uint32_t const head = _head;
+			uint32_t       tail = _tail;
+
+			/* discard the content if the producer corrupted the counters */
+			if (head >= 2*CAPACITY || tail >= 2*CAPACITY
+			 || _used(head, tail) > CAPACITY) {
+				_tail = head % (2*CAPACITY);
+				return 0;
+			}
+
+			/* read the messages not before observing the head */
+			memory_barrier();
+
+			unsigned cnt = 0;
+			while (tail != head) {
+
+				Header const h      = *_header(tail);
+				size_t const to_end = CAPACITY - tail % CAPACITY;
+				size_t const used   = _used(head, tail);
+
+				if (h.len == PADDING && to_end <= used) {
+					tail = _advanced(tail, to_end);
+					continue;
+				}
+
+				if (h.len > MAX_LEN)
+					break;
+
+				size_t const size = _record_size(h.len);
+				if (size > to_end || size > used)
+					break;
+
+				Severity const severity = h.severity <= ERROR
+				                        ? (Severity)h.severity : LOG;
+
+				fn(Message { h.timestamp, severity,
+				             (char const *)(_header(tail) + 1), h.len });
+				cnt++;
+				tail = _advanced(tail, size);
+			}
+
+			/* release the space only after the messages have been read */
+			memory_barrier();
+			_tail = head;
+			return cnt;
+		}
+};
+
+#endif /* _INCLUDE__LOG_SESSION__LOG_RING_H_ */
@@ -17,6 +17,8 @@
 #include <base/capability.h>
 #include <base/stdint.h>
 #include <base/rpc_args.h>
+#include <base/signal.h>
+#include <dataspace/capability.h>
 #include <session/session.h>
 
 namespace Genode { struct Log_session; }
@@ -37,13 +39,41 @@ struct Genode::Log_session : Session
 	 */
 	virtual size_t write(String const &string) = 0;
 
+	/**
+	 * Request dataspace containing the 'Log_ring' of the session
+	 *
+	 * The ring allows the client to pass messages without blocking. It is
+	 * optional. A server that does not provide a ring returns an invalid
+	 * capability, which makes the client use 'write' only.
+	 */
+	virtual Dataspace_capability ring() { return Dataspace_capability(); }
+
+	/**
+	 * Request signal context for waking up the server
+	 *
+	 * The client submits a signal after adding a message to the ring if the
+	 * server waits for new messages.
+	 */
+	virtual Signal_context_capability ring_sigh() {
+		return Signal_context_capability(); }
+
+	/**
+	 * Consume all messages pending in the ring
+	 *
+	 * Called by the client if the ring is full.
+	 */
+	virtual void drain() { }
+
 
 	/*********************
 	 ** RPC declaration **
 	 *********************/
 
 	GENODE_RPC(Rpc_write, size_t, write, String const &);
-	GENODE_RPC_INTERFACE(Rpc_write);
+	GENODE_RPC(Rpc_ring, Dataspace_capability, ring);
+	GENODE_RPC(Rpc_ring_sigh, Signal_context_capability, ring_sigh);
+	GENODE_RPC(Rpc_drain, void, drain);
+	GENODE_RPC_INTERFACE(Rpc_write, Rpc_ring, Rpc_ring_sigh, Rpc_drain);
 };
 
 #endif /* _INCLUDE__LOG_SESSION__LOG_SESSION_H_ */
@@ -27,13 +27,17 @@ struct Genode::Rm_connection : Connection<Rm_session>, Rm_session_client
 	/**
 	 * Constructor
 	 *
-	 * \param start start of the managed VM-region
-	 * \param size  size of the VM-region to manage
+	 * \param start         start of the managed VM-region
+	 * \param size          size of the VM-region to manage
+	 * \param fault_around  log2 of the maximum size of the mappings used
+	 *                      to resolve page faults, 0 selects the
+	 *                      platform's default
 	 */
-	Rm_connection(addr_t start = ~0UL, size_t size = 0) :
+	Rm_connection(addr_t start = ~0UL, size_t size = 0,
+	              size_t fault_around = 0) :
 		Connection<Rm_session>(
-			session("ram_quota=%u, start=0x%p, size=0x%zx",
-			        RAM_QUOTA, start, size)),
+			session("ram_quota=%u, start=0x%p, size=0x%zx, fault_around=%zu",
+			        RAM_QUOTA, start, size, fault_around)),
 		Rm_session_client(cap()) { }
 };
 
@@ -56,6 +56,23 @@ struct Genode::Signal_source
 			int num() { return _num; }
 	};
 
+	/**
+	 * Signals delivered by one 'wait_for_signals' call
+	 */
+	struct Signal_batch
+	{
+		enum { MAX_SIGNALS = 16 };
+
+		Signal   signals[MAX_SIGNALS];
+		unsigned count;
+
+		Signal_batch() : count(0) { }
+
+		bool full() const { return count == MAX_SIGNALS; }
+
+		void add(Signal const &signal) { if (!full()) signals[count++] = signal; }
+	};
+
 	virtual ~Signal_source() { }
 
 	/**
@@ -63,13 +80,30 @@ struct Genode::Signal_source
 	 */
 	virtual Signal wait_for_signal() = 0;
 
+	/**
+	 * Wait for signals
+	 *
+	 * In contrast to 'wait_for_signal', the function returns all pending
+	 * signals up to 'Signal_batch::MAX_SIGNALS' at once, which saves a
+	 * round trip per signal when many signal contexts are pending. The
+	 * default implementation delivers a single signal and is used on
+	 * platforms with a custom signal-source protocol.
+	 */
+	virtual Signal_batch wait_for_signals()
+	{
+		Signal_batch batch;
+		batch.add(wait_for_signal());
+		return batch;
+	}
+
 
 	/*********************
 	 ** RPC declaration **
 	 *********************/
 
 	GENODE_RPC(Rpc_wait_for_signal, Signal, wait_for_signal);
-	GENODE_RPC_INTERFACE(Rpc_wait_for_signal);
+	GENODE_RPC(Rpc_wait_for_signals, Signal_batch, wait_for_signals);
+	GENODE_RPC_INTERFACE(Rpc_wait_for_signal, Rpc_wait_for_signals);
 };
 
 #endif /* _INCLUDE__SIGNAL_SESSION__SOURCE_H_ */
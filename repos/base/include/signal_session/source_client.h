@@ -28,6 +28,9 @@ struct Genode::Signal_source_client : Rpc_client<Signal_source>
 	: Rpc_client<Signal_source>(signal_source) { }
 
 	Signal wait_for_signal() override { return call<Rpc_wait_for_signal>(); }
+
+	Signal_batch wait_for_signals() override {
+		return call<Rpc_wait_for_signals>(); }
 };
 
 #endif /* _INCLUDE__SIGNAL_SESSION__SOURCE_CLIENT_H_ */
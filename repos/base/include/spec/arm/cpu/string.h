@@ -1,5 +1,5 @@
 /*
- * \brief  ARM-specific memcpy
+ * \brief  ARM-specific memcpy and memset
  * \author Sebastian Sumpf
  * \author Stefan Kalkowski
  * \date   2012-08-02
@@ -51,6 +51,45 @@ namespace Genode {
 		}
 		return size;
 	}
+
+
+	/**
+	 * Fill memory block with byte value
+	 *
+	 * \param dst   word-aligned destination memory block
+	 * \param i     byte value
+	 * \param size  number of bytes to fill
+	 *
+	 * \return      Number of bytes not filled
+	 */
+	inline size_t memset_cpu(void *dst, int i, size_t size)
+	{
+		unsigned char *d = (unsigned char *)dst;
+		unsigned long  v = (unsigned char)i*0x01010101UL;
+		size_t         n = size / 32;
+
+		if (!n)
+			return size;
+
+		/* fill 32 byte chunks */
+		asm volatile ("mov r3,  %2 \n\t"
+		              "mov r4,  %2 \n\t"
+		              "mov r5,  %2 \n\t"
+		              "mov r6,  %2 \n\t"
+		              "mov r7,  %2 \n\t"
+		              "mov r8,  %2 \n\t"
+		              "mov r9,  %2 \n\t"
+		              "mov r10, %2 \n\t"
+		              "1: \n\t"
+		              "stmia %0!, {r3 - r10} \n\t"
+		              "subs  %1, %1, #1 \n\t"
+		              "bne   1b \n\t"
+		              : "+r" (d), "+r" (n)
+		              : "r" (v)
+		              : "r3","r4","r5","r6","r7","r8","r9","r10","cc","memory");
+
+		return size % 32;
+	}
 }
 
 #endif /* _INCLUDE__SPEC__ARM__CPU__STRING_H_ */
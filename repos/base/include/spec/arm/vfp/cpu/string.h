@@ -1,5 +1,5 @@
 /*
- * \brief  ARM-specific memcpy using VFP
+ * \brief  ARM-specific memcpy and memset using VFP
  * \author Sebastian Sumpf
  * \date   2013-06-19
  *
@@ -64,6 +64,46 @@ namespace Genode {
 			              :: "r3");
 		return size;
 	}
+
+
+	/**
+	 * Fill memory block with byte value
+	 *
+	 * \param dst   word-aligned destination memory block
+	 * \param i     byte value
+	 * \param size  number of bytes to fill
+	 *
+	 * \return      Number of bytes not filled
+	 */
+	inline size_t memset_cpu(void *dst, int i, size_t size)
+	{
+		unsigned char *d = (unsigned char *)dst;
+		unsigned long  v = (unsigned char)i*0x01010101UL;
+		size_t         n = size / 64;
+
+		if (!n)
+			return size;
+
+		/* fill 64 byte chunks using FPU */
+		asm volatile ("vmov d0, %2, %2 \n\t"
+		              "vmov d1, %2, %2 \n\t"
+		              "vmov d2, %2, %2 \n\t"
+		              "vmov d3, %2, %2 \n\t"
+		              "vmov d4, %2, %2 \n\t"
+		              "vmov d5, %2, %2 \n\t"
+		              "vmov d6, %2, %2 \n\t"
+		              "vmov d7, %2, %2 \n\t"
+		              "1: \n\t"
+		              "vstm %0!, {d0-d7} \n\t"
+		              "subs %1, %1, #1   \n\t"
+		              "bne  1b           \n\t"
+		              : "+r" (d), "+r" (n)
+		              : "r" (v)
+		              : "d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7",
+		                "cc", "memory");
+
+		return size % 64;
+	}
 }
 
 #endif /* _INCLUDE__SPEC__ARM__VFP__CPU__STRING_H_ */
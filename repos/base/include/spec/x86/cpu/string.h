@@ -1,5 +1,5 @@
 /*
- * \brief  CPU-specific memcpy
+ * \brief  CPU-specific memcpy and memset
  * \author Sebastian Sumpf
  * \date   2012-08-02
  */
@@ -24,8 +24,86 @@ namespace Genode {
 	 * \param size  number of bytes to copy
 	 *
 	 * \return      number of bytes not copied
+	 *
+	 * Large blocks are copied with 'rep movs', which processes whole cache
+	 * lines on CPUs with fast-string support. On x86_64, blocks larger than
+	 * the typical last-level cache are copied with non-temporal stores to
+	 * avoid evicting the working set. Neither variant touches the FPU or
+	 * SIMD registers, so the function is safe to use with lazy FPU
+	 * switching.
 	 */
-	inline size_t memcpy_cpu(void *, const void *, size_t size) { return size; }
+	inline size_t memcpy_cpu(void *dst, const void *src, size_t size)
+	{
+		enum { MIN_SIZE = 256, NON_TEMPORAL_SIZE = 4*1024*1024 };
+
+		if (size < MIN_SIZE)
+			return size;
+
+		char *d = (char *)dst, *s = (char *)src;
+
+		/* align destination to a word boundary */
+		for (; (unsigned long)d & (sizeof(long) - 1); size--, *d++ = *s++);
+
+#ifdef __x86_64__
+		if (size >= NON_TEMPORAL_SIZE) {
+			for (; size >= 32; size -= 32, d += 32, s += 32) {
+				unsigned long a, b, c, e;
+				asm volatile ("movq    (%4), %0 \n\t"
+				              "movq   8(%4), %1 \n\t"
+				              "movq  16(%4), %2 \n\t"
+				              "movq  24(%4), %3 \n\t"
+				              "movnti %0,   (%5) \n\t"
+				              "movnti %1,  8(%5) \n\t"
+				              "movnti %2, 16(%5) \n\t"
+				              "movnti %3, 24(%5) \n\t"
+				              : "=&r" (a), "=&r" (b), "=&r" (c), "=&r" (e)
+				              : "r" (s), "r" (d)
+				              : "memory");
+			}
+			asm volatile ("sfence" ::: "memory");
+			return size;
+		}
+
+		size_t words = size / sizeof(long);
+		asm volatile ("rep movsq"
+		              : "+D" (d), "+S" (s), "+c" (words) :: "memory");
+#else
+		size_t words = size / sizeof(long);
+		asm volatile ("rep movsl"
+		              : "+D" (d), "+S" (s), "+c" (words) :: "memory");
+#endif
+		return size % sizeof(long);
+	}
+
+
+	/**
+	 * Fill memory block with byte value
+	 *
+	 * \param dst   word-aligned destination memory block
+	 * \param i     byte value
+	 * \param size  number of bytes to fill
+	 *
+	 * \return      number of bytes not filled
+	 */
+	inline size_t memset_cpu(void *dst, int i, size_t size)
+	{
+		enum { MIN_SIZE = 256 };
+
+		if (size < MIN_SIZE)
+			return size;
+
+		unsigned long const value = (unsigned char)i*(~0UL/0xff);
+		size_t words = size / sizeof(long);
+
+#ifdef __x86_64__
+		asm volatile ("rep stosq"
+		              : "+D" (dst), "+c" (words) : "a" (value) : "memory");
+#else
+		asm volatile ("rep stosl"
+		              : "+D" (dst), "+c" (words) : "a" (value) : "memory");
+#endif
+		return size % sizeof(long);
+	}
 }
 
 #endif /* _INCLUDE__SPEC__X86__CPU__STRING_H_ */
@@ -58,14 +58,51 @@ class Genode::Number_of_bytes
 
 namespace Genode {
 
+	/**
+	 * Return true if machine word 'w' contains a zero byte
+	 */
+	inline bool word_has_zero_byte(unsigned long w)
+	{
+		unsigned long const ones = ~0UL/0xff;
+		return (w - ones) & ~w & (ones << 7);
+	}
+
+
+	/**
+	 * Return true if 'p' is aligned to the size of a machine word
+	 */
+	inline bool word_aligned(void const *p)
+	{
+		return ((addr_t)p & (sizeof(long) - 1)) == 0;
+	}
+
+
+	/**
+	 * Return true if 'p0' and 'p1' have the same offset within a machine word
+	 */
+	inline bool word_coaligned(void const *p0, void const *p1)
+	{
+		return (((addr_t)p0 ^ (addr_t)p1) & (sizeof(long) - 1)) == 0;
+	}
+
+
 	/**
 	 * Return length of null-terminated string in bytes
 	 */
 	inline size_t strlen(const char *s)
 	{
-		size_t res = 0;
-		for (; s && *s; s++, res++);
-		return res;
+		if (!s) return 0;
+
+		char const *p = s;
+		for (; !word_aligned(p); p++)
+			if (!*p) return p - s;
+
+		/* an aligned word never crosses a page boundary */
+		unsigned long const *w = (unsigned long const *)p;
+		for (; !word_has_zero_byte(*w); w++);
+
+		for (p = (char const *)w; *p; p++);
+		return p - s;
 	}
 
 
@@ -81,6 +118,22 @@ namespace Genode {
 	 */
 	inline int strcmp(const char *s1, const char *s2, size_t len = ~0UL)
 	{
+		/* skip equal words of equally aligned strings */
+		if (word_coaligned(s1, s2)) {
+
+			for (; len && !word_aligned(s1); s1++, s2++, len--)
+				if (!*s1 || *s1 != *s2) return *s1 - *s2;
+
+			unsigned long const *w1 = (unsigned long const *)s1;
+			unsigned long const *w2 = (unsigned long const *)s2;
+
+			for (; len >= sizeof(long) && *w1 == *w2 && !word_has_zero_byte(*w1);
+			     w1++, w2++, len -= sizeof(long));
+
+			s1 = (char const *)w1;
+			s2 = (char const *)w2;
+		}
+
 		for (; *s1 && *s1 == *s2 && len; s1++, s2++, len--) ;
 		return len ? *s1 - *s2 : 0;
 	}
@@ -94,16 +147,35 @@ namespace Genode {
 	 * \param size  number of bytes to move
 	 *
 	 * \return      pointer to destination memory block
+	 *
+	 * Equally aligned buffers are moved word-wise.
 	 */
 	inline void *memmove(void *dst, const void *src, size_t size)
 	{
 		char *d = (char *)dst, *s = (char *)src;
-		size_t i;
 
-		if (s > d)
-			for (i = 0; i < size; i++, *d++ = *s++);
-		else
-			for (s += size - 1, d += size - 1, i = size; i-- > 0; *d-- = *s--);
+		bool const words = word_coaligned(d, s);
+
+		if (s > d) {
+			if (words) {
+				for (; size && !word_aligned(d); size--, *d++ = *s++);
+				for (; size >= sizeof(long); size -= sizeof(long),
+				     d += sizeof(long), s += sizeof(long))
+					*(long *)d = *(long *)s;
+			}
+			for (; size; size--, *d++ = *s++);
+
+		} else if (s < d) {
+			d += size; s += size;
+			if (words) {
+				for (; size && !word_aligned(d); size--, *--d = *--s);
+				for (; size >= sizeof(long); size -= sizeof(long)) {
+					d -= sizeof(long); s -= sizeof(long);
+					*(long *)d = *(long *)s;
+				}
+			}
+			for (; size; size--, *--d = *--s);
+		}
 
 		return dst;
 	}
@@ -133,6 +205,12 @@ namespace Genode {
 
 		d += i; s += i; size -= i;
 
+		/* copy words if both buffers are equally aligned */
+		if (word_coaligned(d, s)) {
+			memmove(d, s, size);
+			return dst;
+		}
+
 		/* copy eight byte chunks */
 		for (i = size >> 3; i > 0; i--, *d++ = *s++,
 		                                *d++ = *s++,
@@ -200,6 +278,16 @@ namespace Genode {
 		const unsigned char *c0 = (const unsigned char *)p0;
 		const unsigned char *c1 = (const unsigned char *)p1;
 
+		/* skip equal words of equally aligned blocks */
+		if (word_coaligned(c0, c1)) {
+
+			for (; size && !word_aligned(c0); size--, c0++, c1++)
+				if (*c0 != *c1) return *c0 - *c1;
+
+			for (; size >= sizeof(long) && *(long *)c0 == *(long *)c1;
+			     size -= sizeof(long), c0 += sizeof(long), c1 += sizeof(long));
+		}
+
 		size_t i;
 		for (i = 0; i < size; i++)
 			if (c0[i] != c1[i]) return c0[i] - c1[i];
@@ -217,7 +305,20 @@ namespace Genode {
 	 */
 	inline void *memset(void *dst, int i, size_t size)
 	{
-		while (size--) ((char *)dst)[size] = i;
+		char *d = (char *)dst;
+
+		for (; size && !word_aligned(d); size--, *d++ = i);
+
+		/* try cpu specific version first */
+		size_t const done = size - memset_cpu(d, i, size);
+		d += done; size -= done;
+
+		unsigned long const w = (unsigned char)i*(~0UL/0xff);
+		for (; size >= sizeof(long); size -= sizeof(long), d += sizeof(long))
+			*(unsigned long *)d = w;
+
+		for (; size; size--, *d++ = i);
+
 		return dst;
 	}
 
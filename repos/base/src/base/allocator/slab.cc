@@ -33,38 +33,40 @@ void Slab_block::slab(Slab *slab)
 	_avail = _slab->num_elem();
 	next   = prev = 0;
 
+	/* chain all entries to the free list */
+	_first_free = _avail ? 0 : (unsigned)NO_FREE_ENTRY;
 	for (unsigned i = 0; i < _avail; i++)
-		state(i, FREE);
+		slab_entry(i)->release(i + 1 < _avail ? i + 1 : (unsigned)NO_FREE_ENTRY);
 }
 
 
-Slab_entry *Slab_block::slab_entry(int idx)
-{
-	/*
-	 * The slab slots start after the state array that consists
-	 * of 'num_elem' bytes. We align the first slot to a four-aligned
-	 * address.
-	 */
-	return (Slab_entry *)&_data[align_addr(_slab->num_elem(), 2)
-	                            + _slab->entry_size()*idx];
-}
+Slab_entry *Slab_block::slab_entry(unsigned idx) {
+	return (Slab_entry *)&_data[_slab->entry_size()*idx]; }
 
 
-int Slab_block::slab_entry_idx(Slab_entry *e) {
+unsigned Slab_block::slab_entry_idx(Slab_entry *e) {
 	return ((addr_t)e - (addr_t)slab_entry(0))/_slab->entry_size(); }
 
 
 void *Slab_block::alloc()
 {
-	size_t num_elem = _slab->num_elem();
-	for (unsigned i = 0; i < num_elem; i++)
-		if (state(i) == FREE) {
-			state(i, USED);
-			Slab_entry *e = slab_entry(i);
-			e->occupy(this);
-			return e->addr();
-		}
-	return 0;
+	if (_first_free == NO_FREE_ENTRY)
+		return 0;
+
+	Slab_entry *e = slab_entry(_first_free);
+	_first_free = e->next_free();
+	_avail--;
+
+	e->occupy(this);
+	return e->addr();
+}
+
+
+void Slab_block::free(Slab_entry *e)
+{
+	e->release(_first_free);
+	_first_free = slab_entry_idx(e);
+	_avail++;
 }
 
 
@@ -72,52 +74,37 @@ Slab_entry *Slab_block::first_used_entry()
 {
 	size_t num_elem = _slab->num_elem();
 	for (unsigned i = 0; i < num_elem; i++)
-		if (state(i) == USED)
+		if (slab_entry(i)->used_in(this))
 			return slab_entry(i);
 	return 0;
 }
 
 
-void Slab_block::inc_avail(Slab_entry *e)
-{
-	/* mark slab entry as free */
-	int idx = slab_entry_idx(e);
-	state(idx, FREE);
-	_avail++;
-
-	/* search previous block with higher avail value than this' */
-	Slab_block *at = prev;
-
-	while (at && (at->avail() < _avail))
-		at = at->prev;
-
-	/*
-	 * If we already are the first block or our avail value is lower than the
-	 * previous block, do not reposition the block in the list.
-	 */
-	if (prev == 0 || at == prev)
-		return;
+/****************
+ ** Block list **
+ ****************/
 
-	/* reposition block in list after block with higher avail value */
-	_slab->remove_sb(this);
-	_slab->insert_sb(this, at);
+void Slab::Block_list::insert(Slab_block *sb)
+{
+	sb->prev = 0;
+	sb->next = first;
+	if (first)
+		first->prev = sb;
+	first = sb;
+	count++;
 }
 
 
-void Slab_block::dec_avail()
+void Slab::Block_list::remove(Slab_block *sb)
 {
-	_avail--;
-
-	/* search subsequent block with lower avail value than this' */
-	Slab_block *at = this;
-
-	while (at->next && at->next->avail() > _avail)
-		at = at->next;
+	if (sb->prev) sb->prev->next = sb->next;
+	if (sb->next) sb->next->prev = sb->prev;
 
-	if (at == this) return;
+	if (first == sb)
+		first = sb->next;
 
-	_slab->remove_sb(this);
-	_slab->insert_sb(this, at);
+	sb->prev = sb->next = 0;
+	count--;
 }
 
 
@@ -126,46 +113,47 @@ void Slab_block::dec_avail()
  **********/
 
 Slab::Slab(size_t slab_size, size_t block_size, Slab_block *initial_sb,
-                                                Allocator *backing_store)
+                                                Allocator *backing_store,
+                                                bool release_empty_blocks)
 : _slab_size(slab_size),
   _block_size(block_size),
-  _first_sb(initial_sb),
+  _total_avail(0),
   _initial_sb(initial_sb),
   _alloc_state(false),
+  _release(release_empty_blocks),
   _backing_store(backing_store)
 {
-	/*
-	 * Calculate number of entries per slab block.
-	 *
-	 * The 'sizeof(umword_t)' is for the alignment of the first slab entry.
-	 * The 1 is for one byte state entry.
-	 */
-	_num_elem = (_block_size - sizeof(Slab_block) - sizeof(umword_t))
-	          / (entry_size() + 1);
+	/* calculate number of entries per slab block */
+	_num_elem = (_block_size - sizeof(Slab_block)) / entry_size();
 
 	/* if no initial slab block was specified, try to get one */
-	if (!_first_sb && _backing_store)
-		_first_sb = _new_slab_block();
+	Slab_block *first_sb = _initial_sb;
+	if (!first_sb && _backing_store)
+		first_sb = _new_slab_block();
 
 	/* init first slab block */
-	if (_first_sb)
-		_first_sb->slab(this);
+	if (first_sb) {
+		first_sb->slab(this);
+		insert_sb(first_sb);
+	}
 }
 
 
 Slab::~Slab()
 {
 	/* free backing store */
-	while (_first_sb) {
-		Slab_block *sb = _first_sb;
-		remove_sb(_first_sb);
-
-		/*
-		 * Only free slab blocks that we allocated. This is not the case for
-		 * the '_initial_sb' that we got as constructor argument.
-		 */
-		if (_backing_store && (sb != _initial_sb))
-			_backing_store->free(sb, _block_size);
+	Block_list *lists[] = { &_partial, &_full, &_empty };
+	for (Block_list *list : lists) {
+		while (Slab_block *sb = list->first) {
+			list->remove(sb);
+
+			/*
+			 * Only free slab blocks that we allocated. This is not the case
+			 * for the '_initial_sb' that we got as constructor argument.
+			 */
+			if (_backing_store && (sb != _initial_sb))
+				_backing_store->free(sb, _block_size);
+		}
 	}
 }
 
@@ -181,56 +169,66 @@ Slab_block *Slab::_new_slab_block()
 }
 
 
-void Slab::remove_sb(Slab_block *sb)
+Slab::Block_list &Slab::_list(unsigned avail)
 {
-	Slab_block *prev = sb->prev;
-	Slab_block *next = sb->next;
+	if (avail == 0)         return _full;
+	if (avail == _num_elem) return _empty;
+	return _partial;
+}
 
-	if (prev) prev->next = next;
-	if (next) next->prev = prev;
 
-	if (_first_sb == sb)
-		_first_sb =  next;
+void Slab::_requeue(Slab_block *sb, unsigned old_avail)
+{
+	Block_list &from = _list(old_avail);
+	Block_list &to   = _list(sb->avail());
 
-	sb->prev = sb->next = 0;
+	if (&from == &to)
+		return;
+
+	from.remove(sb);
+	to.insert(sb);
 }
 
 
-void Slab::insert_sb(Slab_block *sb, Slab_block *at)
+void Slab::_release_empty_blocks()
 {
-	/* determine next-pointer where to assign the current sb */
-	Slab_block **nextptr_to_sb = at ? &at->next : &_first_sb;
+	/*
+	 * Releasing a block may cause nested allocations or deallocations if
+	 * the backing store uses this slab allocator for its own meta data.
+	 * We do not release blocks while serving the backing store.
+	 */
+	if (!_release || !_backing_store || _alloc_state)
+		return;
+
+	while (_empty.count > MAX_EMPTY_BLOCKS
+	    && _total_avail - _num_elem > RESERVED_ENTRIES) {
 
-	/* insert current sb */
-	sb->next = *nextptr_to_sb;
-	*nextptr_to_sb = sb;
+		/* never release the initial block, which we do not own */
+		Slab_block *sb = _empty.first;
+		if (sb == _initial_sb)
+			sb = sb->next;
+		if (!sb)
+			return;
 
-	/* update prev-pointer or succeeding block */
-	if (sb->next)
-		sb->next->prev = sb;
+		_empty.remove(sb);
+		_total_avail -= _num_elem;
 
-	sb->prev = at;
+		_alloc_state = true;
+		_backing_store->free(sb, _block_size);
+		_alloc_state = false;
+	}
 }
 
 
-bool Slab::num_free_entries_higher_than(int n)
+void Slab::insert_sb(Slab_block *sb)
 {
-	int cnt = 0;
-
-	for (Slab_block *b = _first_sb; b && b->avail() > 0; b = b->next) {
-		cnt += b->avail();
-		if (cnt > n)
-			return true;
-	}
-	return false;
+	_list(sb->avail()).insert(sb);
+	_total_avail += sb->avail();
 }
 
 
 bool Slab::alloc(size_t size, void **out_addr)
 {
-	/* sanity check if first slab block is gone */
-	if (!_first_sb) return false;
-
 	/*
 	 * If we run out of slab, we need to allocate a new slab block. For the
 	 * special case that this block is allocated using the allocator that by
@@ -239,7 +237,7 @@ bool Slab::alloc(size_t size, void **out_addr)
 	 * new slab block early enough - that is if there are only three free slab
 	 * entries left.
 	 */
-	if (_backing_store && !num_free_entries_higher_than(3) && !_alloc_state) {
+	if (_backing_store && _total_avail <= RESERVED_ENTRIES && !_alloc_state) {
 
 		/* allocate new block for slab */
 		_alloc_state = true;
@@ -248,34 +246,53 @@ bool Slab::alloc(size_t size, void **out_addr)
 
 		if (!sb) return false;
 
-		/*
-		 * The new block has the maximum number of available slots and
-		 * so we can insert it at the beginning of the sorted block
-		 * list.
-		 */
 		insert_sb(sb);
 	}
 
-	*out_addr = _first_sb->alloc();
-	return *out_addr == 0 ? false : true;
+	/* prefer partially used blocks to keep empty blocks releasable */
+	Slab_block *sb = _partial.first ? _partial.first : _empty.first;
+	if (!sb) return false;
+
+	unsigned const old_avail = sb->avail();
+
+	*out_addr = sb->alloc();
+	if (!*out_addr) return false;
+
+	_total_avail--;
+	_requeue(sb, old_avail);
+	return true;
+}
+
+
+void Slab::_free(Slab_block *sb, Slab_entry *e)
+{
+	unsigned const old_avail = sb->avail();
+
+	sb->free(e);
+	_total_avail++;
+	_requeue(sb, old_avail);
+
+	if (sb->avail() == _num_elem)
+		_release_empty_blocks();
 }
 
 
 void Slab::free(void *addr)
 {
 	Slab_entry *e = addr ? Slab_entry::slab_entry(addr) : 0;
+	if (!e) return;
 
-	if (e) e->free();
+	Slab_block *sb = e->block();
+	sb->_slab->_free(sb, e);
 }
 
 
 void *Slab::first_used_elem()
 {
-	for (Slab_block *b = _first_sb; b; b = b->next) {
+	Slab_block *blocks[] = { _full.first, _partial.first };
+	for (Slab_block *b : blocks) {
 
-		/* skip completely free slab blocks */
-		if (b->avail() == _num_elem)
-			continue;
+		if (!b) continue;
 
 		/* found a block with used elements - return address of the first one */
 		Slab_entry *e = b->first_used_entry();
@@ -287,10 +304,5 @@ void *Slab::first_used_elem()
 
 size_t Slab::consumed() const
 {
-	/* count number of slab blocks */
-	unsigned sb_cnt = 0;
-	for (Slab_block *sb = _first_sb; sb; sb = sb->next)
-		sb_cnt++;
-
-	return sb_cnt * _block_size;
+	return (_partial.count + _full.count + _empty.count) * _block_size;
 }
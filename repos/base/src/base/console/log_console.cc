@@ -12,11 +12,17 @@
  */
 
 #include <log_session/connection.h>
+#include <log_session/log_ring.h>
+#include <dataspace/client.h>
 #include <base/printf.h>
 #include <base/console.h>
 #include <base/lock.h>
 #include <base/env.h>
 
+#if defined(__i386__) || defined(__x86_64__)
+#include <trace/timestamp.h>
+#endif
+
 using namespace Genode;
 
 
@@ -34,8 +40,86 @@ class Log_console : public Console
 		unsigned       _num_chars;
 		Lock           _lock;
 
+		/*
+		 * Ring shared with the LOG server, if provided by the server
+		 */
+		Log_ring          *_ring = nullptr;
+		Signal_transmitter _ring_sigh;
+
+		void _init_ring()
+		{
+			_ring = nullptr;
+
+			try {
+				Dataspace_capability const ds = _log.ring();
+				if (!ds.valid() || Dataspace_client(ds).size() < sizeof(Log_ring))
+					return;
+
+				Signal_context_capability const sigh = _log.ring_sigh();
+				if (!sigh.valid())
+					return;
+
+				_ring_sigh = Signal_transmitter(sigh);
+				_ring      = env()->rm_session()->attach(ds);
+			} catch (...) { _ring = nullptr; }
+		}
+
+		/**
+		 * Determine severity from the escape sequence used by 'PERR' etc.
+		 */
+		static Log_ring::Severity _severity(char const *s, unsigned len)
+		{
+			if (len < 5 || s[0] != 27 || s[1] != '[' || s[4] != 'm')
+				return Log_ring::LOG;
+
+			if (s[2] == '3' && s[3] == '1') return Log_ring::ERROR;
+			if (s[2] == '3' && s[3] == '4') return Log_ring::WARNING;
+			if (s[2] == '3' && s[3] == '2') return Log_ring::INFO;
+
+			return Log_ring::LOG;
+		}
+
+		static Log_ring::Timestamp _timestamp()
+		{
+#if defined(__i386__) || defined(__x86_64__)
+			return Trace::timestamp();
+#else
+			/* the ARM cycle counter is not accessible from user level */
+			return 0;
+#endif
+		}
+
+		bool _add_to_ring(Log_ring::Severity severity,
+		                  Log_ring::Timestamp timestamp)
+		{
+			if (!_ring->add(severity, timestamp, _buf, _num_chars))
+				return false;
+
+			if (_ring->wakeup_consumer())
+				_ring_sigh.submit();
+
+			return true;
+		}
+
 		void _flush()
 		{
+			if (_ring) {
+				Log_ring::Severity  const severity  = _severity(_buf, _num_chars);
+				Log_ring::Timestamp const timestamp = _timestamp();
+
+				/* let the server make room if the ring is full */
+				bool added = _add_to_ring(severity, timestamp);
+				if (!added) {
+					_log.drain();
+					added = _add_to_ring(severity, timestamp);
+				}
+
+				if (added) {
+					_num_chars = 0;
+					return;
+				}
+			}
+
 			/* null-terminate string */
 			_buf[_num_chars] = 0;
 			_log.write(_buf);
@@ -66,7 +150,9 @@ class Log_console : public Console
 		Log_console()
 		:
 			_num_chars(0)
-		{ }
+		{
+			_init_ring();
+		}
 
 		/**
 		 * Console interface
@@ -95,6 +181,9 @@ class Log_console : public Console
 			 * has no valid capability to the original LOG session anyway.
 			 */
 			new (&_log) Log_connection;
+
+			/* the forked child must not use the ring of the original session */
+			_init_ring();
 		}
 };
 
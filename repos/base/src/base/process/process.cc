@@ -74,6 +74,8 @@ static addr_t _setup_elf(Parent_capability parent_cap,
 	/* setup region map for the new pd */
 	Elf_segment seg;
 
+	bool parent_info = false;
+
 	for (unsigned n = 0; (seg = elf.get_segment(n)).valid(); ++n) {
 		if (seg.flags().skip) continue;
 
@@ -81,7 +83,6 @@ static addr_t _setup_elf(Parent_capability parent_cap,
 		addr_t addr = (addr_t)seg.start();
 		size_t size = seg.mem_size();
 
-		bool parent_info = false;
 		off_t  offset;
 		Dataspace_capability ds_cap;
 		void *out_ptr = 0;
@@ -94,7 +95,7 @@ static addr_t _setup_elf(Parent_capability parent_cap,
 			/* read-write segment */
 			offset = 0;
 
-			/* alloc dataspace */
+			/* alloc dataspace, which core hands out zero-initialized */
 			try { ds_cap = ram.alloc(size); }
 			catch (Ram_session::Alloc_failed) {
 				PERR("Ram.alloc() failed");
@@ -102,9 +103,18 @@ static addr_t _setup_elf(Parent_capability parent_cap,
 				break;
 			}
 
-			/* attach dataspace */
+			/*
+			 * Attach only the pages that receive content from the ELF file
+			 * or the parent information. The BSS pages are already zero
+			 * and stay untouched by us.
+			 */
+			enum { PAGE_SIZE_LOG2 = 12 };
+			size_t const local_size =
+				max(align_addr(seg.file_size(), PAGE_SIZE_LOG2),
+				    (size_t)1 << PAGE_SIZE_LOG2);
+
 			void *base;
-			try { base = env()->rm_session()->attach(ds_cap); }
+			try { base = env()->rm_session()->attach(ds_cap, local_size); }
 			catch (Rm_session::Attach_failed) {
 				PERR("env()->rm_session()->attach() failed");
 				entry = 0;
@@ -114,11 +124,8 @@ static addr_t _setup_elf(Parent_capability parent_cap,
 			void *ptr = base;
 			addr_t laddr = elf_addr + seg.file_offset();
 
-			/* copy contents and fill with zeros */
+			/* copy contents */
 			memcpy(ptr, (void *)laddr, seg.file_size());
-			if (size > seg.file_size())
-				memset((void *)((addr_t)ptr + seg.file_size()),
-				       0, size - seg.file_size());
 
 			/*
 			 * we store the parent information at the beginning of the first
@@ -14,6 +14,7 @@
 #include <base/signal.h>
 #include <base/thread.h>
 #include <base/trace/events.h>
+#include <util/misc_math.h>
 #include <signal_session/connection.h>
 
 using namespace Genode;
@@ -100,33 +101,47 @@ namespace Genode {
 		private:
 
 			/*
-			 * Currently, the registry is just a linked list. If this becomes a
-			 * scalability problem, we might introduce a more sophisticated
-			 * associative data structure.
+			 * The registry is consulted for each received signal. Hence,
+			 * contexts are kept in hash buckets keyed by the context
+			 * address instead of a single list.
 			 */
-			Lock mutable                        _lock;
-			List<List_element<Signal_context> > _list;
+			enum { NUM_BUCKETS = 256 };
+
+			typedef List<List_element<Signal_context> > Bucket;
+
+			Lock mutable _lock;
+			Bucket       _buckets[NUM_BUCKETS];
+
+			static unsigned _bucket_index(Signal_context const *context)
+			{
+				/* skip the low bits, which are equal because of alignment */
+				addr_t const addr = (addr_t)context;
+				return (addr / sizeof(addr_t) ^ addr >> 12) % NUM_BUCKETS;
+			}
+
+			Bucket       &_bucket(Signal_context const *c)       { return _buckets[_bucket_index(c)]; }
+			Bucket const &_bucket(Signal_context const *c) const { return _buckets[_bucket_index(c)]; }
 
 		public:
 
 			void insert(List_element<Signal_context> *le)
 			{
 				Lock::Guard guard(_lock);
-				_list.insert(le);
+				_bucket(le->object()).insert(le);
 			}
 
 			void remove(List_element<Signal_context> *le)
 			{
 				Lock::Guard guard(_lock);
-				_list.remove(le);
+				_bucket(le->object()).remove(le);
 			}
 
 			bool test_and_lock(Signal_context *context) const
 			{
 				Lock::Guard guard(_lock);
 
-				/* search list for context */
-				List_element<Signal_context> const *le = _list.first();
+				/* search bucket for context */
+				List_element<Signal_context> const *le = _bucket(context).first();
 				for ( ; le; le = le->next()) {
 
 					if (context == le->object()) {
@@ -259,22 +274,31 @@ void Signal_receiver::local_submit(Signal::Data ns)
 void Signal_receiver::dispatch_signals(Signal_source *signal_source)
 {
 	for (;;) {
-		Signal_source::Signal source_signal = signal_source->wait_for_signal();
+		Signal_source::Signal_batch batch = signal_source->wait_for_signals();
 
-		/* look up context as pointed to by the signal imprint */
-		Signal_context *context = (Signal_context *)(source_signal.imprint());
+		/* do not trust the count delivered by the signal source */
+		unsigned const count =
+			min(batch.count, (unsigned)Signal_source::Signal_batch::MAX_SIGNALS);
 
-		if (!signal_context_registry()->test_and_lock(context)) {
-			PWRN("encountered dead signal context");
-			continue;
-		}
+		for (unsigned i = 0; i < count; i++) {
+
+			Signal_source::Signal &source_signal = batch.signals[i];
+
+			/* look up context as pointed to by the signal imprint */
+			Signal_context *context = (Signal_context *)(source_signal.imprint());
 
-		/* construct and locally submit signal object */
-		Signal::Data signal(context, source_signal.num());
-		context->_receiver->local_submit(signal);
+			if (!signal_context_registry()->test_and_lock(context)) {
+				PWRN("encountered dead signal context");
+				continue;
+			}
+
+			/* construct and locally submit signal object */
+			Signal::Data signal(context, source_signal.num());
+			context->_receiver->local_submit(signal);
 
-		/* free context lock that was taken by 'test_and_lock' */
-		context->_lock.unlock();
+			/* free context lock that was taken by 'test_and_lock' */
+			context->_lock.unlock();
+		}
 	}
 }
 
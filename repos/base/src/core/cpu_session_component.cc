@@ -260,13 +260,13 @@ void Cpu_session_component::affinity(Thread_capability  thread_cap,
 		/* convert session-local location to physical location */
 		int const x1 = location.xpos() + _location.xpos(),
 			y1 = location.ypos() + _location.ypos(),
-			x2 = location.xpos() +  location.width(),
-			y2 = location.ypos() +  location.height();
+			x2 = x1 + (int)location.width()  - 1,
+			y2 = y1 + (int)location.height() - 1;
 
 		int const clipped_x1 = max(_location.xpos(), x1),
 			clipped_y1 = max(_location.ypos(), y1),
-			clipped_x2 = max(_location.xpos() + (int)_location.width()  - 1, x2),
-			clipped_y2 = max(_location.ypos() + (int)_location.height() - 1, y2);
+			clipped_x2 = min(_location.xpos() + (int)_location.width()  - 1, x2),
+			clipped_y2 = min(_location.ypos() + (int)_location.height() - 1, y2);
 
 		thread->platform_thread()->affinity(Affinity::Location(clipped_x1, clipped_y1,
 		                                    clipped_x2 - clipped_x1 + 1,
@@ -16,6 +16,7 @@
 
 #include <base/stdint.h>
 #include <base/weak_ptr.h>
+#include <base/trace/types.h>
 
 namespace Genode { struct Address_space; }
 
@@ -28,6 +29,11 @@ struct Genode::Address_space : Genode::Weak_object<Genode::Address_space>
 	 * \param size       size of range in bytes, must be a multiple of page size
 	 */
 	virtual void flush(addr_t virt_addr, size_t size) = 0;
+
+	/**
+	 * Page faults resolved for the address space, reported via tracing
+	 */
+	Trace::Page_faults page_faults;
 };
 
 #endif /* _CORE__INCLUDE__ADDRESS_SPACE_H_ */
@@ -63,6 +63,31 @@ namespace Genode {
 			unsigned            const _trace_control_index;
 			Trace::Source             _trace_source;
 
+			/**
+			 * Return page-fault statistics of the thread's address space
+			 */
+			Trace::Page_faults _page_faults() const
+			{
+				/* 'address_space' is not a const function on all platforms */
+				Weak_ptr<Address_space> address_space =
+					const_cast<Platform_thread &>(_platform_thread).address_space();
+
+				Locked_ptr<Address_space> locked_ptr(address_space);
+				return locked_ptr.is_valid() ? locked_ptr->page_faults
+				                             : Trace::Page_faults();
+			}
+
+			/**
+			 * Return instruction pointer of the thread, or 0 if unavailable
+			 */
+			Trace::Instruction_pointer _instruction_pointer() const
+			{
+				/* 'state' is not a const function */
+				try {
+					return const_cast<Platform_thread &>(_platform_thread).state().ip; }
+				catch (...) { return Trace::Instruction_pointer(); }
+			}
+
 		public:
 
 			/**
@@ -104,7 +129,8 @@ namespace Genode {
 			{
 				return { _session_label, _name,
 				         _platform_thread.execution_time(),
-				         _platform_thread.affinity() };
+				         _platform_thread.affinity(),
+				         _page_faults(), _instruction_pointer() };
 			}
 
 
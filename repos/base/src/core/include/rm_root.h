@@ -41,6 +41,16 @@ namespace Genode {
 				size_t size      = Arg_string::find_arg(args, "size").ulong_value(0);
 				size_t ram_quota = Arg_string::find_arg(args, "ram_quota").ulong_value(0);
 
+				/*
+				 * The optional 'fault_around' argument limits the size of
+				 * the mappings used to resolve page faults (log2). If not
+				 * specified, only the platform's constraints apply.
+				 */
+				size_t fault_around_size_log2 =
+					Arg_string::find_arg(args, "fault_around").ulong_value(0);
+				if (!fault_around_size_log2)
+					fault_around_size_log2 = ~0UL;
+
 				return new (md_alloc())
 				       Rm_session_component(_ds_ep,
 				                            _thread_ep,
@@ -48,7 +58,8 @@ namespace Genode {
 				                            _md_alloc, ram_quota,
 				                            &_pager_ep,
 				                            start == ~0UL ? _vm_start : start,
-				                            size  ==  0   ? _vm_size  : size);
+				                            size  ==  0   ? _vm_size  : size,
+				                            fault_around_size_log2);
 			}
 
 			Session_capability session(Root::Session_args const &args, Affinity const &affinity)
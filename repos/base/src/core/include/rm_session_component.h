@@ -281,6 +281,9 @@ namespace Genode {
 			Pager_entrypoint             *_pager_ep;
 			Rm_dataspace_component        _ds;           /* dataspace representation of region map */
 			Dataspace_capability          _ds_cap;
+			size_t const                  _fault_around_size_log2; /* upper bound of
+			                                                          mappings created
+			                                                          on page faults */
 
 			template <typename F>
 			auto _apply_to_dataspace(addr_t addr, F f, addr_t offset, unsigned level)
@@ -331,7 +334,8 @@ namespace Genode {
 			                     size_t            ram_quota,
 			                     Pager_entrypoint *pager_ep,
 			                     addr_t            vm_start,
-			                     size_t            vm_size);
+			                     size_t            vm_size,
+			                     size_t            fault_around_size_log2);
 
 			~Rm_session_component();
 
@@ -382,6 +386,12 @@ namespace Genode {
 				return _apply_to_dataspace(addr, f, 0, RECURSION_LIMIT);
 			}
 
+			/**
+			 * Return upper bound of the size of mappings used to resolve
+			 * page faults of the session's clients
+			 */
+			size_t fault_around_size_log2() const { return _fault_around_size_log2; }
+
 			/**************************************
 			 ** Region manager session interface **
 			 **************************************/
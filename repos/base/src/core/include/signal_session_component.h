@@ -107,6 +107,7 @@ namespace Genode {
 			Signal_queue        _signal_queue;
 			Rpc_entrypoint     *_entrypoint;
 			Native_capability   _reply_cap;
+			bool                _reply_batched;  /* blocked in 'wait_for_signals' */
 			Finalizer_component _finalizer;
 			Capability<Finalizer> _finalizer_cap;
 
@@ -130,7 +131,8 @@ namespace Genode {
 			 ** Signal-source interface **
 			 *****************************/
 
-			Signal wait_for_signal();
+			Signal       wait_for_signal();
+			Signal_batch wait_for_signals();
 	};
 
 
@@ -56,6 +56,8 @@ class Genode::Trace::Source
 			Thread_name        name;
 			Execution_time     execution_time;
 			Affinity::Location affinity;
+			Page_faults         page_faults;
+			Instruction_pointer instruction_pointer;
 		};
 
 		/**
@@ -238,6 +238,8 @@ class Genode::Trace::Subject
 		{
 			Execution_time execution_time;
 			Affinity::Location affinity;
+			Page_faults page_faults;
+			Instruction_pointer instruction_pointer;
 
 			{
 				Locked_ptr<Source> source(_source);
@@ -246,11 +248,15 @@ class Genode::Trace::Subject
 					Trace::Source::Info const info = source->info();
 					execution_time = info.execution_time;
 					affinity       = info.affinity;
+					page_faults    = info.page_faults;
+
+					instruction_pointer = info.instruction_pointer;
 				}
 			}
 
 			return Subject_info(_label, _name, _state(), _policy_id,
-			                    execution_time, affinity);
+			                    execution_time, affinity, page_faults,
+			                    instruction_pointer);
 		}
 
 		Dataspace_capability buffer() const { return _buffer.dataspace(); }
@@ -175,6 +175,9 @@ int Rm_client::pager(Ipc_pager &pager)
 	if (verbose_page_faults)
 		print_page_fault("page fault", pf_addr, pf_ip, pf_type, badge());
 
+	/* size of the mapping used for resolving the fault */
+	size_t map_size_log2 = 0;
+
 	auto lambda = [&] (Rm_session_component *rm_session,
 	                   Rm_region            *region,
 	                   addr_t                ds_offset,
@@ -213,10 +216,18 @@ int Rm_client::pager(Ipc_pager &pager)
 		 * Determine mapping size compatible with source and destination,
 		 * and apply platform-specific constraint of mapping sizes.
 		 */
-		size_t map_size_log2 = dst_fault_area.common_size_log2(dst_fault_area,
-		                                                       src_fault_area);
+		map_size_log2 = dst_fault_area.common_size_log2(dst_fault_area,
+		                                                src_fault_area);
 		map_size_log2 = constrain_map_size_log2(map_size_log2);
 
+		/*
+		 * Apply the fault-around limits of the address space and of the
+		 * (possibly nested) RM session that holds the region
+		 */
+		map_size_log2 = min(map_size_log2,
+		                    min(member_rm_session()->fault_around_size_log2(),
+		                        rm_session->fault_around_size_log2()));
+
 		src_fault_area.constrain(map_size_log2);
 		dst_fault_area.constrain(map_size_log2);
 		if (!src_fault_area.valid() || !dst_fault_area.valid())
@@ -255,7 +266,18 @@ int Rm_client::pager(Ipc_pager &pager)
 		pager.set_reply_mapping(mapping);
 		return 0;
 	};
-	return member_rm_session()->apply_to_dataspace(pf_addr, lambda);
+	int const result = member_rm_session()->apply_to_dataspace(pf_addr, lambda);
+
+	/* account resolved fault at the address space of the faulter */
+	if (result == 0) {
+		Locked_ptr<Address_space> address_space(_address_space);
+		if (address_space.is_valid()) {
+			address_space->page_faults.faults++;
+			address_space->page_faults.pages +=
+				1UL << (map_size_log2 - get_page_size_log2());
+		}
+	}
+	return result;
 }
 
 
@@ -699,14 +721,17 @@ Rm_session_component::Rm_session_component(Rpc_entrypoint   *ds_ep,
                                            size_t            ram_quota,
                                            Pager_entrypoint *pager_ep,
                                            addr_t            vm_start,
-                                           size_t            vm_size)
+                                           size_t            vm_size,
+                                           size_t            fault_around_size_log2)
 :
 	_ds_ep(ds_ep), _thread_ep(thread_ep), _session_ep(session_ep),
 	_md_alloc(md_alloc, ram_quota),
 	_client_slab(&_md_alloc), _ref_slab(&_md_alloc),
 	_map(&_md_alloc), _pager_ep(pager_ep),
 	_ds(align_addr(vm_size, get_page_size_log2())),
-	_ds_cap(_type_deduction_helper(ds_ep->manage(&_ds)))
+	_ds_cap(_type_deduction_helper(ds_ep->manage(&_ds))),
+	_fault_around_size_log2(max(fault_around_size_log2,
+	                            (size_t)get_page_size_log2()))
 {
 	/* configure managed VM area */
 	_map.add_range(vm_start, align_addr(vm_size, get_page_size_log2()));
@@ -49,7 +49,15 @@ void Signal_source_component::submit(Signal_context_component *context,
 	 */
 	if (_reply_cap.valid()) {
 
-		*ostream << Signal(context->imprint(), context->cnt());
+		/* the reply must match the RPC function the client blocks in */
+		Signal const signal(context->imprint(), context->cnt());
+		if (_reply_batched) {
+			Signal_batch batch;
+			batch.add(signal);
+			*ostream << batch;
+		} else {
+			*ostream << signal;
+		}
 		_entrypoint->explicit_reply(_reply_cap, 0);
 
 		/*
@@ -77,6 +85,7 @@ Signal_source::Signal Signal_source_component::wait_for_signal()
 		 * for the later call of 'explicit_reply()'.
 		 */
 		_reply_cap = _entrypoint->reply_dst();
+		_reply_batched = false;
 		_entrypoint->omit_reply();
 		return Signal(0, 0);  /* just a dummy */
 	}
@@ -89,9 +98,31 @@ Signal_source::Signal Signal_source_component::wait_for_signal()
 }
 
 
+Signal_source::Signal_batch Signal_source_component::wait_for_signals()
+{
+	Signal_batch batch;
+
+	/* keep client blocked, see 'wait_for_signal' */
+	if (_signal_queue.empty()) {
+		_reply_cap = _entrypoint->reply_dst();
+		_reply_batched = true;
+		_entrypoint->omit_reply();
+		return batch;  /* just a dummy */
+	}
+
+	/* dequeue and return as many pending signals as fit into the batch */
+	while (!_signal_queue.empty() && !batch.full()) {
+		Signal_context_component *context = _signal_queue.dequeue();
+		batch.add(Signal(context->imprint(), context->cnt()));
+		context->reset_signal_cnt();
+	}
+	return batch;
+}
+
+
 Signal_source_component::Signal_source_component(Rpc_entrypoint *ep)
 :
-	_entrypoint(ep), _finalizer(*this),
+	_entrypoint(ep), _reply_batched(false), _finalizer(*this),
 	_finalizer_cap(_entrypoint->manage(&_finalizer))
 { }
 
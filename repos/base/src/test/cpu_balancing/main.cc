@@ -0,0 +1,97 @@
+/*
+ * \brief  Throughput of CPU-bound threads that have no explicit affinity
+ * \author agent
+ * \date   2015-12-07
+ *
+ * All worker threads are created at the default location of the CPU
+ * session. Hence, the throughput scales with the number of threads only if
+ * the kernel spreads the threads over the available CPUs.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/env.h>
+#include <timer_session/connection.h>
+
+
+enum { STACK_SIZE = sizeof(long)*1024, WORK_PER_THREAD = 64 * 1024 * 1024 };
+
+struct Worker : Genode::Thread<STACK_SIZE>
+{
+	unsigned long const work;
+
+	Genode::uint64_t volatile cnt = 0;
+
+	void entry() { while (cnt < work) cnt++; }
+
+	Worker(unsigned long work) : Genode::Thread<STACK_SIZE>("worker"), work(work)
+	{
+		start();
+	}
+};
+
+
+/**
+ * Let 'num' threads do the same amount of work in total
+ *
+ * \return  throughput in work units per millisecond
+ */
+static unsigned long measure(Timer::Connection &timer, unsigned const num)
+{
+	using namespace Genode;
+
+	unsigned long const work = WORK_PER_THREAD;
+
+	Worker ** workers = new (env()->heap()) Worker*[num];
+
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < num; i++)
+		workers[i] = new (env()->heap()) Worker(work);
+
+	for (unsigned i = 0; i < num; i++) {
+		workers[i]->join();
+		destroy(env()->heap(), workers[i]);
+	}
+
+	unsigned long const ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+	destroy(env()->heap(), workers);
+
+	unsigned long const throughput = (work/ms)*num;
+	printf("%2u thread%s: %6lu ms, %8lu units/ms\n",
+	       num, num == 1 ? " " : "s", ms, throughput);
+	return throughput;
+}
+
+
+int main(int argc, char **argv)
+{
+	using namespace Genode;
+
+	printf("--- test-cpu_balancing started ---\n");
+
+	Affinity::Space cpus = env()->cpu_session()->affinity_space();
+	printf("Detected %ux%u CPU%s\n",
+	       cpus.width(), cpus.height(), cpus.total() > 1 ? "s." : ".");
+
+	static Timer::Connection timer;
+
+	unsigned long const single = measure(timer, 1);
+
+	unsigned long multi = 0;
+	for (unsigned num = 2; num <= 2*cpus.total(); num *= 2)
+		multi = max(multi, measure(timer, num));
+
+	printf("speedup: %lu.%02lu\n", multi/single, (100*multi/single) % 100);
+	printf("--- test-cpu_balancing finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-cpu_balancing
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,118 @@
+/*
+ * \brief  Ping-pong RPC latency benchmark
+ * \author agent
+ * \date   2015-11-26
+ *
+ * A client thread repeatedly calls an RPC object served by a local
+ * entrypoint. The benchmark reports the average number of timestamp ticks
+ * (e.g., CPU cycles on x86) per round trip for calls with and without
+ * payload.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <cap_session/connection.h>
+#include <trace/timestamp.h>
+#include <util/string.h>
+
+namespace Test {
+
+	typedef Genode::String<64> Payload;
+
+	struct Ping
+	{
+		GENODE_RPC(Rpc_ping, unsigned, ping, unsigned);
+		GENODE_RPC(Rpc_ping_payload, unsigned, ping_payload, Payload const &);
+		GENODE_RPC_INTERFACE(Rpc_ping, Rpc_ping_payload);
+	};
+
+	struct Client : Genode::Rpc_client<Ping>
+	{
+		Client(Genode::Capability<Ping> cap) : Rpc_client<Ping>(cap) { }
+
+		unsigned ping(unsigned value) { return call<Rpc_ping>(value); }
+
+		unsigned ping_payload(Payload const &payload) {
+			return call<Rpc_ping_payload>(payload); }
+	};
+
+	struct Component : Genode::Rpc_object<Ping, Component>
+	{
+		unsigned ping(unsigned value) { return value + 1; }
+
+		unsigned ping_payload(Payload const &payload) {
+			return Genode::strlen(payload.string()); }
+	};
+}
+
+
+using namespace Genode;
+
+enum { ROUNDS = 5, CALLS_PER_ROUND = 10000 };
+
+
+template <typename FN>
+static void measure(char const *name, FN const &fn)
+{
+	Trace::Timestamp best = ~(Trace::Timestamp)0;
+
+	for (unsigned round = 0; round < ROUNDS; round++) {
+
+		Trace::Timestamp const start = Trace::timestamp();
+
+		for (unsigned i = 0; i < CALLS_PER_ROUND; i++)
+			fn(i);
+
+		Trace::Timestamp const duration = Trace::timestamp() - start;
+
+		if (duration < best)
+			best = duration;
+	}
+
+	printf("%-12s %10llu ticks per call\n", name,
+	       (unsigned long long)(best / CALLS_PER_ROUND));
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- RPC latency benchmark (%u calls per round) ---\n",
+	       (unsigned)CALLS_PER_ROUND);
+
+	enum { STACK_SIZE = 4096*sizeof(long) };
+
+	static Cap_connection cap;
+	static Rpc_entrypoint ep(&cap, STACK_SIZE, "ping_ep");
+	static Test::Component component;
+
+	Test::Client client(ep.manage(&component));
+
+	bool ok = true;
+
+	measure("ping", [&] (unsigned i) {
+		if (client.ping(i) != i + 1) ok = false; });
+
+	Test::Payload const payload("0123456789abcdef0123456789abcdef");
+	measure("ping+payload", [&] (unsigned) {
+		if (client.ping_payload(payload) != 32) ok = false; });
+
+	ep.dissolve(&component);
+
+	if (!ok) {
+		PERR("unexpected reply value");
+		return -1;
+	}
+
+	printf("--- RPC latency benchmark finished ---\n");
+	return 0;
+}
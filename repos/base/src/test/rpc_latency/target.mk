@@ -0,0 +1,3 @@
+TARGET = test-rpc_latency
+SRC_CC = main.cc
+LIBS   = base
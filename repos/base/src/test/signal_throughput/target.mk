@@ -0,0 +1,3 @@
+TARGET = test-signal_throughput
+SRC_CC = main.cc
+LIBS   = base
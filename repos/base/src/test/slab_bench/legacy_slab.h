@@ -0,0 +1,186 @@
+/*
+ * \brief  Former slab-allocator implementation used as reference
+ * \author agent
+ * \date   2015-11-27
+ *
+ * This is a condensed copy of the slab allocator as it existed before the
+ * introduction of per-block free lists. Each allocation scans the state
+ * table of a block for a free entry, and each allocation and deallocation
+ * keeps the block list sorted by the number of free entries.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LEGACY_SLAB_H_
+#define _LEGACY_SLAB_H_
+
+#include <base/allocator.h>
+#include <util/construct_at.h>
+#include <util/misc_math.h>
+
+namespace Legacy { class Slab; }
+
+
+class Legacy::Slab
+{
+	private:
+
+		typedef Genode::size_t size_t;
+		typedef Genode::addr_t addr_t;
+
+		enum { FREE, USED };
+
+		struct Block;
+
+		struct Entry
+		{
+			Block *sb;
+			char   data[];
+		};
+
+		struct Block
+		{
+			Block   *next = 0;
+			Block   *prev = 0;
+			Slab    &slab;
+			unsigned avail;
+			char     data[];
+
+			Block(Slab &slab) : slab(slab), avail(slab._num_elem)
+			{
+				for (unsigned i = 0; i < avail; i++)
+					data[i] = FREE;
+			}
+
+			Entry *entry(unsigned idx)
+			{
+				return (Entry *)&data[Genode::align_addr(slab._num_elem, 2)
+				                      + slab._entry_size*idx];
+			}
+
+			unsigned entry_idx(Entry *e) {
+				return ((addr_t)e - (addr_t)entry(0))/slab._entry_size; }
+		};
+
+		size_t const         _entry_size;
+		size_t const         _block_size;
+		size_t const         _num_elem;
+		Block               *_first_sb = 0;
+		Genode::Allocator   &_backing_store;
+
+		void _remove(Block *sb)
+		{
+			if (sb->prev) sb->prev->next = sb->next;
+			if (sb->next) sb->next->prev = sb->prev;
+			if (_first_sb == sb) _first_sb = sb->next;
+			sb->prev = sb->next = 0;
+		}
+
+		void _insert(Block *sb, Block *at)
+		{
+			Block **nextptr = at ? &at->next : &_first_sb;
+			sb->next = *nextptr;
+			*nextptr = sb;
+			if (sb->next) sb->next->prev = sb;
+			sb->prev = at;
+		}
+
+		bool _num_free_entries_higher_than(unsigned n)
+		{
+			unsigned cnt = 0;
+			for (Block *b = _first_sb; b && b->avail > 0; b = b->next)
+				if ((cnt += b->avail) > n)
+					return true;
+			return false;
+		}
+
+		void _dec_avail(Block *sb)
+		{
+			sb->avail--;
+
+			Block *at = sb;
+			while (at->next && at->next->avail > sb->avail)
+				at = at->next;
+
+			if (at == sb) return;
+
+			_remove(sb);
+			_insert(sb, at);
+		}
+
+		void _inc_avail(Block *sb)
+		{
+			sb->avail++;
+
+			Block *at = sb->prev;
+			while (at && at->avail < sb->avail)
+				at = at->prev;
+
+			if (sb->prev == 0 || at == sb->prev)
+				return;
+
+			_remove(sb);
+			_insert(sb, at);
+		}
+
+		Block *_new_block()
+		{
+			void *sb = 0;
+			if (!_backing_store.alloc(_block_size, &sb))
+				return 0;
+			return Genode::construct_at<Block>(sb, *this);
+		}
+
+	public:
+
+		Slab(size_t slab_size, size_t block_size, Genode::Allocator &backing_store)
+		:
+			_entry_size(sizeof(Entry) + slab_size), _block_size(block_size),
+			_num_elem((block_size - sizeof(Block) - sizeof(Genode::umword_t))
+			          / (_entry_size + 1)),
+			_backing_store(backing_store)
+		{ }
+
+		~Slab()
+		{
+			while (Block *sb = _first_sb) {
+				_remove(sb);
+				_backing_store.free(sb, _block_size);
+			}
+		}
+
+		void *alloc()
+		{
+			if (!_num_free_entries_higher_than(3)) {
+				Block *sb = _new_block();
+				if (!sb) return 0;
+				_insert(sb, 0);
+			}
+
+			Block *sb = _first_sb;
+			for (unsigned i = 0; i < _num_elem; i++)
+				if (sb->data[i] == FREE) {
+					sb->data[i] = USED;
+					Entry *e = sb->entry(i);
+					e->sb = sb;
+					_dec_avail(sb);
+					return e->data;
+				}
+			return 0;
+		}
+
+		void free(void *addr)
+		{
+			Entry *e  = (Entry *)((addr_t)addr - sizeof(Entry));
+			Block *sb = e->sb;
+			sb->data[sb->entry_idx(e)] = FREE;
+			_inc_avail(sb);
+		}
+};
+
+#endif /* _LEGACY_SLAB_H_ */
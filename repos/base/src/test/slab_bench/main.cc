@@ -0,0 +1,152 @@
+/*
+ * \brief  Slab-allocator microbenchmark
+ * \author agent
+ * \date   2015-11-27
+ *
+ * The benchmark compares the slab allocator with its former implementation
+ * (see 'legacy_slab.h'). For each implementation, it reports the average
+ * costs of an allocation and a histogram of allocation latencies measured
+ * in timestamp ticks (e.g., CPU cycles on x86).
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/heap.h>
+#include <base/printf.h>
+#include <base/slab.h>
+#include <trace/timestamp.h>
+
+/* local includes */
+#include "legacy_slab.h"
+
+using namespace Genode;
+
+enum {
+	SLAB_SIZE   = 64,
+	BLOCK_SIZE  = 4096,
+	NUM_OBJECTS = 16*1024,
+	NUM_CHURN   = 256*1024,
+};
+
+
+/**
+ * Histogram of latencies with power-of-two buckets
+ */
+struct Histogram
+{
+	enum { NUM_BUCKETS = 16, MIN_LOG2 = 4 };
+
+	unsigned long    buckets[NUM_BUCKETS];
+	unsigned long    count = 0;
+	Trace::Timestamp total = 0;
+
+	Histogram() { memset(buckets, 0, sizeof(buckets)); }
+
+	void add(Trace::Timestamp ticks)
+	{
+		unsigned i = 0;
+		for (; i < NUM_BUCKETS - 1 && (ticks >> (MIN_LOG2 + i)); i++);
+
+		buckets[i]++;
+		count++;
+		total += ticks;
+	}
+
+	void print(char const *name) const
+	{
+		printf("%s: %lu allocations, %llu ticks on average\n", name, count,
+		       (unsigned long long)(count ? total / count : 0));
+
+		for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+			if (!buckets[i]) continue;
+
+			if (i == NUM_BUCKETS - 1)
+				printf("  >= %6u ticks: %lu\n", 1U << (MIN_LOG2 + i - 1), buckets[i]);
+			else
+				printf("   < %6u ticks: %lu\n", 1U << (MIN_LOG2 + i), buckets[i]);
+		}
+	}
+};
+
+
+/**
+ * Pseudo-random number generator used for the churn pattern
+ */
+struct Random
+{
+	unsigned long state = 1;
+
+	unsigned long next()
+	{
+		state = state*1103515245 + 12345;
+		return state >> 16;
+	}
+};
+
+
+template <typename ALLOC_FN, typename FREE_FN>
+static void run(char const *name, ALLOC_FN const &alloc, FREE_FN const &free)
+{
+	static void *objects[NUM_OBJECTS];
+	Histogram histogram;
+
+	auto timed_alloc = [&] () {
+		Trace::Timestamp const start = Trace::timestamp();
+		void *ptr = alloc();
+		histogram.add(Trace::timestamp() - start);
+		return ptr;
+	};
+
+	/* fill the slab */
+	for (unsigned i = 0; i < NUM_OBJECTS; i++)
+		objects[i] = timed_alloc();
+
+	/* replace random objects */
+	Random random;
+	for (unsigned i = 0; i < NUM_CHURN; i++) {
+		unsigned const idx = random.next() % NUM_OBJECTS;
+		free(objects[idx]);
+		objects[idx] = timed_alloc();
+	}
+
+	for (unsigned i = 0; i < NUM_OBJECTS; i++)
+		free(objects[i]);
+
+	histogram.print(name);
+}
+
+
+int main()
+{
+	printf("--- slab benchmark (%u objects of %u bytes, %u replacements) ---\n",
+	       (unsigned)NUM_OBJECTS, (unsigned)SLAB_SIZE, (unsigned)NUM_CHURN);
+
+	static Heap heap(env()->ram_session(), env()->rm_session());
+
+	{
+		Legacy::Slab slab(SLAB_SIZE, BLOCK_SIZE, heap);
+		run("legacy slab",
+		    [&] () { return slab.alloc(); },
+		    [&] (void *ptr) { slab.free(ptr); });
+	}
+
+	{
+		Slab slab(SLAB_SIZE, BLOCK_SIZE, nullptr, &heap, true);
+		run("slab",
+		    [&] () { void *ptr = nullptr; slab.alloc(SLAB_SIZE, &ptr); return ptr; },
+		    [&] (void *ptr) { slab.free(ptr); });
+
+		printf("slab: %zu bytes consumed after freeing all objects\n",
+		       slab.consumed());
+	}
+
+	printf("--- slab benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-slab_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,97 @@
+/*
+ * \brief  Former byte-wise string utilities used as reference
+ * \author agent
+ * \date   2015-12-02
+ *
+ * This is a copy of the memory and string functions of 'util/string.h' as
+ * they existed before the introduction of word-wise processing and the
+ * CPU-specific 'memset_cpu'.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LEGACY_STRING_H_
+#define _LEGACY_STRING_H_
+
+#include <base/stdint.h>
+
+namespace Legacy {
+
+	using Genode::size_t;
+
+	inline size_t strlen(const char *s)
+	{
+		size_t res = 0;
+		for (; s && *s; s++, res++);
+		return res;
+	}
+
+	inline int strcmp(const char *s1, const char *s2, size_t len = ~0UL)
+	{
+		for (; *s1 && *s1 == *s2 && len; s1++, s2++, len--) ;
+		return len ? *s1 - *s2 : 0;
+	}
+
+	inline void *memmove(void *dst, const void *src, size_t size)
+	{
+		char *d = (char *)dst, *s = (char *)src;
+		size_t i;
+
+		if (s > d)
+			for (i = 0; i < size; i++, *d++ = *s++);
+		else
+			for (s += size - 1, d += size - 1, i = size; i-- > 0; *d-- = *s--);
+
+		return dst;
+	}
+
+	inline void *memcpy(void *dst, const void *src, size_t size)
+	{
+		char *d = (char *)dst, *s = (char *)src;
+		size_t i;
+
+		/* check for overlap */
+		if ((d + size > s) && (s + size > d))
+			return memmove(dst, src, size);
+
+		/* copy eight byte chunks */
+		for (i = size >> 3; i > 0; i--, *d++ = *s++,
+		                                *d++ = *s++,
+		                                *d++ = *s++,
+		                                *d++ = *s++,
+		                                *d++ = *s++,
+		                                *d++ = *s++,
+		                                *d++ = *s++,
+		                                *d++ = *s++);
+
+		/* copy left over */
+		for (i = 0; i < (size & 0x7); i++, *d++ = *s++);
+
+		return dst;
+	}
+
+	inline int memcmp(const void *p0, const void *p1, size_t size)
+	{
+		const unsigned char *c0 = (const unsigned char *)p0;
+		const unsigned char *c1 = (const unsigned char *)p1;
+
+		size_t i;
+		for (i = 0; i < size; i++)
+			if (c0[i] != c1[i]) return c0[i] - c1[i];
+
+		return 0;
+	}
+
+	inline void *memset(void *dst, int i, size_t size)
+	{
+		while (size--) ((char *)dst)[size] = i;
+		return dst;
+	}
+}
+
+#endif /* _LEGACY_STRING_H_ */
@@ -0,0 +1,147 @@
+/*
+ * \brief  Microbenchmark of the memory and string utilities
+ * \author agent
+ * \date   2015-12-02
+ *
+ * The benchmark compares the functions of 'util/string.h' with their former
+ * byte-wise implementation (see 'legacy_string.h') for block sizes from
+ * 8 bytes to 64 MiB. For each function and size, it reports the average
+ * costs of one call in timestamp ticks (e.g., CPU cycles on x86) and the
+ * resulting throughput in bytes per 100 ticks.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <util/string.h>
+#include <trace/timestamp.h>
+
+/* local includes */
+#include "legacy_string.h"
+
+using namespace Genode;
+
+enum {
+	MIN_SIZE    = 8,
+	MAX_SIZE    = 64*1024*1024,
+	TOTAL_BYTES = 16*1024*1024,  /* processed bytes per measurement */
+	SLACK       = 64,            /* space for misaligned and moved blocks */
+};
+
+
+static volatile unsigned long sink;
+
+
+/**
+ * Buffers used as source and destination
+ */
+struct Buffers
+{
+	char *a = _alloc();
+	char *b = _alloc();
+
+	static char *_alloc()
+	{
+		Ram_dataspace_capability ds =
+			env()->ram_session()->alloc(MAX_SIZE + SLACK);
+		return env()->rm_session()->attach(ds);
+	}
+
+	/**
+	 * Prepare two equal null-terminated strings of 'size' bytes
+	 */
+	void strings(size_t size)
+	{
+		Genode::memset(a, 'a', size);
+		Genode::memset(b, 'a', size);
+		a[size - 1] = b[size - 1] = 0;
+	}
+};
+
+
+/**
+ * Measure average ticks of calling 'fn' for a block of 'size' bytes
+ */
+template <typename FN>
+static Trace::Timestamp measure(size_t size, FN const &fn)
+{
+	unsigned long const rounds = max(TOTAL_BYTES / size, 1UL);
+
+	Trace::Timestamp const start = Trace::timestamp();
+	for (unsigned long i = 0; i < rounds; i++)
+		fn();
+
+	return (Trace::timestamp() - start) / rounds;
+}
+
+
+template <typename FN, typename LEGACY_FN>
+static void run(char const *name, size_t size,
+                FN const &fn, LEGACY_FN const &legacy_fn)
+{
+	Trace::Timestamp const ticks        = max(measure(size, fn), (Trace::Timestamp)1);
+	Trace::Timestamp const legacy_ticks = max(measure(size, legacy_fn), (Trace::Timestamp)1);
+
+	printf("%-16s %9zu bytes: %10llu ticks %6llu B/100t,"
+	       " legacy %10llu ticks %6llu B/100t\n", name, size,
+	       (unsigned long long)ticks, (unsigned long long)(size*100/ticks),
+	       (unsigned long long)legacy_ticks,
+	       (unsigned long long)(size*100/legacy_ticks));
+}
+
+
+int main()
+{
+	printf("--- string benchmark (%u to %u bytes) ---\n",
+	       (unsigned)MIN_SIZE, (unsigned)MAX_SIZE);
+
+	static Buffers buf;
+
+	char * const a = buf.a;
+	char * const b = buf.b;
+
+	for (size_t size = MIN_SIZE; size <= MAX_SIZE; size *= 2) {
+
+		run("memcpy", size,
+		    [&] () { Genode::memcpy(b, a, size); },
+		    [&] () { Legacy::memcpy(b, a, size); });
+
+		run("memcpy unaligned", size,
+		    [&] () { Genode::memcpy(b, a + 1, size); },
+		    [&] () { Legacy::memcpy(b, a + 1, size); });
+
+		run("memmove", size,
+		    [&] () { Genode::memmove(a + SLACK, a, size); },
+		    [&] () { Legacy::memmove(a + SLACK, a, size); });
+
+		run("memset", size,
+		    [&] () { Genode::memset(a, 0, size); },
+		    [&] () { Legacy::memset(a, 0, size); });
+
+		Genode::memcpy(b, a, size);
+
+		run("memcmp", size,
+		    [&] () { sink += Genode::memcmp(a, b, size); },
+		    [&] () { sink += Legacy::memcmp(a, b, size); });
+
+		buf.strings(size);
+
+		run("strlen", size,
+		    [&] () { sink += Genode::strlen(a); },
+		    [&] () { sink += Legacy::strlen(a); });
+
+		run("strcmp", size,
+		    [&] () { sink += Genode::strcmp(a, b); },
+		    [&] () { sink += Legacy::strcmp(a, b); });
+	}
+
+	printf("--- string benchmark finished ---\n");
+	return 0;
+}
@@ -19,27 +19,161 @@
 #include <block_session/connection.h>
 #include <block/component.h>
 #include <os/packet_allocator.h>
+#include <os/server.h>
 
 /* local includes */
 #include "cgd.h"
+#include "io_pool.h"
 
 
-class Driver : public Block::Driver
+class Driver : public Block::Driver, private Cgd::Io_job::Owner
 {
 	private:
 
+		enum {
+			MAX_REQUESTS   = 32,        /* requests processed concurrently */
+			MAX_CHUNKS     = 4,         /* parts of one request processed concurrently */
+			MIN_CHUNK_SIZE = 16*1024,
+		};
+
+		struct Request;
+
+		struct Chunk : Cgd::Io_job { Request *request = 0; };
+
+		/*
+		 * A request is split into chunks that are handed to the I/O pool
+		 * individually. Hence, the processing of large requests is
+		 * pipelined, e.g., one chunk gets encrypted while the previous one
+		 * is written to the backing device.
+		 */
+		struct Request : Genode::Fifo<Request>::Element
+		{
+			Block::Packet_descriptor packet;
+			Chunk                    chunks[MAX_CHUNKS];
+			unsigned                 pending = 0;
+			bool                     success = true;
+		};
+
 		Block::Session::Operations         _ops;
 		Genode::size_t                     _blk_sz;
 		Block::sector_t                    _blk_cnt;
 
 		Cgd::Device                       *_cgd_device;
+		Cgd::Io_pool                      &_io_pool;
+
+		Genode::Signal_rpc_member<Driver>  _completed_dispatcher;
+
+		Request                  _requests[MAX_REQUESTS];
+		Genode::Fifo<Request>    _free_requests;       /* accessed by the entrypoint only */
+
+		Genode::Lock             _completed_lock;
+		Genode::Fifo<Request>    _completed_requests;
+		unsigned                 _requests_in_flight = 0;
+		bool                     _closing            = false;
+		Genode::Semaphore        _closed_sem;
+
+		/**
+		 * Io_job::Owner interface, called by an I/O thread
+		 */
+		void completed(Cgd::Io_job &job, bool success) override
+		{
+			Genode::Lock::Guard guard(_completed_lock);
+
+			Request &request = *static_cast<Chunk &>(job).request;
+			request.success &= success;
+			if (--request.pending)
+				return;
+
+			_completed_requests.enqueue(&request);
+			_requests_in_flight--;
+
+			if (_closing) {
+				_closed_sem.up();
+				return;
+			}
+
+			Genode::Signal_transmitter(_completed_dispatcher).submit();
+		}
+
+		/**
+		 * Acknowledge completed requests, executed by the entrypoint
+		 */
+		void _ack_completed(unsigned)
+		{
+			for (;;) {
+				Request *request = 0;
+				{
+					Genode::Lock::Guard guard(_completed_lock);
+					request = _completed_requests.dequeue();
+				}
+				if (!request)
+					return;
+
+				/* the acknowledgement may hand in the next request */
+				_free_requests.enqueue(request);
+				ack_packet(request->packet, request->success);
+			}
+		}
+
+		bool _range_valid(Block::sector_t num, Genode::size_t count)
+		{
+			if (num + count > _blk_cnt) {
+				PERR("requested block %llu-%llu out of range!", num, num + count);
+				return false;
+			}
+
+			return true;
+		}
+
+		void _submit(Block::sector_t block_number, Genode::size_t block_count,
+		             char *buffer, Block::Packet_descriptor &packet, bool write)
+		{
+			if(!_range_valid(block_number, block_count))
+				throw Io_error();
+
+			if (_free_requests.empty())
+				throw Request_congestion();
+
+			Request &request = *_free_requests.dequeue();
+			request.packet   = packet;
+			request.success  = true;
+
+			Genode::size_t const length = block_count * _blk_sz;
+			Genode::size_t const chunk_size =
+				Genode::max((Genode::size_t)MIN_CHUNK_SIZE,
+				            Genode::align_addr(length / MAX_CHUNKS + 1,
+				                               Genode::log2(_blk_sz)));
+
+			unsigned num_chunks = 0;
+			for (Genode::size_t offset = 0; offset < length;
+			     offset += chunk_size, num_chunks++) {
+
+				Chunk &chunk  = request.chunks[num_chunks];
+				chunk.owner   = this;
+				chunk.request = &request;
+				chunk.device  = _cgd_device;
+				chunk.buffer  = buffer + offset;
+				chunk.length  = Genode::min(chunk_size, length - offset);
+				chunk.offset  = block_number * _blk_sz + offset;
+				chunk.write   = write;
+			}
+
+			{
+				Genode::Lock::Guard guard(_completed_lock);
+				request.pending = num_chunks;
+				_requests_in_flight++;
+			}
 
+			for (unsigned i = 0; i < num_chunks; i++)
+				_io_pool.submit(request.chunks[i]);
+		}
 
 	public:
 
-		Driver(Server::Entrypoint &ep)
+		Driver(Server::Entrypoint &ep, Cgd::Io_pool &io_pool)
 		:
-			_blk_sz(0), _blk_cnt(0), _cgd_device(0)
+			_blk_sz(0), _blk_cnt(0), _cgd_device(0), _io_pool(io_pool),
+			_completed_dispatcher(ep, *this, &Driver::_ack_completed)
 		{
 			try {
 				_cgd_device = Cgd::init(Genode::env()->heap(), ep);
@@ -51,6 +185,9 @@ class Driver : public Block::Driver
 			_blk_cnt = _cgd_device->block_count();
 			_blk_sz  = _cgd_device->block_size();
 
+			for (unsigned i = 0; i < MAX_REQUESTS; i++)
+				_free_requests.enqueue(&_requests[i]);
+
 			/*
 			 * XXX We need write access to satisfy RUMP but we have to check
 			 * the client policy in the session interface.
@@ -61,17 +198,18 @@ class Driver : public Block::Driver
 
 		~Driver()
 		{
-			Cgd::deinit(Genode::env()->heap(), _cgd_device);
-		}
-
-		bool _range_valid(Block::sector_t num, Genode::size_t count)
-		{
-			if (num + count > _blk_cnt) {
-				PERR("requested block %llu-%llu out of range!", num, num + count);
-				return false;
+			/* wait for the completion of requests that refer to the cgd device */
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_completed_lock);
+					_closing = true;
+					if (!_requests_in_flight)
+						break;
+				}
+				_closed_sem.down();
 			}
 
-			return true;
+			Cgd::deinit(Genode::env()->heap(), _cgd_device);
 		}
 
 
@@ -91,11 +229,7 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::READ))
 				throw Io_error();
 
-			if(!_range_valid(block_number, block_count))
-				throw Io_error();
-
-			_cgd_device->read(buffer, block_count * _blk_sz, block_number * _blk_sz);
-			ack_packet(packet);
+			_submit(block_number, block_count, buffer, packet, false);
 		}
 
 		void write(Block::sector_t           block_number,
@@ -106,11 +240,8 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::WRITE))
 				throw Io_error();
 
-			if(!_range_valid(block_number, block_count))
-				throw Io_error();
-
-			_cgd_device->write(buffer, block_count * _blk_sz, block_number * _blk_sz);
-			ack_packet(packet);
+			_submit(block_number, block_count, const_cast<char *>(buffer),
+			        packet, true);
 		}
 
 		void sync() { }
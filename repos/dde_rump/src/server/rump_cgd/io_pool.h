@@ -0,0 +1,185 @@
+/*
+ * \brief  Pool of threads executing cgd requests in the rump kernel
+ * \author agent
+ * \date   2015-11-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _IO_POOL_H_
+#define _IO_POOL_H_
+
+/* Genode includes */
+#include <base/semaphore.h>
+#include <util/fifo.h>
+#include <util/hard_context.h>
+
+/* local includes */
+#include "cgd.h"
+
+
+namespace Cgd {
+	struct Io_job;
+	class  Io_pool;
+}
+
+
+/**
+ * Part of a block request to be encrypted or decrypted by the I/O pool
+ */
+struct Cgd::Io_job : Genode::Fifo<Io_job>::Element
+{
+	struct Owner
+	{
+		/**
+		 * Called in the context of an I/O thread once the job is completed
+		 */
+		virtual void completed(Io_job &, bool success) = 0;
+	};
+
+	Owner          *owner  = 0;
+	Device         *device = 0;
+	char           *buffer = 0;
+	Genode::size_t  length = 0;
+	seek_off_t      offset = 0;
+	bool            write  = false;
+};
+
+
+/**
+ * Threads that execute blocking cgd accesses on behalf of the entrypoint
+ *
+ * Each thread acts as a separate lwp of the rump kernel. While one thread
+ * waits for the backing block device, another one can encrypt or decrypt
+ * the next part of a request. A job is never started while an older job
+ * that accesses an overlapping block range of the same device is pending
+ * or executed and one of both jobs is a write.
+ */
+class Cgd::Io_pool
+{
+	private:
+
+		Genode::Lock         _lock;
+		Genode::Fifo<Io_job> _pending;  /* in submission order */
+		Genode::Fifo<Io_job> _active;   /* executed by a worker */
+		unsigned             _idle = 0; /* workers waiting for a job */
+		Genode::Semaphore    _wakeup;
+
+		struct Worker : Hard_context_thread
+		{
+			static void *_entry(void *arg)
+			{
+				Io_pool &pool = *(Io_pool *)arg;
+				for (;;)
+					pool._execute(pool._dequeue());
+				return 0;
+			}
+
+			Worker(Io_pool &pool)
+			: Hard_context_thread("rump_cgd_io", _entry, &pool, 0) { }
+		};
+
+		/**
+		 * Return true if the order of the jobs must be preserved
+		 */
+		static bool _conflict(Io_job const &a, Io_job const &b)
+		{
+			if (a.device != b.device || (!a.write && !b.write))
+				return false;
+
+			return a.offset < b.offset + (seek_off_t)b.length
+			    && b.offset < a.offset + (seek_off_t)a.length;
+		}
+
+		/**
+		 * Return true if 'job' conflicts with an active or older pending job
+		 */
+		bool _blocked(Io_job const &job) const
+		{
+			for (Io_job *j = _active.head(); j; j = j->next())
+				if (_conflict(*j, job))
+					return true;
+
+			for (Io_job *j = _pending.head(); j != &job; j = j->next())
+				if (_conflict(*j, job))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Wake up workers waiting for a job, called with '_lock' held
+		 */
+		void _wake(unsigned count)
+		{
+			for (; count && _idle; count--, _idle--)
+				_wakeup.up();
+		}
+
+		Io_job &_dequeue()
+		{
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_lock);
+
+					for (Io_job *job = _pending.head(); job; job = job->next()) {
+						if (_blocked(*job))
+							continue;
+
+						_pending.remove(job);
+						_active.enqueue(job);
+						return *job;
+					}
+					_idle++;
+				}
+				_wakeup.down();
+			}
+		}
+
+		void _execute(Io_job &job)
+		{
+			Genode::size_t const n = job.write
+				? job.device->write(job.buffer, job.length, job.offset)
+				: job.device->read (job.buffer, job.length, job.offset);
+
+			/* jobs that waited for this one may proceed now */
+			{
+				Genode::Lock::Guard guard(_lock);
+				_active.remove(&job);
+				_wake(~0U);
+			}
+
+			job.owner->completed(job, n == job.length);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc        allocator used for the worker threads
+		 * \param num_threads  number of concurrently executed jobs
+		 */
+		Io_pool(Genode::Allocator &alloc, unsigned num_threads)
+		{
+			for (unsigned i = 0; i < num_threads; i++)
+				new (&alloc) Worker(*this);
+		}
+
+		/**
+		 * Schedule job for execution
+		 */
+		void submit(Io_job &job)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_pending.enqueue(&job);
+			_wake(1);
+		}
+};
+
+#endif /* _IO_POOL_H_ */
@@ -13,6 +13,7 @@
 
 /* Genode includes */
 #include <base/env.h>
+#include <os/config.h>
 #include <os/server.h>
 
 /* local includes */
@@ -20,19 +21,32 @@
 #include "cgd.h"
 
 
+static unsigned io_threads()
+{
+	unsigned num = 4;
+	try { Genode::config()->xml_node().attribute("io_threads").value(&num); }
+	catch (...) { }
+	return Genode::max(num, 1U);
+}
+
+
 struct Main
 {
 	Server::Entrypoint &ep;
 
+	Cgd::Io_pool io_pool { *Genode::env()->heap(), io_threads() };
+
 	struct Factory : Block::Driver_factory
 	{
 		Server::Entrypoint &ep;
+		Cgd::Io_pool       &io_pool;
 
-		Factory(Server::Entrypoint &ep) : ep(ep) { }
+		Factory(Server::Entrypoint &ep, Cgd::Io_pool &io_pool)
+		: ep(ep), io_pool(io_pool) { }
 
 		Block::Driver *create()
 		{
-			return new (Genode::env()->heap()) Driver(ep);
+			return new (Genode::env()->heap()) Driver(ep, io_pool);
 		}
 
 		void destroy(Block::Driver *driver)
@@ -46,7 +60,7 @@ struct Main
 
 	Main(Server::Entrypoint &ep)
 	:
-		ep(ep), factory(ep), root(ep, Genode::env()->heap(), factory)
+		ep(ep), factory(ep, io_pool), root(ep, Genode::env()->heap(), factory)
 	{
 		Genode::env()->parent()->announce(ep.manage(root));
 	}
@@ -0,0 +1,230 @@
+/*
+ * \brief  Pool of threads executing file operations in the rump kernel
+ * \author agent
+ * \date   2015-11-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _IO_POOL_H_
+#define _IO_POOL_H_
+
+/* Genode includes */
+#include <base/semaphore.h>
+#include <util/fifo.h>
+#include <util/hard_context.h>
+
+/* local includes */
+#include "file.h"
+
+
+namespace File_system {
+	struct Io_job;
+	class  Io_pool;
+}
+
+
+/**
+ * Packet operation on a file to be executed by the I/O pool
+ */
+struct File_system::Io_job : Genode::Fifo<Io_job>::Element
+{
+	struct Owner
+	{
+		/**
+		 * Called in the context of an I/O thread once the job is completed
+		 */
+		virtual void completed(Io_job &) = 0;
+	};
+
+	Owner             *owner     = 0;
+	File              *file      = 0;
+	char              *content   = 0;
+	bool               in_flight = false;
+	Packet_descriptor  packet;
+};
+
+
+/**
+ * Threads that execute blocking rump-kernel calls on behalf of the entrypoint
+ *
+ * Each thread acts as a separate lwp of the rump kernel. While one thread
+ * waits for the block device, the others can proceed. Reads are executed
+ * before pending writes because clients usually wait for their results
+ * whereas writes are mostly background write-back. A job is never started
+ * while an older job that accesses an overlapping range of the same file
+ * is pending or executed and one of both jobs is a write. Hence, reads
+ * bypass only writes to other ranges, and the order of overlapping
+ * operations is preserved.
+ */
+class File_system::Io_pool
+{
+	private:
+
+		Genode::Lock         _lock;
+		Genode::Fifo<Io_job> _pending;  /* in submission order */
+		Genode::Fifo<Io_job> _active;   /* executed by a worker */
+		unsigned             _idle = 0; /* workers waiting for a job */
+		Genode::Semaphore    _wakeup;
+
+		struct Worker : Hard_context_thread
+		{
+			static void *_entry(void *arg)
+			{
+				Io_pool &pool = *(Io_pool *)arg;
+				for (;;)
+					pool._execute(pool._dequeue());
+				return 0;
+			}
+
+			Worker(Io_pool &pool)
+			: Hard_context_thread("rump_fs_io", _entry, &pool, 0) { }
+		};
+
+		static bool _write(Io_job const &job) {
+			return job.packet.operation() == Packet_descriptor::WRITE; }
+
+		/**
+		 * Return true if the order of the jobs must be preserved
+		 */
+		static bool _conflict(Io_job const &a, Io_job const &b)
+		{
+			if (a.file != b.file || (!_write(a) && !_write(b)))
+				return false;
+
+			seek_off_t const a_end = a.packet.position() + a.packet.length();
+			seek_off_t const b_end = b.packet.position() + b.packet.length();
+
+			return a.packet.position() < b_end && b.packet.position() < a_end;
+		}
+
+		/**
+		 * Return true if 'job' conflicts with an active or older pending job
+		 */
+		bool _blocked(Io_job const &job) const
+		{
+			for (Io_job *j = _active.head(); j; j = j->next())
+				if (_conflict(*j, job))
+					return true;
+
+			for (Io_job *j = _pending.head(); j != &job; j = j->next())
+				if (_conflict(*j, job))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Select the next job to execute, preferring reads
+		 */
+		Io_job *_select() const
+		{
+			Io_job *first = 0;
+			for (Io_job *j = _pending.head(); j; j = j->next()) {
+
+				if (_blocked(*j))
+					continue;
+
+				if (!_write(*j))
+					return j;
+
+				if (!first)
+					first = j;
+			}
+			return first;
+		}
+
+		/**
+		 * Wake up workers waiting for a job, called with '_lock' held
+		 */
+		void _wake(unsigned count)
+		{
+			for (; count && _idle; count--, _idle--)
+				_wakeup.up();
+		}
+
+		Io_job &_dequeue()
+		{
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_lock);
+
+					if (Io_job *job = _select()) {
+						_pending.remove(job);
+						_active.enqueue(job);
+						return *job;
+					}
+					_idle++;
+				}
+				_wakeup.down();
+			}
+		}
+
+		void _execute(Io_job &job)
+		{
+			Packet_descriptor &packet = job.packet;
+
+			size_t const     length = packet.length();
+			seek_off_t const offset = packet.position();
+
+			/* resulting length */
+			size_t res_length = 0;
+
+			switch (packet.operation()) {
+
+			case Packet_descriptor::READ:
+				res_length = job.file->read(job.content, length, offset);
+				break;
+
+			case Packet_descriptor::WRITE:
+				res_length = job.file->write(job.content, length, offset);
+				break;
+
+			default:
+				break;
+			}
+
+			/* jobs that waited for this one may proceed now */
+			{
+				Genode::Lock::Guard guard(_lock);
+				_active.remove(&job);
+				_wake(~0U);
+			}
+
+			packet.length(res_length);
+			packet.succeeded(res_length > 0);
+
+			job.owner->completed(job);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc        allocator used for the worker threads
+		 * \param num_threads  number of concurrently executed jobs
+		 */
+		Io_pool(Allocator &alloc, unsigned num_threads)
+		{
+			for (unsigned i = 0; i < num_threads; i++)
+				new (&alloc) Worker(*this);
+		}
+
+		/**
+		 * Schedule job for execution
+		 */
+		void submit(Io_job &job)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_pending.enqueue(&job);
+			_wake(1);
+		}
+};
+
+#endif /* _IO_POOL_H_ */
@@ -18,12 +18,14 @@
 #include "undef.h"
 
 #include <file_system_session/rpc_object.h>
+#include <os/config.h>
 #include <os/server.h>
 #include <os/session_policy.h>
 #include <root/component.h>
 #include  <rump_fs/fs.h>
 #include "file_system.h"
 #include "directory.h"
+#include "io_pool.h"
 
 namespace File_system {
 	struct Main;
@@ -31,7 +33,8 @@ namespace File_system {
 	struct Session_component;
 }
 
-class File_system::Session_component : public Session_rpc_object
+class File_system::Session_component : public Session_rpc_object,
+                                       private Io_job::Owner
 {
 	private:
 
@@ -39,9 +42,124 @@ class File_system::Session_component : public Session_rpc_object
 		Directory            &_root;
 		Node_handle_registry  _handle_registry;
 		bool                  _writable;
+		Io_pool              &_io_pool;
 
 		Signal_rpc_member<Session_component> _process_packet_dispatcher;
 
+		/*
+		 * Jobs for file operations executed by the I/O pool, at most one
+		 * job per packet that fits into the submit queue
+		 */
+		enum { MAX_JOBS = TX_QUEUE_SIZE };
+
+		Io_job       _jobs[MAX_JOBS];
+		Fifo<Io_job> _free_jobs;      /* accessed by the entrypoint only */
+
+		Lock         _completed_lock;
+		Fifo<Io_job> _completed_jobs;
+		unsigned     _jobs_in_flight = 0;
+		bool         _draining       = false;
+		bool         _closing        = false;
+		Semaphore    _drained_sem;
+
+		/**
+		 * Io_job::Owner interface, called by an I/O thread
+		 */
+		void completed(Io_job &job) override
+		{
+			Lock::Guard guard(_completed_lock);
+
+			_completed_jobs.enqueue(&job);
+			job.in_flight = false;
+			_jobs_in_flight--;
+
+			if (_draining)
+				_drained_sem.up();
+
+			if (_closing)
+				return;
+
+			/*
+			 * Submit the signal while holding the lock to prevent the
+			 * destruction of the session in the meanwhile.
+			 */
+			Signal_transmitter(_process_packet_dispatcher).submit();
+		}
+
+		/**
+		 * Wait until no job in flight refers to 'file', or to any file if
+		 * 'file' is 0
+		 */
+		void _drain_jobs(File const *file)
+		{
+			for (;;) {
+				{
+					Lock::Guard guard(_completed_lock);
+
+					bool busy = false;
+					for (unsigned i = 0; i < MAX_JOBS && !busy; i++)
+						busy = _jobs[i].in_flight
+						    && (!file || _jobs[i].file == file);
+
+					_draining = busy;
+					if (!busy)
+						break;
+				}
+				_drained_sem.down();
+			}
+		}
+
+		/**
+		 * Acknowledge packets of completed jobs
+		 */
+		void _ack_completed_jobs()
+		{
+			while (tx_sink()->ready_to_ack()) {
+
+				Io_job *job = 0;
+				{
+					Lock::Guard guard(_completed_lock);
+					job = _completed_jobs.dequeue();
+				}
+				if (!job)
+					return;
+
+				tx_sink()->acknowledge_packet(job->packet);
+				_free_jobs.enqueue(job);
+			}
+		}
+
+		/**
+		 * Hand out file read or write operation to the I/O pool
+		 *
+		 * \return false if the packet must be processed synchronously
+		 */
+		bool _submit_job(Packet_descriptor const &packet, Node &node)
+		{
+			File *file = dynamic_cast<File *>(&node);
+			if (!file)
+				return false;
+
+			void * const content = tx_sink()->packet_content(packet);
+			if (!content || (packet.length() > packet.size()))
+				return false;
+
+			Io_job &job = *_free_jobs.dequeue();
+			job.owner   = this;
+			job.file    = file;
+			job.content = (char *)content;
+			job.packet  = packet;
+
+			{
+				Lock::Guard guard(_completed_lock);
+				job.in_flight = true;
+				_jobs_in_flight++;
+			}
+
+			_io_pool.submit(job);
+			return true;
+		}
+
 
 		/******************************
 		 ** Packet-stream processing **
@@ -75,6 +193,9 @@ class File_system::Session_component : public Session_rpc_object
 			case Packet_descriptor::WRITE:
 				res_length = node.write((char const *)content, length, offset);
 				break;
+
+			default:
+				break;
 			}
 
 			packet.length(res_length);
@@ -91,6 +212,13 @@ class File_system::Session_component : public Session_rpc_object
 			try {
 				Node *node = _handle_registry.lookup(packet.handle());
 
+				/*
+				 * File operations are executed asynchronously and
+				 * acknowledged in the order of their completion.
+				 */
+				if (_submit_job(packet, *node))
+					return;
+
 				_process_packet_op(packet, *node);
 			}
 			catch (Invalid_handle)     { PERR("Invalid_handle");     }
@@ -109,6 +237,8 @@ class File_system::Session_component : public Session_rpc_object
 		 */
 		void _process_packets(unsigned)
 		{
+			_ack_completed_jobs();
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -126,6 +256,14 @@ class File_system::Session_component : public Session_rpc_object
 				if (!tx_sink()->ready_to_ack())
 					return;
 
+				/*
+				 * Defer packet processing until a job completed if all
+				 * jobs are in use. A file operation executed synchronously
+				 * could overtake older jobs of the I/O pool.
+				 */
+				if (_free_jobs.empty())
+					return;
+
 				_process_packet();
 			}
 		}
@@ -150,14 +288,19 @@ class File_system::Session_component : public Session_rpc_object
 		                  Server::Entrypoint &ep,
 		                  char const         *root_dir,
 		                  bool                writeable,
-		                  Allocator          &md_alloc)
+		                  Allocator          &md_alloc,
+		                  Io_pool            &io_pool)
 		:
 			Session_rpc_object(env()->ram_session()->alloc(tx_buf_size), ep.rpc_ep()),
 			_md_alloc(md_alloc),
 			_root(*new (&_md_alloc) Directory(_md_alloc, root_dir, false)),
 			_writable(writeable),
+			_io_pool(io_pool),
 			_process_packet_dispatcher(ep, *this, &Session_component::_process_packets)
 		{
+			for (unsigned i = 0; i < MAX_JOBS; i++)
+				_free_jobs.enqueue(&_jobs[i]);
+
 			/*
 			 * Register '_process_packets' dispatch function as signal
 			 * handler for packet-avail and ready-to-ack signals.
@@ -171,6 +314,13 @@ class File_system::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			/* wait for the completion of jobs that refer to the packet buffer */
+			{
+				Lock::Guard guard(_completed_lock);
+				_closing = true;
+			}
+			_drain_jobs(0);
+
 			Dataspace_capability ds = tx_sink()->dataspace();
 			env()->ram_session()->free(static_cap_cast<Ram_dataspace>(ds));
 			destroy(&_md_alloc, &_root);
@@ -248,6 +398,9 @@ class File_system::Session_component : public Session_rpc_object
 				node = _handle_registry.lookup(handle);
 			} catch (Invalid_handle)  { return; }
 
+			/* the node must not vanish while the I/O pool operates on it */
+			_drain_jobs(dynamic_cast<File *>(node));
+
 			_handle_registry.free(handle);
 			/* destruct node */
 			if (node)
@@ -363,6 +516,7 @@ class File_system::Root : public Root_component<Session_component>
 	private:
 
 		Server::Entrypoint &_ep;
+		Io_pool            &_io_pool;
 
 	protected:
 
@@ -441,7 +595,8 @@ class File_system::Root : public Root_component<Session_component>
 				throw Root::Quota_exceeded();
 			}
 			return new (md_alloc())
-				Session_component(tx_buf_size, _ep, root_dir, writeable, *md_alloc());
+				Session_component(tx_buf_size, _ep, root_dir, writeable,
+				                  *md_alloc(), _io_pool);
 		}
 
 	public:
@@ -453,11 +608,12 @@ class File_system::Root : public Root_component<Session_component>
 		 * \param sig_rec     signal receiver used for handling the
 		 *                    data-flow signals of packet streams
 		 * \param md_alloc    meta-data allocator
+		 * \param io_pool     threads executing file operations
 		 */
-		Root(Server::Entrypoint &ep, Allocator &md_alloc)
+		Root(Server::Entrypoint &ep, Allocator &md_alloc, Io_pool &io_pool)
 		:
 			Root_component<Session_component>(&ep.rpc_ep(), &md_alloc),
-			_ep(ep)
+			_ep(ep), _io_pool(io_pool)
 		{ }
 };
 
@@ -472,7 +628,23 @@ struct File_system::Main
 	 */
 	Sliced_heap sliced_heap = { env()->ram_session(), env()->rm_session() };
 
-	Root fs_root = { ep, sliced_heap };
+	/*
+	 * Number of threads executing rump-kernel file operations concurrently
+	 */
+	static unsigned _num_io_threads()
+	{
+		enum { DEFAULT_IO_THREADS = 4 };
+
+		unsigned num = DEFAULT_IO_THREADS;
+		try { config()->xml_node().attribute("io_threads").value(&num); }
+		catch (...) { }
+
+		return max(num, 1U);
+	}
+
+	Io_pool io_pool = { *env()->heap(), _num_io_threads() };
+
+	Root fs_root = { ep, sliced_heap, io_pool };
 
 
 	/* return immediately from resource requests */
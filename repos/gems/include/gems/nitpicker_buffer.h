@@ -110,6 +110,24 @@ struct Nitpicker_buffer
 		return Alpha_surface(alpha_surface_ds.local_addr<Pixel_alpha8>(), size());
 	}
 
+	/**
+	 * Clear back buffer within 'rect'
+	 */
+	void reset_surface(Rect rect)
+	{
+		rect = Rect::intersect(rect, Rect(Genode::Surface_base::Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
+		Pixel_rgb888 *pixel = pixel_surface().addr() + rect.y1()*size().w() + rect.x1();
+		Pixel_alpha8 *alpha = alpha_surface().addr() + rect.y1()*size().w() + rect.x1();
+
+		for (unsigned y = 0; y < rect.h(); y++) {
+			Genode::memset(pixel + y*size().w(), 0, rect.w()*sizeof(Pixel_rgb888));
+			Genode::memset(alpha + y*size().w(), 0, rect.w());
+		}
+	}
+
 	void reset_surface()
 	{
 		Genode::size_t const num_pixels = pixel_surface().size().count();
@@ -129,18 +147,16 @@ struct Nitpicker_buffer
 		Dither_painter::paint(surface, texture);
 	}
 
-	void _update_input_mask()
+	void _update_input_mask(Rect const rect)
 	{
 		unsigned const num_pixels = size().count();
+		unsigned const offset     = rect.y1()*size().w() + rect.x1();
 
 		unsigned char * const alpha_base = fb_ds.local_addr<unsigned char>()
 		                                 + mode.bytes_per_pixel()*num_pixels;
 
 		unsigned char * const input_base = alpha_base + num_pixels;
 
-		unsigned char const *src = alpha_base;
-		unsigned char       *dst = input_base;
-
 		/*
 		 * Set input mask for all pixels where the alpha value is above a
 		 * given threshold. The threshold is defines such that typical
@@ -148,29 +164,44 @@ struct Nitpicker_buffer
 		 */
 		unsigned char const threshold = 100;
 
-		for (unsigned i = 0; i < num_pixels; i++)
-			*dst++ = (*src++) > threshold;
+		for (unsigned y = 0; y < rect.h(); y++) {
+
+			unsigned char const *src = alpha_base + offset + y*size().w();
+			unsigned char       *dst = input_base + offset + y*size().w();
+
+			for (unsigned x = 0; x < rect.w(); x++)
+				*dst++ = (*src++) > threshold;
+		}
 	}
 
-	void flush_surface()
+	/**
+	 * Transfer the back buffer within 'rect' to the virtual framebuffer
+	 */
+	void flush_surface(Rect rect)
 	{
+		rect = Rect::intersect(rect, Rect(Genode::Surface_base::Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
 		/* represent back buffer as texture */
 		Genode::Texture<Pixel_rgb888>
 			texture(pixel_surface_ds.local_addr<Pixel_rgb888>(),
 			        alpha_surface_ds.local_addr<unsigned char>(),
 			        size());
 
-		// XXX track dirty rectangles
-		Rect const clip_rect(Genode::Surface_base::Point(0, 0), size());
-
 		Pixel_rgb565 *pixel_base = fb_ds.local_addr<Pixel_rgb565>();
 		Pixel_alpha8 *alpha_base = fb_ds.local_addr<Pixel_alpha8>()
 		                         + mode.bytes_per_pixel()*size().count();
 
-		_convert_back_to_front(pixel_base, texture, clip_rect);
-		_convert_back_to_front(alpha_base, texture, clip_rect);
+		_convert_back_to_front(pixel_base, texture, rect);
+		_convert_back_to_front(alpha_base, texture, rect);
+
+		_update_input_mask(rect);
+	}
 
-		_update_input_mask();
+	void flush_surface()
+	{
+		flush_surface(Rect(Genode::Surface_base::Point(0, 0), size()));
 	}
 };
 
@@ -0,0 +1,194 @@
+/*
+ * \brief  Distribution of the rendering of a frame to multiple threads
+ * \author agent
+ * \date   2015-11-30
+ *
+ * The surface is partitioned into horizontal bands, one band per thread.
+ * Each band is cleared and rendered with the surfaces clipped to the band.
+ * The polygon painters clip each polygon against the clipping rectangle of
+ * the surface and access their edge buffers only at the rows covered by
+ * the clipped polygon. Hence, a painter can be used by several threads at
+ * the same time as long as each thread paints a distinct band.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__NANO3D__PARALLEL_RENDERER_H_
+#define _INCLUDE__NANO3D__PARALLEL_RENDERER_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <os/surface.h>
+#include <os/pixel_alpha8.h>
+
+namespace Nano3d { template <typename> class Parallel_renderer; }
+
+
+template <typename PT>
+class Nano3d::Parallel_renderer
+{
+	public:
+
+		typedef Genode::Surface<PT>                   Pixel_surface;
+		typedef Genode::Surface<Genode::Pixel_alpha8> Alpha_surface;
+
+		struct Band_renderer
+		{
+			/**
+			 * Render the part of the scene within the clipping rectangle
+			 *
+			 * This method may be called by several threads concurrently,
+			 * each thread with a distinct clipping rectangle.
+			 */
+			virtual void render_band(Pixel_surface &, Alpha_surface &) = 0;
+		};
+
+	private:
+
+		typedef Genode::Surface_base::Rect  Rect;
+		typedef Genode::Surface_base::Point Point;
+
+		enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+		/*
+		 * Job of the current frame
+		 */
+		PT                   *_pixel_base = nullptr;
+		Genode::Pixel_alpha8 *_alpha_base = nullptr;
+		Genode::Surface_base::Area _size;
+		Band_renderer        *_band_renderer = nullptr;
+
+		unsigned const _num_bands;
+
+		Genode::Semaphore _done;
+
+		template <typename T>
+		static void _clear(T *base, unsigned w, Rect band)
+		{
+			Genode::size_t const num_bytes = band.h()*w*sizeof(T);
+			char * const         start     = (char *)(base + band.y1()*w);
+
+			/* clear word-wise, the bands are not necessarily word-aligned */
+			Genode::size_t i = 0;
+			for (; i < num_bytes && ((Genode::addr_t)(start + i) % sizeof(long)); i++)
+				start[i] = 0;
+			for (; i + sizeof(long) <= num_bytes; i += sizeof(long))
+				*(long *)(start + i) = 0;
+			for (; i < num_bytes; i++)
+				start[i] = 0;
+		}
+
+		Rect _band(unsigned i) const
+		{
+			int const y1 = (_size.h()*i)/_num_bands;
+			int const y2 = (_size.h()*(i + 1))/_num_bands - 1;
+
+			return Rect(Point(0, y1), Point(_size.w() - 1, y2));
+		}
+
+		void _render_band(unsigned i)
+		{
+			Rect const band = _band(i);
+			if (!band.valid())
+				return;
+
+			_clear(_pixel_base, _size.w(), band);
+			_clear(_alpha_base, _size.w(), band);
+
+			Pixel_surface pixel(_pixel_base, _size);
+			Alpha_surface alpha(_alpha_base, _size);
+
+			pixel.clip(band);
+			alpha.clip(band);
+
+			_band_renderer->render_band(pixel, alpha);
+		}
+
+		struct Worker : Genode::Thread<STACK_SIZE>
+		{
+			Parallel_renderer &renderer;
+			unsigned const     band;
+			Genode::Semaphore  start_sem;
+
+			Worker(Parallel_renderer &renderer, unsigned band,
+			       Genode::Affinity::Location location)
+			:
+				Genode::Thread<STACK_SIZE>("nano3d_render"),
+				renderer(renderer), band(band)
+			{
+				Genode::env()->cpu_session()->affinity(this->cap(), location);
+				this->start();
+			}
+
+			void entry() override
+			{
+				for (;;) {
+					start_sem.down();
+					renderer._render_band(band);
+					renderer._done.up();
+				}
+			}
+		};
+
+		/* the first band is rendered by the caller of 'render' */
+		Worker **_workers = nullptr;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_threads  number of threads rendering the frame, the
+		 *                     threads are distributed over the available
+		 *                     CPUs
+		 */
+		Parallel_renderer(unsigned num_threads)
+		:
+			_num_bands(Genode::max(num_threads, 1U))
+		{
+			if (_num_bands == 1)
+				return;
+
+			Genode::Affinity::Space space =
+				Genode::env()->cpu_session()->affinity_space();
+
+			_workers = new (Genode::env()->heap()) Worker*[_num_bands];
+			for (unsigned i = 1; i < _num_bands; i++)
+				_workers[i] = new (Genode::env()->heap())
+					Worker(*this, i, space.location_of_index(i));
+		}
+
+		unsigned num_threads() const { return _num_bands; }
+
+		/**
+		 * Clear surfaces and render frame
+		 *
+		 * The method returns after all bands are rendered. The pixel and
+		 * alpha surfaces must have the same size.
+		 */
+		void render(Pixel_surface &pixel, Alpha_surface &alpha,
+		            Band_renderer &band_renderer)
+		{
+			_pixel_base    = pixel.addr();
+			_alpha_base    = alpha.addr();
+			_size          = pixel.size();
+			_band_renderer = &band_renderer;
+
+			for (unsigned i = 1; i < _num_bands; i++)
+				_workers[i]->start_sem.up();
+
+			_render_band(0);
+
+			for (unsigned i = 1; i < _num_bands; i++)
+				_done.down();
+		}
+};
+
+#endif /* _INCLUDE__NANO3D__PARALLEL_RENDERER_H_ */
@@ -6,7 +6,8 @@
  * The 'Scene' class template contains the code for setting up a nitpicker
  * view with a triple-buffer for rendering tearing-free animations.
  * A derrived class implements the to-be-displayed content in the virtual
- * 'render' method.
+ * 'render' method. The rendering of a frame can be distributed to
+ * multiple threads, each rendering a horizontal band of the surface.
  */
 
 /*
@@ -27,6 +28,9 @@
 #include <os/attached_dataspace.h>
 #include <input/event.h>
 
+/* gems includes */
+#include <nano3d/parallel_renderer.h>
+
 namespace Nano3d {
 
 	struct Input_handler;
@@ -41,7 +45,7 @@ struct Nano3d::Input_handler
 
 
 template <typename PT>
-class Nano3d::Scene
+class Nano3d::Scene : private Parallel_renderer<PT>::Band_renderer
 {
 	public:
 
@@ -49,6 +53,14 @@ class Nano3d::Scene
 
 		typedef Genode::Pixel_alpha8 Pixel_alpha8;
 
+		/**
+		 * Render scene
+		 *
+		 * If the scene is rendered by more than one thread, this method is
+		 * called concurrently for distinct bands of the surfaces. The
+		 * painting must then be restricted to the clipping rectangle of
+		 * the surfaces.
+		 */
 		virtual void render(Genode::Surface<PT>           &pixel_surface,
 		                    Genode::Surface<Pixel_alpha8> &alpha_surface) = 0;
 
@@ -157,20 +169,6 @@ class Nano3d::Scene
 			{ }
 
 			Genode::Surface_base::Area size() const { return pixel.size(); }
-
-			template <typename T>
-			void _clear(Genode::Surface<T> &surface)
-			{
-				Genode::size_t n = (surface.size().count()*sizeof(T))/sizeof(long);
-				for (long *dst = (long *)surface.addr(); n--; dst++)
-					*dst = 0;
-			}
-
-			void clear()
-			{
-				_clear(pixel);
-				_clear(alpha);
-			}
 		};
 
 		Surface _surface_0 { _framebuffer.pixel_base(0), _framebuffer.alpha_base(0),
@@ -188,6 +186,17 @@ class Nano3d::Scene
 
 		Timer::Connection _timer;
 
+		Parallel_renderer<PT> _renderer;
+
+		/* time of the frame currently being rendered */
+		unsigned long _frame_ms = 0;
+
+		void render_band(Genode::Surface<PT>           &pixel,
+		                 Genode::Surface<Pixel_alpha8> &alpha) override
+		{
+			render(pixel, alpha);
+		}
+
 		Genode::Attached_dataspace _input_ds { _nitpicker.input()->dataspace() };
 
 		Input_handler *_input_handler = nullptr;
@@ -228,9 +237,9 @@ class Nano3d::Scene
 			if (_do_sync)
 				return;
 
-			_surface_back->clear();
+			_frame_ms = _timer.elapsed_ms();
 
-			render(_surface_back->pixel, _surface_back->alpha);
+			_renderer.render(_surface_back->pixel, _surface_back->alpha, *this);
 
 			_swap_back_and_front_surfaces();
 
@@ -270,10 +279,16 @@ class Nano3d::Scene
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param num_threads  number of threads used for rendering a frame
+		 */
 		Scene(Genode::Signal_receiver &sig_rec, unsigned update_rate_ms,
-		      Nitpicker::Point pos, Nitpicker::Area size)
+		      Nitpicker::Point pos, Nitpicker::Area size,
+		      unsigned num_threads = 1)
 		:
-			_sig_rec(sig_rec), _pos(pos), _size(size)
+			_sig_rec(sig_rec), _pos(pos), _size(size), _renderer(num_threads)
 		{
 			Nitpicker::Rect rect(_pos, _size);
 			_nitpicker.enqueue<Command::Geometry>(_view_handle, rect);
@@ -303,6 +318,14 @@ class Nano3d::Scene
 
 		unsigned long elapsed_ms() const { return _timer.elapsed_ms(); }
 
+		/**
+		 * Return time of the frame currently being rendered
+		 *
+		 * In contrast to 'elapsed_ms', the value is the same for all bands
+		 * of a frame.
+		 */
+		unsigned long frame_ms() const { return _frame_ms; }
+
 		void input_handler(Input_handler *input_handler)
 		{
 			_framebuffer.input_mask(input_handler ? true : false);
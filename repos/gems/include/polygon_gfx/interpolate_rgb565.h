@@ -41,35 +41,27 @@ inline void Polygon::interpolate_rgba(Color start, Color end, Pixel_rgb565 *dst,
 	if (num_values <= 0) return;
 
 	/* use 16.16 fixpoint values for the calculation */
-	int r_ascent = ((end.r - start.r)<<16) / (int)num_values,
-	    g_ascent = ((end.g - start.g)<<16) / (int)num_values,
-	    b_ascent = ((end.b - start.b)<<16) / (int)num_values,
-	    a_ascent = ((end.a - start.a)<<16) / (int)num_values;
-
-	/* set start values for color components */
-	int r = start.r<<16,
-	    g = start.g<<16,
-	    b = start.b<<16,
-	    a = start.a<<16;
+	Color_fix16 ascent, curr;
+	color_ascent_fix16(ascent, start, end, num_values);
+	color_fix16(curr, start);
 
 	for ( ; num_values--; dst++, dst_alpha++, x++) {
 
 		int const dither_value = Genode::Dither_matrix::value(x, y) << 12;
 
+		Color_fix16 const dither = { dither_value, dither_value,
+		                             dither_value, dither_value };
+
+		Color_fix16 const dithered = curr + dither;
+		Color_fix16 const c        = dithered >> 16;
+
 		/* combine current color value with existing pixel via alpha blending */
-		*dst = Pixel_rgb565::mix(*dst,
-		                         Pixel_rgb565((r + dither_value) >> 16,
-		                                      (g + dither_value) >> 16,
-		                                      (b + dither_value) >> 16),
-		                         (a + dither_value) >> 16);
+		*dst = Pixel_rgb565::mix(*dst, Pixel_rgb565(c[0], c[1], c[2]), c[3]);
 
-		*dst_alpha += ((255 - *dst_alpha)*(a + dither_value)) >> (16 + 8);
+		*dst_alpha += ((255 - *dst_alpha)*dithered[3]) >> (16 + 8);
 
 		/* increment color-component values by ascent */
-		r += r_ascent;
-		g += g_ascent;
-		b += b_ascent;
-		a += a_ascent;
+		curr += ascent;
 	}
 }
 
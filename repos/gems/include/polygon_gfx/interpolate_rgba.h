@@ -21,6 +21,41 @@ namespace Polygon {
 
 	using Genode::Color;
 
+	/**
+	 * Color components as 16.16 fixpoint values
+	 *
+	 * The vector type lets the compiler process all four components at once
+	 * using SIMD instructions (e.g., SSE2 or NEON) where available.
+	 */
+	typedef int Color_fix16 __attribute__((vector_size(4*sizeof(int))));
+
+	/*
+	 * The vector values are returned via out parameters because returning
+	 * them by value changes the ABI on targets without SSE (-Wpsabi).
+	 */
+
+	static inline void color_fix16(Color_fix16 &result, Color color)
+	{
+		Color_fix16 const c = { color.r, color.g, color.b, color.a };
+		result = c << 16;
+	}
+
+	/**
+	 * Calculate ascent of color components along a span of 'num_values'
+	 */
+	static inline void color_ascent_fix16(Color_fix16 &result, Color start,
+	                                      Color end, unsigned num_values)
+	{
+		Color_fix16 const n = { (int)num_values, (int)num_values,
+		                        (int)num_values, (int)num_values };
+
+		Color_fix16 s, e;
+		color_fix16(s, start);
+		color_fix16(e, end);
+
+		result = (e - s) / n;
+	}
+
 	template <typename PT>
 	static inline void interpolate_rgba(Color, Color, PT *, unsigned char *,
 	                                    unsigned, int, int);
@@ -42,28 +77,20 @@ static inline void Polygon::interpolate_rgba(Polygon::Color start,
 	if (num_values == 0) return;
 
 	/* use 16.16 fixpoint values for the calculation */
-	int const r_ascent = ((end.r - start.r)<<16) / (int)num_values,
-	          g_ascent = ((end.g - start.g)<<16) / (int)num_values,
-	          b_ascent = ((end.b - start.b)<<16) / (int)num_values,
-	          a_ascent = ((end.a - start.a)<<16) / (int)num_values;
-
-	/* set start values for color components */
-	int r = start.r<<16,
-	    g = start.g<<16,
-	    b = start.b<<16,
-	    a = start.a<<16;
+	Color_fix16 ascent, curr;
+	color_ascent_fix16(ascent, start, end, num_values);
+	color_fix16(curr, start);
 
 	for ( ; num_values--; dst++, dst_alpha++) {
 
+		Color_fix16 const c = curr >> 16;
+
 		/* combine current color value with existing pixel via alpha blending */
-		*dst        = PT::mix(*dst, PT(r>>16, g>>16, b>>16), a>>16);
-		*dst_alpha += ((255 - *dst_alpha)*a) >> (16 + 8);
+		*dst        = PT::mix(*dst, PT(c[0], c[1], c[2]), c[3]);
+		*dst_alpha += ((255 - *dst_alpha)*curr[3]) >> (16 + 8);
 
 		/* increment color-component values by ascent */
-		r += r_ascent;
-		g += g_ascent;
-		b += b_ascent;
-		a += a_ascent;
+		curr += ascent;
 	}
 }
 
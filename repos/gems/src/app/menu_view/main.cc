@@ -63,7 +63,9 @@ struct Menu_view::Main
 
 	Animator animator;
 
-	Widget_factory widget_factory { *env()->heap(), styles, animator };
+	Damage damage;
+
+	Widget_factory widget_factory { *env()->heap(), styles, animator, damage };
 
 	Root_widget root_widget { widget_factory, Xml_node("<dialog/>"), Widget::Unique_id() };
 
@@ -254,23 +256,42 @@ void Menu_view::Main::handle_frame_timer(unsigned)
 		Area const old_size = buffer.is_constructed() ? buffer->size() : Area();
 		Area const size     = root_widget.min_size();
 
-		if (!buffer.is_constructed() || size != old_size)
+		bool const size_changed = !buffer.is_constructed() || size != old_size;
+
+		if (size_changed)
 			buffer.construct(nitpicker, size, *env()->ram_session());
-		else
-			buffer->reset_surface();
 
 		root_widget.size(size);
 		root_widget.position(Point(0, 0));
 
-		Surface<Pixel_rgb888> pixel_surface = buffer->pixel_surface();
-		Surface<Pixel_alpha8> alpha_surface = buffer->alpha_surface();
+		/* determine the parts of the dialog that changed since the last redraw */
+		root_widget.collect_damage(damage, Point(0, 0));
+
+		Rect const buffer_rect(Point(0, 0), size);
+
+		if (size_changed)
+			damage.mark_as_dirty(buffer_rect);
+
+		damage.flush([&] (Rect const &dirty) {
+
+			Rect const rect = Rect::intersect(dirty, buffer_rect);
+			if (!rect.valid())
+				return;
+
+			buffer->reset_surface(rect);
+
+			Surface<Pixel_rgb888> pixel_surface = buffer->pixel_surface();
+			Surface<Pixel_alpha8> alpha_surface = buffer->alpha_surface();
+
+			pixel_surface.clip(rect);
+			alpha_surface.clip(rect);
+
+			root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
 
-		// XXX restrict redraw to dirty regions
-		//     don't perform a full dialog update
-		root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
+			buffer->flush_surface(rect);
+			nitpicker.framebuffer()->refresh(rect.x1(), rect.y1(), rect.w(), rect.h());
+		});
 
-		buffer->flush_surface();
-		nitpicker.framebuffer()->refresh(0, 0, buffer->size().w(), buffer->size().h());
 		_update_view();
 
 		schedule_redraw = false;
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <util/xml_generator.h>
+#include <util/dirty_rect.h>
 #include <timer_session/connection.h>
 
 /* demo includes */
@@ -42,6 +43,11 @@ namespace Menu_view {
 	struct Main;
 
 	typedef Margin Padding;
+
+	/**
+	 * Parts of the dialog to be redrawn
+	 */
+	typedef Dirty_rect<Rect, 3> Damage;
 }
 
 
@@ -56,15 +62,20 @@ class Menu_view::Widget_factory
 		Allocator      &alloc;
 		Style_database &styles;
 		Animator       &animator;
+		Damage         &damage;
 
-		Widget_factory(Allocator &alloc, Style_database &styles, Animator &animator)
+		Widget_factory(Allocator &alloc, Style_database &styles,
+		               Animator &animator, Damage &damage)
 		:
-			alloc(alloc), styles(styles), animator(animator)
+			alloc(alloc), styles(styles), animator(animator), damage(damage)
 		{ }
 
 		Widget *create(Xml_node node);
 
-		void destroy(Widget *widget) { Genode::destroy(alloc, widget); }
+		/**
+		 * Destroy widget and mark the area it occupied as dirty
+		 */
+		void destroy(Widget *widget);
 };
 
 
@@ -119,8 +130,59 @@ class Menu_view::Widget : public List<Widget>::Element
 
 		Unique_id const _unique_id;
 
+		/*
+		 * State of the XML node the widget was last updated from. If the node
+		 * content is unchanged, the update of the whole subtree is skipped.
+		 */
+		bool          _node_known = false;
+		size_t        _node_size  = 0;
+		unsigned long _node_hash  = 0;
+
+		/*
+		 * Absolute geometry and appearance at the time of the last redraw
+		 */
+		Rect     _drawn_geometry;
+		unsigned _drawn_version = 0;
+
+		static unsigned long _hash(Xml_node node)
+		{
+			/* djb2 string hash */
+			unsigned long hash = 5381;
+			char const *s = node.addr();
+			for (size_t i = 0; i < node.size(); i++)
+				hash = hash*33 + (unsigned char)s[i];
+
+			return hash;
+		}
+
+		/**
+		 * Return true if 'node' differs from the node of the last update
+		 */
+		bool _node_changed(Xml_node node)
+		{
+			size_t        const size = node.size();
+			unsigned long const hash = _hash(node);
+
+			if (_node_known && size == _node_size && hash == _node_hash)
+				return false;
+
+			_node_known = true;
+			_node_size  = size;
+			_node_hash  = hash;
+			return true;
+		}
+
 	protected:
 
+		/*
+		 * Version of the widget's appearance, to be incremented by the
+		 * widget implementation whenever its drawing changes without a
+		 * change of its geometry
+		 */
+		unsigned _version = 1;
+
+		void _appearance_changed() { _version++; }
+
 		Widget_factory &_factory;
 
 		List<Widget> _children;
@@ -190,7 +252,7 @@ class Menu_view::Widget : public List<Widget>::Element
 						_children.insert(w);
 				}
 
-				if (w)
+				if (w && w->_node_changed(child_node))
 					w->update(child_node);
 			}
 		}
@@ -229,7 +291,7 @@ class Menu_view::Widget : public List<Widget>::Element
 					_children.insert(w);
 				}
 
-				if (w)
+				if (w->_node_changed(child_node))
 					w->update(child_node);
 			}
 
@@ -330,6 +392,34 @@ class Menu_view::Widget : public List<Widget>::Element
 			geometry = Rect(position, geometry.area());
 		}
 
+		/**
+		 * Mark areas of the widget tree that changed since the last redraw
+		 *
+		 * \param at  absolute position of the parent widget
+		 */
+		void collect_damage(Damage &damage, Point at)
+		{
+			Rect const abs_geometry(at + geometry.p1(), geometry.area());
+
+			if (abs_geometry.p1() != _drawn_geometry.p1()
+			 || abs_geometry.p2() != _drawn_geometry.p2()
+			 || _version != _drawn_version) {
+
+				if (_drawn_geometry.valid())
+					damage.mark_as_dirty(_drawn_geometry);
+
+				damage.mark_as_dirty(abs_geometry);
+
+				_drawn_geometry = abs_geometry;
+				_drawn_version  = _version;
+			}
+
+			for (Widget *w = _children.first(); w; w = w->next())
+				w->collect_damage(damage, abs_geometry.p1());
+		}
+
+		Rect drawn_geometry() const { return _drawn_geometry; }
+
 		/**
 		 * Return unique ID of inner-most hovered widget
 		 *
@@ -440,7 +530,13 @@ struct Menu_view::Frame_widget : Widget
 
 	void update(Xml_node node) override
 	{
-		texture = _factory.styles.texture(node, "background");
+		Texture<Pixel_rgb888> const * const new_texture =
+			_factory.styles.texture(node, "background");
+
+		if (new_texture != texture)
+			_appearance_changed();
+
+		texture = new_texture;
 
 		_update_child(node);
 
@@ -671,6 +767,9 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 		bool const new_hovered  = _enabled(node, "hovered");
 		bool const new_selected = _enabled(node, "selected");
 
+		if (new_selected != selected || !default_texture)
+			_appearance_changed();
+
 		if (new_selected) {
 			default_texture = _factory.styles.texture(node, "selected");
 			hovered_texture = _factory.styles.texture(node, "hselected");
@@ -766,6 +865,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 	{
 		blend.animate();
 
+		_appearance_changed();
+
 		animated(blend != blend.dst());
 	}
 };
@@ -787,8 +888,14 @@ struct Menu_view::Label_widget : Widget
 
 	void update(Xml_node node)
 	{
-		font = _factory.styles.font(node, "font");
-		text = Decorator::string_attribute(node, "text", Text(""));
+		Text_painter::Font const * const new_font = _factory.styles.font(node, "font");
+		Text const new_text = Decorator::string_attribute(node, "text", Text(""));
+
+		if (new_font != font || new_text != text)
+			_appearance_changed();
+
+		font = new_font;
+		text = new_text;
 	}
 
 	Area min_size() const override
@@ -843,4 +950,13 @@ Menu_view::Widget_factory::create(Xml_node node)
 	return w;
 }
 
+
+void Menu_view::Widget_factory::destroy(Widget *widget)
+{
+	if (widget->drawn_geometry().valid())
+		damage.mark_as_dirty(widget->drawn_geometry());
+
+	Genode::destroy(alloc, widget);
+}
+
 #endif /* _WIDGETS_H_ */
@@ -97,9 +97,10 @@ class Scene : public Nano3d::Scene<PT>
 	public:
 
 		Scene(Genode::Signal_receiver &sig_rec, unsigned update_rate_ms,
-		      Nitpicker::Point pos, Nitpicker::Area size)
+		      Nitpicker::Point pos, Nitpicker::Area size, unsigned num_threads)
 		:
-			Nano3d::Scene<PT>(sig_rec, update_rate_ms, pos, size), _size(size),
+			Nano3d::Scene<PT>(sig_rec, update_rate_ms, pos, size, num_threads),
+			_size(size),
 			_config_dispatcher(sig_rec, *this, &Scene::_handle_config)
 		{
 			Genode::config()->sigh(_config_dispatcher);
@@ -203,7 +204,7 @@ class Scene : public Nano3d::Scene<PT>
 		void render(Genode::Surface<PT>                   &pixel,
 		            Genode::Surface<Genode::Pixel_alpha8> &alpha) override
 		{
-			unsigned const frame = (this->elapsed_ms()/10) % 1024;
+			unsigned const frame = (this->frame_ms()/10) % 1024;
 
 			if (_shape == SHAPE_DODECAHEDRON) {
 
@@ -225,9 +226,15 @@ int main(int argc, char **argv)
 
 	enum { UPDATE_RATE_MS = 20 };
 
+	/* number of threads used for rendering */
+	unsigned num_threads = 1;
+	try { Genode::config()->xml_node().attribute("threads").value(&num_threads); }
+	catch (...) { }
+
 	static Scene<Genode::Pixel_rgb565>
 		scene(sig_rec, UPDATE_RATE_MS,
-		      Nitpicker::Point(-200, -200), Nitpicker::Area(400, 400));
+		      Nitpicker::Point(-200, -200), Nitpicker::Area(400, 400),
+		      num_threads);
 
 	scene.dispatch_signals_loop(sig_rec);
 
@@ -486,6 +486,15 @@ class Wm::Nitpicker::Session_component : public Rpc_object<Nitpicker::Session>,
 		 * Translate input event to the client's coordinate system
 		 */
 		Input::Event _translate_event(Input::Event const ev, Point const input_origin)
+		{
+			Input::Event translated = _translate_position(ev, input_origin);
+
+			/* retain creation time for measuring the latency along the chain */
+			translated.timestamp(ev.timestamp());
+			return translated;
+		}
+
+		Input::Event _translate_position(Input::Event const ev, Point const input_origin)
 		{
 			switch (ev.type()) {
 
@@ -0,0 +1,223 @@
+/*
+ * \brief  Frame-rate benchmark of the nano3d polygon rendering
+ * \author agent
+ * \date   2015-11-30
+ *
+ * The benchmark renders the rotating cube and dodecahedron of the nano3d
+ * demo into an off-screen RGB565 buffer, using the shaded and the textured
+ * polygon painter. Each combination is measured with an increasing number
+ * of rendering threads.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <os/attached_ram_dataspace.h>
+#include <os/config.h>
+#include <os/pixel_rgb565.h>
+#include <timer_session/connection.h>
+#include <polygon_gfx/shaded_polygon_painter.h>
+#include <polygon_gfx/interpolate_rgb565.h>
+#include <polygon_gfx/textured_polygon_painter.h>
+#include <nano3d/dodecahedron_shape.h>
+#include <nano3d/cube_shape.h>
+#include <nano3d/parallel_renderer.h>
+
+using namespace Genode;
+
+typedef Pixel_rgb565 PT;
+
+
+struct Parameters
+{
+	unsigned width   = 1920;
+	unsigned height  = 1080;
+	unsigned frames  = 200;
+	unsigned threads = env()->cpu_session()->affinity_space().total();
+
+	Parameters()
+	{
+		Xml_node config = Genode::config()->xml_node();
+
+		try { config.attribute("width").value(&width); }     catch (...) { }
+		try { config.attribute("height").value(&height); }   catch (...) { }
+		try { config.attribute("frames").value(&frames); }   catch (...) { }
+		try { config.attribute("threads").value(&threads); } catch (...) { }
+
+		threads = max(threads, 1U);
+	}
+};
+
+
+struct Bench : Nano3d::Parallel_renderer<PT>::Band_renderer
+{
+	enum Shape   { SHAPE_DODECAHEDRON, SHAPE_CUBE };
+	enum Painter { PAINTER_SHADED, PAINTER_TEXTURED };
+
+	struct Texture
+	{
+		enum { W = 128, H = 128 };
+
+		unsigned char       alpha[H][W];
+		PT                  pixel[H][W];
+		Surface_base::Area  size { W, H };
+		Genode::Texture<PT> texture { &pixel[0][0], &alpha[0][0], size };
+
+		Texture()
+		{
+			for (unsigned y = 0; y < H; y++)
+				for (unsigned x = 0; x < W; x++) {
+					alpha[y][x] = ((x&4) ^ (y&4)) ? 0 : 200;
+					pixel[y][x] = PT((x*200)/W, (y*200)/H, (x*128)/W + (y*128)/H);
+				}
+		}
+	};
+
+	Surface_base::Area const size;
+
+	Texture _texture;
+
+	Polygon::Shaded_painter   _shaded_painter   { *env()->heap(), size.h() };
+	Polygon::Textured_painter _textured_painter { *env()->heap(), size.h() };
+
+	Nano3d::Cube_shape         const _cube         { 7000 };
+	Nano3d::Dodecahedron_shape const _dodecahedron { 10000 };
+
+	Shape    shape   = SHAPE_CUBE;
+	Painter  painter = PAINTER_SHADED;
+	unsigned frame   = 0;
+
+	Bench(Surface_base::Area size) : size(size) { }
+
+	template <typename SHAPE>
+	void _render_shape(Surface<PT> &pixel, Surface<Pixel_alpha8> &alpha,
+	                   SHAPE const &shape, bool backward_facing)
+	{
+		auto vertices = shape.vertex_array();
+
+		vertices.rotate_x(frame*1);
+		vertices.rotate_y(frame*2);
+		vertices.rotate_z(frame*3);
+		vertices.project(1600, 2*size.h());
+		vertices.translate(size.w()/2, size.h()/2, 0);
+
+		shape.for_each_face([&] (unsigned const vertex_indices[],
+		                         unsigned num_vertices) {
+
+			if (painter == PAINTER_TEXTURED) {
+
+				typedef Polygon::Textured_painter::Point Point;
+				Point points[num_vertices];
+
+				int angle = -frame*4;
+				for (unsigned i = 0; i < num_vertices; i++) {
+
+					Nano3d::Vertex const v = vertices[vertex_indices[i]];
+
+					int const r = _texture.size.w()/2;
+					int const u = r + (r*Nano3d::cos_frac16(angle) >> 16);
+					int const w = r + (r*Nano3d::sin_frac16(angle) >> 16);
+
+					angle += Nano3d::Sincos_frac16::STEPS / num_vertices;
+
+					(backward_facing ? points[num_vertices - 1 - i] : points[i])
+						= Point(v.x(), v.y(), u, w);
+				}
+
+				_textured_painter.paint(pixel, alpha, points, num_vertices,
+				                        _texture.texture);
+			} else {
+
+				typedef Polygon::Shaded_painter::Point Point;
+				Point points[num_vertices];
+
+				for (unsigned i = 0; i < num_vertices; i++) {
+
+					Nano3d::Vertex const v = vertices[vertex_indices[i]];
+
+					Color const color =
+						backward_facing ? Color(i*10, i*10, i*10, 230 - i*18)
+						                : Color(240, 10*i, 0, 10 + i*35);
+
+					(backward_facing ? points[num_vertices - 1 - i] : points[i])
+						= Point(v.x(), v.y(), color);
+				}
+
+				_shaded_painter.paint(pixel, alpha, points, num_vertices);
+			}
+		});
+	}
+
+	/**
+	 * Band_renderer interface
+	 */
+	void render_band(Surface<PT> &pixel, Surface<Pixel_alpha8> &alpha) override
+	{
+		if (shape == SHAPE_DODECAHEDRON) {
+			_render_shape(pixel, alpha, _dodecahedron, true);
+			_render_shape(pixel, alpha, _dodecahedron, false);
+		} else {
+			_render_shape(pixel, alpha, _cube, true);
+			_render_shape(pixel, alpha, _cube, false);
+		}
+	}
+};
+
+
+int main(int argc, char **argv)
+{
+	static Parameters params;
+	static Timer::Connection timer;
+
+	Surface_base::Area const size(params.width, params.height);
+
+	static Attached_ram_dataspace pixel_ds(env()->ram_session(), size.count()*sizeof(PT));
+	static Attached_ram_dataspace alpha_ds(env()->ram_session(), size.count());
+
+	Surface<PT>           pixel(pixel_ds.local_addr<PT>(), size);
+	Surface<Pixel_alpha8> alpha(alpha_ds.local_addr<Pixel_alpha8>(), size);
+
+	static Bench bench(size);
+
+	printf("--- nano3d benchmark (%ux%u, %u frames) ---\n",
+	       size.w(), size.h(), params.frames);
+
+	for (unsigned threads = 1; ; threads = min(threads*2, params.threads)) {
+
+		Nano3d::Parallel_renderer<PT> &renderer =
+			*new (env()->heap()) Nano3d::Parallel_renderer<PT>(threads);
+
+		for (unsigned s = 0; s < 2; s++) {
+			for (unsigned p = 0; p < 2; p++) {
+
+				bench.shape   = s ? Bench::SHAPE_CUBE : Bench::SHAPE_DODECAHEDRON;
+				bench.painter = p ? Bench::PAINTER_TEXTURED : Bench::PAINTER_SHADED;
+
+				unsigned long const start_ms = timer.elapsed_ms();
+
+				for (bench.frame = 0; bench.frame < params.frames; bench.frame++)
+					renderer.render(pixel, alpha, bench);
+
+				unsigned long const ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+				printf("%-12s %-8s %2u thread%s: %5lu ms -> %4lu.%lu fps\n",
+				       s ? "cube" : "dodecahedron", p ? "textured" : "shaded",
+				       threads, threads == 1 ? " " : "s", ms,
+				       (params.frames*1000UL)/ms,
+				       ((params.frames*10000UL)/ms) % 10);
+			}
+		}
+
+		if (threads == params.threads)
+			break;
+	}
+
+	printf("--- benchmark finished ---\n");
+	return 0;
+}
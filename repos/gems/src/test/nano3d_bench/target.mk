@@ -0,0 +1,3 @@
+TARGET   = test-nano3d_bench
+SRC_CC   = main.cc
+LIBS     = base config
@@ -89,6 +89,9 @@
 
 #define PBUF_POOL_SIZE             96
 
+/* reference received packets within the NIC packet buffer, see 'nic.cc' */
+#define LWIP_SUPPORT_CUSTOM_PBUF    1
+
 /*
  * We reduce the maximum segment lifetime from one minute to one second to
  * avoid queuing up PCBs in TIME-WAIT state. This is the state, PCBs end up
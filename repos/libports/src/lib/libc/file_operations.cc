@@ -27,6 +27,7 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -424,6 +425,9 @@ extern "C" void *mmap(void *addr, ::size_t length, int prot, int flags,
 	}
 
 	void *start = fd->plugin->mmap(addr, length, prot, flags, fd, offset);
+	if (start == MAP_FAILED)
+		return start;
+
 	mmap_registry()->insert(start, length, fd->plugin);
 	return start;
 }
@@ -455,6 +459,23 @@ extern "C" int munmap(void *start, ::size_t length)
 }
 
 
+extern "C" int msync(void *start, ::size_t len, int flags)
+{
+	if (!mmap_registry()->is_registered(start)) {
+		PWRN("msync: could not lookup plugin for address %p", start);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* anonymous memory has no backing store to synchronize with */
+	Plugin *plugin = mmap_registry()->lookup_plugin_by_addr(start);
+	if (!plugin)
+		return 0;
+
+	return plugin->msync(start, len, flags);
+}
+
+
 extern "C" int _open(const char *pathname, int flags, ::mode_t mode)
 {
 	PDBGV("pathname = %s", pathname);
@@ -0,0 +1,413 @@
+/*
+ * \brief  Memory mappings of files provided by the VFS
+ * \author agent
+ * \date   2015-11-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LIBC_MAPPED_FILE_H_
+#define _LIBC_MAPPED_FILE_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/signal.h>
+#include <base/thread.h>
+#include <rm_session/connection.h>
+#include <util/list.h>
+#include <util/volatile_object.h>
+#include <vfs/directory_service.h>
+#include <vfs/file_io_service.h>
+#include <vfs/vfs_handle.h>
+
+/* libc-internal includes */
+#include <libc_mem_alloc.h>
+
+namespace Libc {
+	struct Mapping;
+	class  Shared_mapping;
+	class  File_mapping;
+	class  Mmap_pager;
+}
+
+
+/**
+ * Memory-mapped range of a file
+ */
+struct Libc::Mapping : Genode::List<Mapping>::Element
+{
+	virtual ~Mapping() { }
+
+	virtual void *local_addr() const = 0;
+
+	/**
+	 * Write modified content back to the file
+	 */
+	virtual void sync() { }
+
+	/**
+	 * Make sure that the part of 'addr' to 'addr + size' within the
+	 * mapping is backed by memory
+	 */
+	virtual void populate(void const *addr, Genode::size_t size) { }
+};
+
+
+/**
+ * Read-only mapping of a dataspace handed out by the VFS
+ *
+ * The dataspace is attached directly. Hence, processes that map the same
+ * ROM module or TAR archive share the pages of the file.
+ */
+class Libc::Shared_mapping : public Mapping
+{
+	private:
+
+		Vfs::Directory_service     &_ds;
+		Vfs::Absolute_path const    _path;
+		Genode::Dataspace_capability _ds_cap;
+		void                       *_local_addr = 0;
+
+	public:
+
+		class Unavailable : public Genode::Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Unavailable
+		 */
+		Shared_mapping(Vfs::Directory_service &ds, char const *path,
+		               Genode::size_t size, Genode::off_t offset)
+		:
+			_ds(ds), _path(path), _ds_cap(ds.dataspace(path))
+		{
+			if (!_ds_cap.valid())
+				throw Unavailable();
+
+			try {
+				_local_addr = Genode::env()->rm_session()->attach(_ds_cap, size,
+				                                                  offset);
+			} catch (...) {
+				_ds.release(_path.base(), _ds_cap);
+				throw Unavailable();
+			}
+		}
+
+		~Shared_mapping()
+		{
+			Genode::env()->rm_session()->detach(_local_addr);
+			_ds.release(_path.base(), _ds_cap);
+		}
+
+		void *local_addr() const override { return _local_addr; }
+};
+
+
+/**
+ * Mapping populated with the file content on demand
+ *
+ * The mapping is backed by a managed dataspace. On the first access of a
+ * chunk of the mapping, the 'Mmap_pager' reads the corresponding part of
+ * the file into a RAM dataspace and attaches it to the managed dataspace.
+ * Writable shared mappings are written back chunk by chunk on 'sync'.
+ *
+ * The pager reads via the VFS, which may hold a lock while copying from or
+ * to the buffer of a VFS operation, e.g., the 'Fs_file_system'. A buffer
+ * that lies within the mapping must therefore be populated by the caller
+ * via 'populate' before the buffer is passed to the VFS. Otherwise, the
+ * fault on the buffer would wait for the pager, which in turn waits for
+ * the lock.
+ *
+ * On kernels without support for managed dataspaces (e.g., Linux), the
+ * whole range is read into anonymous memory when the mapping is created.
+ */
+class Libc::File_mapping : public Mapping, public Genode::Signal_context
+{
+	public:
+
+		enum { CHUNK_SIZE_LOG2 = 16, CHUNK_SIZE = 1 << CHUNK_SIZE_LOG2 };
+
+	private:
+
+		typedef Genode::size_t size_t;
+		typedef Genode::addr_t addr_t;
+
+		Vfs::Vfs_handle &_handle;   /* private handle for reading and writing */
+
+		Vfs::file_size const _offset;     /* start of mapping within file */
+		size_t         const _size;       /* page-aligned size of mapping */
+		size_t         const _file_bytes; /* bytes of the mapping backed by the file */
+		bool           const _write_back;
+		unsigned       const _num_chunks;
+
+		Genode::Signal_receiver &_sig_rec;
+
+		Genode::Lock _lock;
+
+		Genode::Lazy_volatile_object<Genode::Rm_connection> _rm;
+
+		/* RAM dataspaces of populated chunks, used for the managed dataspace */
+		Genode::Ram_dataspace_capability *_chunks = 0;
+
+		char *_local_addr = 0;
+
+		size_t _chunk_size(unsigned i) const {
+			return Genode::min((size_t)CHUNK_SIZE, _size - i*CHUNK_SIZE); }
+
+		/**
+		 * Return number of bytes of chunk 'i' that are backed by the file
+		 */
+		size_t _chunk_file_bytes(unsigned i) const
+		{
+			size_t const start = i*CHUNK_SIZE;
+			return start < _file_bytes
+			     ? Genode::min(_file_bytes - start, _chunk_size(i)) : 0;
+		}
+
+		void _read(char *dst, size_t offset, size_t count)
+		{
+			while (count) {
+				_handle.seek(_offset + offset);
+
+				Vfs::file_size n = 0;
+				if (_handle.fs().read(&_handle, dst, count, n)
+				    != Vfs::File_io_service::READ_OK || n == 0)
+					return;
+
+				dst += n; offset += n; count -= n;
+			}
+		}
+
+		void _write(char const *src, size_t offset, size_t count)
+		{
+			while (count) {
+				_handle.seek(_offset + offset);
+
+				Vfs::file_size n = 0;
+				if (_handle.fs().write(&_handle, src, count, n)
+				    != Vfs::File_io_service::WRITE_OK || n == 0) {
+					PERR("could not write back mapped file content");
+					return;
+				}
+
+				src += n; offset += n; count -= n;
+			}
+		}
+
+		bool _managed() const { return _rm.is_constructed(); }
+
+		/**
+		 * Try to set up the managed dataspace
+		 */
+		bool _init_managed()
+		{
+			try { _rm.construct(0, _size); }
+			catch (...) { return false; }
+
+			Genode::Dataspace_capability ds = _rm->dataspace();
+			if (!ds.valid()) {
+				_rm.destruct();
+				return false;
+			}
+
+			_chunks = new (Genode::env()->heap())
+				Genode::Ram_dataspace_capability[_num_chunks];
+
+			_rm->fault_handler(_sig_rec.manage(this));
+			_local_addr = Genode::env()->rm_session()->attach(ds);
+			return true;
+		}
+
+		void _populate(unsigned i)
+		{
+			using namespace Genode;
+
+			size_t const size = _chunk_size(i);
+
+			Ram_dataspace_capability ds = env()->ram_session()->alloc(size);
+
+			char *dst = env()->rm_session()->attach(ds);
+			_read(dst, i*CHUNK_SIZE, _chunk_file_bytes(i));
+			env()->rm_session()->detach(dst);
+
+			_rm->attach_at(ds, i*CHUNK_SIZE, size);
+			_chunks[i] = ds;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param handle      VFS handle owned by the mapping
+		 * \param offset      page-aligned offset within the file
+		 * \param size        size of mapping
+		 * \param file_size   current size of the file
+		 * \param write_back  write modifications back to the file
+		 * \param sig_rec     signal receiver of the 'Mmap_pager'
+		 *
+		 * \throw Ram_session::Alloc_failed
+		 */
+		File_mapping(Vfs::Vfs_handle &handle, Vfs::file_size offset,
+		             size_t size, Vfs::file_size file_size, bool write_back,
+		             Genode::Signal_receiver &sig_rec)
+		:
+			_handle(handle), _offset(offset),
+			_size(Genode::align_addr(size, PAGE_SHIFT)),
+			_file_bytes(file_size > offset
+			            ? Genode::min((Vfs::file_size)size, file_size - offset)
+			            : 0),
+			_write_back(write_back),
+			_num_chunks((_size + CHUNK_SIZE - 1) / CHUNK_SIZE),
+			_sig_rec(sig_rec)
+		{
+			if (_init_managed())
+				return;
+
+			void *addr = Libc::mem_alloc()->alloc(_size, PAGE_SHIFT);
+			if (addr == (void *)-1)
+				throw Genode::Ram_session::Alloc_failed();
+
+			_local_addr = (char *)addr;
+
+			Genode::memset(_local_addr, 0, _size);
+			_read(_local_addr, 0, _file_bytes);
+		}
+
+		~File_mapping()
+		{
+			sync();
+
+			if (!_managed()) {
+				Libc::mem_alloc()->free(_local_addr);
+			} else {
+				Genode::env()->rm_session()->detach(_local_addr);
+				_sig_rec.dissolve(this);
+				_rm.destruct();
+
+				for (unsigned i = 0; i < _num_chunks; i++)
+					if (_chunks[i].valid())
+						Genode::env()->ram_session()->free(_chunks[i]);
+
+				Genode::destroy(Genode::env()->heap(), _chunks);
+			}
+
+			Genode::destroy(Genode::env()->heap(), &_handle);
+		}
+
+		void *local_addr() const override { return _local_addr; }
+
+		void sync() override
+		{
+			if (!_write_back)
+				return;
+
+			Genode::Lock::Guard guard(_lock);
+
+			if (!_managed()) {
+				_write(_local_addr, 0, _file_bytes);
+				return;
+			}
+
+			/* chunks that were never accessed are still in their original state */
+			for (unsigned i = 0; i < _num_chunks; i++)
+				if (_chunks[i].valid())
+					_write(_local_addr + i*CHUNK_SIZE, i*CHUNK_SIZE,
+					       _chunk_file_bytes(i));
+		}
+
+		void populate(void const *addr, size_t size) override
+		{
+			if (!_managed() || !size)
+				return;
+
+			addr_t const base = (addr_t)_local_addr;
+			addr_t const from = Genode::max((addr_t)addr, base);
+			addr_t const to   = Genode::min((addr_t)addr + size - 1,
+			                                base + _size - 1);
+			if (from > to)
+				return;
+
+			Genode::Lock::Guard guard(_lock);
+
+			for (unsigned i = (from - base) >> CHUNK_SIZE_LOG2;
+			     i <= (to - base) >> CHUNK_SIZE_LOG2; i++) {
+
+				if (_chunks[i].valid())
+					continue;
+
+				try { _populate(i); }
+				catch (...) { PERR("could not populate mapped file at offset %lx",
+				                   (unsigned long)i*CHUNK_SIZE); }
+			}
+		}
+
+		/**
+		 * Resolve faults within the managed dataspace
+		 *
+		 * Called by the 'Mmap_pager'. Because signals of the same context
+		 * are merged, a single signal may stand for several faults. Hence,
+		 * faults are resolved until the RM session becomes ready.
+		 */
+		void handle_fault()
+		{
+			for (;;) {
+				Genode::Rm_session::State const state = _rm->state();
+				if (state.type == Genode::Rm_session::READY)
+					return;
+
+				unsigned const i = state.addr >> CHUNK_SIZE_LOG2;
+				if (i >= _num_chunks) {
+					PERR("invalid access of mapped file at offset %lx", state.addr);
+					return;
+				}
+
+				Genode::Lock::Guard guard(_lock);
+
+				/* fault cannot be resolved by populating the chunk */
+				if (_chunks[i].valid())
+					return;
+
+				try { _populate(i); }
+				catch (...) {
+					PERR("could not populate mapped file at offset %lx",
+					     state.addr);
+					return;
+				}
+			}
+		}
+};
+
+
+/**
+ * Thread that resolves faults of on-demand populated file mappings
+ */
+class Libc::Mmap_pager : Genode::Thread<4096*sizeof(long)>
+{
+	private:
+
+		Genode::Signal_receiver _sig_rec;
+
+		void entry() override
+		{
+			for (;;) {
+				Genode::Signal signal = _sig_rec.wait_for_signal();
+				static_cast<File_mapping *>(signal.context())->handle_fault();
+			}
+		}
+
+	public:
+
+		Mmap_pager() : Thread("libc_mmap_pager") { start(); }
+
+		Genode::Signal_receiver &signal_receiver() { return _sig_rec; }
+};
+
+#endif /* _LIBC_MAPPED_FILE_H_ */
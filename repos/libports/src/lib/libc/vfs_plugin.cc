@@ -37,6 +37,7 @@
 
 /* libc-internal includes */
 #include <libc_mem_alloc.h>
+#include <libc_mapped_file.h>
 
 
 static Vfs::Vfs_handle *vfs_handle(Libc::File_descriptor *fd)
@@ -159,6 +160,33 @@ class Libc::Vfs_plugin : public Libc::Plugin
 
 		Vfs::Dir_file_system _root_dir;
 
+		Genode::Lock                           _mappings_lock;
+		Genode::List<Mapping>                  _mappings;
+		Genode::Lazy_volatile_object<Mmap_pager> _mmap_pager;
+
+		Mapping *_lookup_mapping(void *addr)
+		{
+			Mapping *m = _mappings.first();
+			for (; m && m->local_addr() != addr; m = m->next());
+			return m;
+		}
+
+		/**
+		 * Populate file mappings that overlap the buffer of a VFS operation
+		 *
+		 * See 'File_mapping'.
+		 */
+		void _populate_mappings(void const *buf, ::size_t count)
+		{
+			Genode::Lock::Guard guard(_mappings_lock);
+
+			for (Mapping *m = _mappings.first(); m; m = m->next())
+				m->populate(buf, count);
+		}
+
+		Mapping *_create_mapping(::size_t, int, int, Libc::File_descriptor *,
+		                         ::off_t);
+
 		Genode::Xml_node _vfs_config()
 		{
 			try {
@@ -250,6 +278,7 @@ class Libc::Vfs_plugin : public Libc::Plugin
 		ssize_t write(Libc::File_descriptor *, const void *, ::size_t ) override;
 		void   *mmap(void *, ::size_t, int, int, Libc::File_descriptor *, ::off_t) override;
 		int     munmap(void *, ::size_t) override;
+		int     msync(void *, ::size_t, int) override;
 };
 
 
@@ -401,6 +430,8 @@ ssize_t Libc::Vfs_plugin::write(Libc::File_descriptor *fd, const void *buf,
 
 	Vfs::file_size out_count = 0;
 
+	_populate_mappings(buf, count);
+
 	switch (handle->fs().write(handle, (char const *)buf, count, out_count)) {
 	case Result::WRITE_ERR_AGAIN:       errno = EAGAIN;      return -1;
 	case Result::WRITE_ERR_WOULD_BLOCK: errno = EWOULDBLOCK; return -1;
@@ -425,6 +456,8 @@ ssize_t Libc::Vfs_plugin::read(Libc::File_descriptor *fd, void *buf,
 
 	Vfs::file_size out_count = 0;
 
+	_populate_mappings(buf, count);
+
 	switch (handle->fs().read(handle, (char *)buf, count, out_count)) {
 	case Result::READ_ERR_AGAIN:       errno = EAGAIN;      return -1;
 	case Result::READ_ERR_WOULD_BLOCK: errno = EWOULDBLOCK; return -1;
@@ -785,46 +818,115 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 }
 
 
-void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
-                             Libc::File_descriptor *fd, ::off_t offset)
+Libc::Mapping *Libc::Vfs_plugin::_create_mapping(::size_t length, int prot,
+                                                 int flags,
+                                                 Libc::File_descriptor *fd,
+                                                 ::off_t offset)
 {
-	if (prot != PROT_READ) {
-		PERR("mmap for prot=%x not supported", prot);
+	char const * const path = fd->fd_path;
+
+	/* map content that the VFS provides without copying directly */
+	if (!(prot & PROT_WRITE) && _root_dir.dataspace_shared(path)) {
+		try {
+			return new (Genode::env()->heap())
+				Shared_mapping(_root_dir, path, length, offset);
+		} catch (Shared_mapping::Unavailable) { }
+	}
+
+	Vfs::Directory_service::Stat stat;
+	if (_root_dir.stat(path, stat) != Vfs::Directory_service::STAT_OK) {
+		errno = ENOENT;
+		return 0;
+	}
+
+	/*
+	 * The mapping uses a handle of its own such that populating the mapping
+	 * does not interfere with the seek offset of the file descriptor.
+	 */
+	bool const write_back = (prot & PROT_WRITE) && (flags & MAP_SHARED);
+
+	Vfs::Vfs_handle *handle = 0;
+	unsigned const mode = write_back ? Vfs::Directory_service::OPEN_MODE_RDWR
+	                                 : Vfs::Directory_service::OPEN_MODE_RDONLY;
+	if (_root_dir.open(path, mode, &handle) != Vfs::Directory_service::OPEN_OK) {
 		errno = EACCES;
-		return (void *)-1;
+		return 0;
+	}
+
+	if (!_mmap_pager.is_constructed())
+		_mmap_pager.construct();
+
+	try {
+		return new (Genode::env()->heap())
+			File_mapping(*handle, offset, length, stat.size, write_back,
+			             _mmap_pager->signal_receiver());
+	} catch (...) {
+		Genode::destroy(Genode::env()->heap(), handle);
+		errno = ENOMEM;
+		return 0;
 	}
+}
+
 
+void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
+                             Libc::File_descriptor *fd, ::off_t offset)
+{
 	if (addr_in != 0) {
 		PERR("mmap for predefined address not supported");
 		errno = EINVAL;
 		return (void *)-1;
 	}
 
-	/*
-	 * XXX attempt to obtain memory mapping via
-	 *     'Vfs::Directory_service::dataspace'.
-	 */
-
-	void *addr = Libc::mem_alloc()->alloc(length, PAGE_SHIFT);
-	if (addr == (void *)-1) {
-		errno = ENOMEM;
+	if (!fd->fd_path || (offset & (PAGE_SIZE - 1))) {
+		errno = EINVAL;
 		return (void *)-1;
 	}
 
-	if (::pread(fd->libc_fd, addr, length, offset) < 0) {
-		PERR("mmap could not obtain file content");
-		::munmap(addr, length);
+	/* shared writable mappings require the file to be opened for writing */
+	if ((prot & PROT_WRITE) && (flags & MAP_SHARED)
+	 && (fd->status & O_ACCMODE) == O_RDONLY) {
 		errno = EACCES;
 		return (void *)-1;
 	}
 
-	return addr;
+	Genode::Lock::Guard guard(_mappings_lock);
+
+	Mapping *mapping = _create_mapping(length, prot, flags, fd, offset);
+	if (!mapping)
+		return (void *)-1;
+
+	_mappings.insert(mapping);
+	return mapping->local_addr();
 }
 
 
 int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 {
-	Libc::mem_alloc()->free(addr);
+	Genode::Lock::Guard guard(_mappings_lock);
+
+	Mapping *mapping = _lookup_mapping(addr);
+	if (!mapping) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	_mappings.remove(mapping);
+	Genode::destroy(Genode::env()->heap(), mapping);
+	return 0;
+}
+
+
+int Libc::Vfs_plugin::msync(void *addr, ::size_t, int)
+{
+	Genode::Lock::Guard guard(_mappings_lock);
+
+	Mapping *mapping = _lookup_mapping(addr);
+	if (!mapping) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	mapping->sync();
 	return 0;
 }
 
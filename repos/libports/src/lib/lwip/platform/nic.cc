@@ -27,6 +27,7 @@ extern "C" {
 }
 
 /* Genode includes */
+#include <base/lock.h>
 #include <base/thread.h>
 #include <base/printf.h>
 #include <nic/packet_allocator.h>
@@ -40,6 +41,23 @@ extern "C" {
 }
 
 
+class Nic_receiver_thread;
+
+
+/*
+ * Pbuf that references a received packet within the RX packet buffer
+ *
+ * The packet is acknowledged not before lwIP frees the pbuf.
+ */
+struct Rx_pbuf
+{
+	struct pbuf_custom      custom;  /* must be the first member */
+	Nic::Packet_descriptor  packet;
+	Nic_receiver_thread    *thread;
+	Rx_pbuf                *next_free;
+};
+
+
 /*
  * Thread, that receives packets by the nic-session interface.
  */
@@ -53,6 +71,33 @@ class Nic_receiver_thread : public Genode::Thread<8192>
 		Packet_descriptor _rx_packet; /* actual packet received */
 		struct netif     *_netif;     /* LwIP network interface structure */
 
+		/*
+		 * The RX sink is accessed by the receiver thread and by the threads
+		 * that free pbufs referencing received packets
+		 */
+		Genode::Lock _rx_lock;
+
+		/*
+		 * Maximum number of received packets referenced by lwIP
+		 *
+		 * Packets held by lwIP occupy the RX packet buffer. At most half of
+		 * the packets that fit into the buffer are referenced. If the limit
+		 * is reached, further packets are copied into pool pbufs such that
+		 * the NIC server can continue to deliver packets.
+		 */
+		unsigned const _max_rx_pbufs;
+
+		Rx_pbuf *_rx_pbufs;
+		Rx_pbuf *_free_rx_pbufs = 0;
+
+		static unsigned _rx_pbufs_for(Genode::size_t rx_buf_size)
+		{
+			Genode::size_t const packets =
+				rx_buf_size / Nic::Packet_allocator::DEFAULT_PACKET_SIZE;
+
+			return Genode::max(packets / 2, (Genode::size_t)1);
+		}
+
 		Genode::Signal_receiver  _sig_rec;
 
 		Genode::Signal_dispatcher<Nic_receiver_thread> _link_state_dispatcher;
@@ -61,10 +106,18 @@ class Nic_receiver_thread : public Genode::Thread<8192>
 
 		void _handle_rx_packet_avail(unsigned)
 		{
-			while (_nic->rx()->packet_avail() && _nic->rx()->ready_to_ack()) {
-				_rx_packet = _nic->rx()->get_packet();
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_rx_lock);
+
+					if (!_nic->rx()->packet_avail() || !_nic->rx()->ready_to_ack())
+						return;
+
+					_rx_packet = _nic->rx()->get_packet();
+				}
+
+				/* the packet gets acknowledged once lwIP is done with it */
 				genode_netif_input(_netif);
-				_nic->rx()->acknowledge_packet(_rx_packet);
 			}
 		}
 
@@ -87,9 +140,12 @@ class Nic_receiver_thread : public Genode::Thread<8192>
 
 	public:
 
-		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif)
+		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif,
+		                    Genode::size_t rx_buf_size)
 		:
 			Genode::Thread<8192>("nic-recv"), _nic(nic), _netif(netif),
+			_max_rx_pbufs(_rx_pbufs_for(rx_buf_size)),
+			_rx_pbufs(new (Genode::env()->heap()) Rx_pbuf[_max_rx_pbufs]),
 			_link_state_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_link_state),
 			_rx_packet_avail_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_packet_avail),
 			_rx_ready_to_ack_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_read_to_ack)
@@ -97,12 +153,58 @@ class Nic_receiver_thread : public Genode::Thread<8192>
 			_nic->link_state_sigh(_link_state_dispatcher);
 			_nic->rx_channel()->sigh_packet_avail(_rx_packet_avail_dispatcher);
 			_nic->rx_channel()->sigh_ready_to_ack(_rx_ready_to_ack_dispatcher);
+
+			for (unsigned i = 0; i < _max_rx_pbufs; i++) {
+				_rx_pbufs[i].next_free = _free_rx_pbufs;
+				_free_rx_pbufs = &_rx_pbufs[i];
+			}
 		}
 
 		void entry();
 		Nic::Connection  *nic() { return _nic; };
 		Packet_descriptor rx_packet() { return _rx_packet; };
 
+		/**
+		 * Acknowledge received packet, which is no longer referenced
+		 */
+		void release_rx_packet(Packet_descriptor packet)
+		{
+			Genode::Lock::Guard guard(_rx_lock);
+			_nic->rx()->acknowledge_packet(packet);
+		}
+
+		/**
+		 * Allocate pbuf referencing the received packet
+		 *
+		 * \return 0 if the maximum number of referenced packets is reached
+		 */
+		Rx_pbuf *alloc_rx_pbuf(Packet_descriptor packet)
+		{
+			Genode::Lock::Guard guard(_rx_lock);
+
+			Rx_pbuf *rx = _free_rx_pbufs;
+			if (!rx)
+				return 0;
+
+			_free_rx_pbufs = rx->next_free;
+			rx->packet     = packet;
+			rx->thread     = this;
+			return rx;
+		}
+
+		/**
+		 * Acknowledge packet referenced by pbuf and release the pbuf
+		 *
+		 * Called by whichever lwIP thread frees the pbuf.
+		 */
+		void free_rx_pbuf(Rx_pbuf *rx)
+		{
+			Genode::Lock::Guard guard(_rx_lock);
+			_nic->rx()->acknowledge_packet(rx->packet);
+			rx->next_free  = _free_rx_pbufs;
+			_free_rx_pbufs = rx;
+		}
+
 		Packet_descriptor alloc_tx_packet(Genode::size_t size)
 		{
 			while (true) {
@@ -180,10 +282,23 @@ extern "C" {
 	}
 
 
+	/**
+	 * Called by lwIP when a pbuf referencing a received packet is freed
+	 */
+	static void rx_pbuf_free(struct pbuf *p)
+	{
+		Rx_pbuf *rx = reinterpret_cast<Rx_pbuf *>(p);
+		rx->thread->free_rx_pbuf(rx);
+	}
+
+
 	/**
 	 * Should allocate a pbuf and transfer the bytes of the incoming
 	 * packet from the interface into the pbuf.
 	 *
+	 * If possible, the pbuf references the packet content within the
+	 * RX packet buffer instead of holding a copy.
+	 *
 	 * @param netif the lwip network interface structure for this genode_netif
 	 * @return a pbuf filled with the received packet (including MAC header)
 	 *         NULL on memory error
@@ -197,6 +312,17 @@ extern "C" {
 		char                  *rx_content = nic->rx()->packet_content(rx_packet);
 		u16_t                  len        = rx_packet.size();
 
+#if !ETH_PAD_SIZE
+		if (Rx_pbuf *rx = th->alloc_rx_pbuf(rx_packet)) {
+			rx->custom.custom_free_function = rx_pbuf_free;
+
+			struct pbuf *p = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF,
+			                                     &rx->custom, rx_content, len);
+			LINK_STATS_INC(link.recv);
+			return p;
+		}
+#endif
+
 #if ETH_PAD_SIZE
 		len += ETH_PAD_SIZE; /* allow room for Ethernet padding */
 #endif
@@ -227,6 +353,8 @@ extern "C" {
 			LINK_STATS_INC(link.drop);
 		}
 
+		/* the content was copied, so the packet can be handed back */
+		th->release_rx_packet(rx_packet);
 		return p;
 	}
 
@@ -295,7 +423,7 @@ extern "C" {
 
 		/* Setup receiver thread */
 		Nic_receiver_thread *th = new (env()->heap())
-			Nic_receiver_thread(nic, netif);
+			Nic_receiver_thread(nic, netif, nbs->rx_buf_size);
 
 		/* Store receiver thread address in user-defined netif struct part */
 		netif->state      = (void*) th;
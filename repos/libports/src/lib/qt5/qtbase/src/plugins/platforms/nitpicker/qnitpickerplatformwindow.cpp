@@ -187,6 +187,14 @@ void QNitpickerPlatformWindow::_handle_mode_changed(unsigned int)
 }
 
 
+void QNitpickerPlatformWindow::_handle_sync(unsigned int)
+{
+	/* ignore signals that were queued before the release */
+	if (_sync_sigh_installed)
+		emit sync();
+}
+
+
 Nitpicker::Session::View_handle QNitpickerPlatformWindow::_create_view()
 {
 	if (window()->type() == Qt::Desktop)
@@ -235,7 +243,10 @@ void QNitpickerPlatformWindow::_adjust_and_set_geometry(const QRect &rect)
 
 	Framebuffer::Mode mode(adjusted_rect.width(), adjusted_rect.height(),
 	                       Framebuffer::Mode::RGB565);
-	_nitpicker_session.buffer(mode, false);
+
+	Framebuffer::Mode buffer_mode(mode.width(), mode.height()*NUM_BUFFERS,
+	                              mode.format());
+	_nitpicker_session.buffer(buffer_mode, false);
 
 	_current_mode = mode;
 
@@ -252,6 +263,7 @@ QNitpickerPlatformWindow::QNitpickerPlatformWindow(QWindow *window,
   _framebuffer_session(_nitpicker_session.framebuffer_session()),
   _framebuffer(0),
   _framebuffer_changed(false),
+  _sync_sigh_installed(false),
   _geometry_changed(false),
   _signal_receiver(signal_receiver),
   _view_handle(_create_view()),
@@ -265,7 +277,9 @@ QNitpickerPlatformWindow::QNitpickerPlatformWindow(QWindow *window,
   _input_signal_dispatcher(_signal_receiver, *this,
                            &QNitpickerPlatformWindow::_input),
   _mode_changed_signal_dispatcher(_signal_receiver, *this,
-                                  &QNitpickerPlatformWindow::_mode_changed)
+                                  &QNitpickerPlatformWindow::_mode_changed),
+  _sync_signal_dispatcher(_signal_receiver, *this,
+                          &QNitpickerPlatformWindow::_sync)
 {
 	if (qnpw_verbose)
 		if (window->transientParent())
@@ -296,6 +310,10 @@ QNitpickerPlatformWindow::QNitpickerPlatformWindow(QWindow *window,
 	        this, SLOT(_handle_mode_changed(unsigned int)),
 	        Qt::QueuedConnection);
 
+	connect(this, SIGNAL(_sync(unsigned int)),
+	        this, SLOT(_handle_sync(unsigned int)),
+	        Qt::QueuedConnection);
+
 	connect(_key_repeat_timer, SIGNAL(timeout()),
 	        this, SLOT(_key_repeat()));
 }
@@ -620,6 +638,15 @@ unsigned char *QNitpickerPlatformWindow::framebuffer()
 	return _framebuffer;
 }
 
+unsigned char *QNitpickerPlatformWindow::back_buffer()
+{
+	unsigned char * const front = framebuffer();
+
+	return front ? front + _current_mode.width()*_current_mode.height()
+	                       *_current_mode.bytes_per_pixel()
+	             : 0;
+}
+
 void QNitpickerPlatformWindow::refresh(int x, int y, int w, int h)
 {
 	if (qnpw_verbose)
@@ -648,6 +675,24 @@ void QNitpickerPlatformWindow::refresh(int x, int y, int w, int h)
 	_framebuffer_session.refresh(x, y, w, h);
 }
 
+void QNitpickerPlatformWindow::request_sync()
+{
+	if (_sync_sigh_installed)
+		return;
+
+	_framebuffer_session.sync_sigh(_sync_signal_dispatcher);
+	_sync_sigh_installed = true;
+}
+
+void QNitpickerPlatformWindow::release_sync()
+{
+	if (!_sync_sigh_installed)
+		return;
+
+	_framebuffer_session.sync_sigh(Genode::Signal_context_capability());
+	_sync_sigh_installed = false;
+}
+
 EGLSurface QNitpickerPlatformWindow::egl_surface() const
 {
 	return _egl_surface;
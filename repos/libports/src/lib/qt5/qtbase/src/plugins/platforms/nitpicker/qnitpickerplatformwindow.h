@@ -42,10 +42,18 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 			KEY_REPEAT_RATE_MS  =  50  /* 50 ms delay between repetitions */
 		};
 
+		/*
+		 * The nitpicker buffer is twice as high as the window. The upper
+		 * half is displayed by the view, the lower half is the back buffer
+		 * painted by Qt.
+		 */
+		enum { NUM_BUFFERS = 2 };
+
 		Nitpicker::Connection            _nitpicker_session;
 		Framebuffer::Session_client      _framebuffer_session;
 		unsigned char                   *_framebuffer;
 		bool                             _framebuffer_changed;
+		bool                             _sync_sigh_installed;
 		bool                             _geometry_changed;
 		Framebuffer::Mode                _current_mode;
 		Genode::Signal_receiver         &_signal_receiver;
@@ -63,6 +71,7 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 
 		Genode::Signal_dispatcher<QNitpickerPlatformWindow> _input_signal_dispatcher;
 		Genode::Signal_dispatcher<QNitpickerPlatformWindow> _mode_changed_signal_dispatcher;
+		Genode::Signal_dispatcher<QNitpickerPlatformWindow> _sync_signal_dispatcher;
 
 		void _process_mouse_event(Input::Event *ev);
 		void _process_key_event(Input::Event *ev);
@@ -74,12 +83,14 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 
 		void _handle_input(unsigned int);
 		void _handle_mode_changed(unsigned int);
+		void _handle_sync(unsigned int);
 		void _key_repeat();
 
 	Q_SIGNALS:
 
 		void _input(unsigned int);
 		void _mode_changed(unsigned int);
+		void _sync(unsigned int);
 
 	public:
 
@@ -162,8 +173,20 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 
 	    unsigned char *framebuffer();
 
+	    unsigned char *back_buffer();
+
 		void refresh(int x, int y, int w, int h);
 
+		/**
+		 * Request 'sync' signals, emitted at the refresh rate of nitpicker
+		 */
+		void request_sync();
+
+		/**
+		 * Stop the delivery of 'sync' signals while there is nothing to draw
+		 */
+		void release_sync();
+
 
 		/* for QNitpickerGLContext */ 
 
@@ -181,6 +204,8 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 
 		void framebuffer_changed();
 
+		void sync();
+
 };
 
 QT_END_NAMESPACE
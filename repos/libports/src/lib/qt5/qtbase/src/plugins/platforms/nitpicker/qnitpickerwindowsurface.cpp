@@ -30,7 +30,7 @@ static const bool verbose = false;
 QT_BEGIN_NAMESPACE
 
 QNitpickerWindowSurface::QNitpickerWindowSurface(QWindow *window)
-    : QPlatformBackingStore(window), _backbuffer(0), _framebuffer_changed(true)
+    : QPlatformBackingStore(window), _framebuffer_changed(true)
 {
     //qDebug() << "QNitpickerWindowSurface::QNitpickerWindowSurface:" << (long)this;
 
@@ -39,11 +39,11 @@ QNitpickerWindowSurface::QNitpickerWindowSurface(QWindow *window)
 
     _platform_window = static_cast<QNitpickerPlatformWindow*>(window->handle());
     connect(_platform_window, SIGNAL(framebuffer_changed()), this, SLOT(framebuffer_changed()));
+    connect(_platform_window, SIGNAL(sync()), this, SLOT(_present()));
 }
 
 QNitpickerWindowSurface::~QNitpickerWindowSurface()
 {
-	qFree(_backbuffer);
 }
 
 QPaintDevice *QNitpickerWindowSurface::paintDevice()
@@ -57,6 +57,10 @@ QPaintDevice *QNitpickerWindowSurface::paintDevice()
     		PDBG("framebuffer changed");
 
     	_framebuffer_changed = false;
+
+		/* damage of the previous buffer cannot be presented anymore */
+		_damage = QRegion();
+
     	/*
     	 * It can happen that 'resize()' was not called yet, so the size needs
     	 * to be obtained from the window.
@@ -64,9 +68,10 @@ QPaintDevice *QNitpickerWindowSurface::paintDevice()
         QImage::Format format = QGuiApplication::primaryScreen()->handle()->format();
         QRect geo = _platform_window->geometry();
         unsigned int const bytes_per_pixel = QGuiApplication::primaryScreen()->depth() / 8;
-		qFree(_backbuffer);
-		_backbuffer = (unsigned char*)qMalloc(geo.width() * geo.height() * bytes_per_pixel);
-		_image = QImage(_backbuffer, geo.width(), geo.height(), geo.width() * bytes_per_pixel, format);
+
+		/* Qt paints directly into the back buffer of the nitpicker buffer */
+		_image = QImage(_platform_window->back_buffer(), geo.width(), geo.height(),
+		                geo.width() * bytes_per_pixel, format);
 
         if (verbose)
         	qDebug() << "QNitpickerWindowSurface::paintDevice(): w =" << geo.width() << ", h =" << geo.height();
@@ -81,8 +86,6 @@ QPaintDevice *QNitpickerWindowSurface::paintDevice()
 void QNitpickerWindowSurface::flush(QWindow *window, const QRegion &region, const QPoint &offset)
 {
     Q_UNUSED(window);
-    Q_UNUSED(region);
-    Q_UNUSED(offset);
 
     if (verbose)
     	qDebug() << "QNitpickerWindowSurface::flush("
@@ -91,35 +94,47 @@ void QNitpickerWindowSurface::flush(QWindow *window, const QRegion &region, cons
     	         << ", offset =" << offset
     	         << ")";
 
-	unsigned int const bytes_per_pixel = _image.depth() / 8;
+	/*
+	 * It happened that after resizing a window, the given flush region was
+	 * bigger than the current window size, so clipping is necessary here.
+	 */
+	_damage += region.translated(offset) & _image.rect();
 
-	for (int i = 0; i < region.rects().size(); i++) {
+	/* present the damage at the next sync of nitpicker */
+	_platform_window->request_sync();
+}
 
-		QRect rect(region.rects()[i]);
+void QNitpickerWindowSurface::_present()
+{
+	/* no frame was painted since the last sync */
+	if (_damage.isEmpty()) {
+		_platform_window->release_sync();
+		return;
+	}
 
-		/*
-		 * It happened that after resizing a window, the given flush region was
-		 * bigger than the current window size, so clipping is necessary here.
-		 */
+	unsigned int const bytes_per_pixel = _image.depth() / 8;
+	unsigned int const bytes_per_line  = _image.bytesPerLine();
 
-		rect &= _image.rect();
+	/* copy the painted parts from the back buffer to the visible buffer */
+	QVector<QRect> const rects = _damage.rects();
+	for (int i = 0; i < rects.size(); i++) {
 
-		unsigned int buffer_offset = ((rect.y() + offset.y()) * _image.bytesPerLine()) +
-		                             ((rect.x() + offset.x()) * bytes_per_pixel);
+		QRect const &rect = rects[i];
 
-		blit(_image.bits() + buffer_offset,
-		     _image.bytesPerLine(),
-		     _platform_window->framebuffer() + buffer_offset,
-		     _image.bytesPerLine(),
-		     rect.width() * bytes_per_pixel,
-		     rect.height());
+		unsigned int const buffer_offset = (rect.y() * bytes_per_line) +
+		                                   (rect.x() * bytes_per_pixel);
 
-		_platform_window->refresh(rect.x() + offset.x(),
-		                          rect.y() + offset.y(),
-		                          rect.width(),
-		                          rect.height());
+		blit(_image.constBits() + buffer_offset, bytes_per_line,
+		     _platform_window->framebuffer() + buffer_offset, bytes_per_line,
+		     rect.width() * bytes_per_pixel, rect.height());
 	}
 
+	/* one refresh for the whole frame */
+	QRect const bounds = _damage.boundingRect();
+	_platform_window->refresh(bounds.x(), bounds.y(),
+	                          bounds.width(), bounds.height());
+
+	_damage = QRegion();
 }
 
 void QNitpickerWindowSurface::resize(const QSize &size, const QRegion &staticContents)
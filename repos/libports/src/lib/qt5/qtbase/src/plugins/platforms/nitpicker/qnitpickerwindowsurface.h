@@ -28,10 +28,18 @@ class QNitpickerWindowSurface : public QObject, public QPlatformBackingStore
 	private:
 
 		QNitpickerPlatformWindow *_platform_window;
-		unsigned char            *_backbuffer;
 		QImage                    _image;
 		bool                      _framebuffer_changed;
 
+		/*
+		 * Parts of the back buffer painted since the last sync
+		 */
+		QRegion                   _damage;
+
+	private slots:
+
+		void _present();
+
 	public:
 
 		QNitpickerWindowSurface(QWindow *window);
@@ -30,6 +30,7 @@
  */
 #include <base/printf.h>
 #include <base/env.h>
+#include <base/signal.h>
 #include <framebuffer_session/connection.h>
 
 extern "C" {
@@ -48,6 +49,13 @@ extern "C" {
 	static SDL_Rect *modes[2];
 	static SDL_Rect df_mode;
 
+	/*
+	 * Sync signals of the framebuffer, used to pace the screen updates
+	 */
+	static Genode::Signal_receiver *sync_receiver = 0;
+	static Genode::Signal_context   sync_context;
+	static bool                     sync_supported = false;
+
 	/***************************************
 	 * Genode_Fb driver bootstrap functions
 	 **************************************/
@@ -189,6 +197,11 @@ extern "C" {
 		}
 		t->hidden->buffer = Genode::env()->rm_session()->attach(fb_ds_cap);
 
+		if (sync_receiver == 0) {
+			sync_receiver = new (Genode::env()->heap()) Genode::Signal_receiver;
+			framebuffer->sync_sigh(sync_receiver->manage(&sync_context));
+		}
+
 		return 0;
 	}
 
@@ -285,9 +298,31 @@ extern "C" {
 	static void Genode_Fb_UpdateRects(SDL_VideoDevice *t, int numrects,
 	                                  SDL_Rect *rects)
 	{
-		int i;
-		for(i=0;i<numrects;i++)
-			framebuffer->refresh(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+		if (numrects <= 0)
+			return;
+
+		/* merge all rectangles into one refresh */
+		int x1 = rects[0].x, y1 = rects[0].y;
+		int x2 = rects[0].x + rects[0].w, y2 = rects[0].y + rects[0].h;
+		for (int i = 1; i < numrects; i++) {
+			x1 = Genode::min(x1, (int)rects[i].x);
+			y1 = Genode::min(y1, (int)rects[i].y);
+			x2 = Genode::max(x2, rects[i].x + rects[i].w);
+			y2 = Genode::max(y2, rects[i].y + rects[i].h);
+		}
+
+		/*
+		 * Once the framebuffer has proven to deliver sync signals, update
+		 * the screen at most once per sync. Framebuffers that never send a
+		 * sync signal are refreshed immediately.
+		 */
+		if (!sync_supported && sync_receiver && sync_receiver->pending())
+			sync_supported = true;
+
+		if (sync_supported)
+			sync_receiver->wait_for_signal();
+
+		framebuffer->refresh(x1, y1, x2 - x1, y2 - y1);
 	}
 
 
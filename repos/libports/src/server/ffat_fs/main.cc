@@ -102,6 +102,9 @@ namespace File_system {
 						PDBGV("WRITE");
 						res_length = node.write((char const *)content, length, offset);
 						break;
+
+					default:
+						break;
 				}
 
 				packet.length(res_length);
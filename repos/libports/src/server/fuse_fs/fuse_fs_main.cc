@@ -88,6 +88,9 @@ class File_system::Session_component : public Session_rpc_object
 
 				res_length = node.write((char const *)content, length, offset);
 				break;
+
+			default:
+				break;
 			}
 
 			packet.length(res_length);
@@ -0,0 +1,176 @@
+/*
+ * \brief  Test for mapping VFS files via mmap
+ * \author agent
+ * \date   2015-11-28
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* libc includes */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+enum { FILE_SIZE = 1024*1024 + 123 };
+
+
+static char pattern(size_t offset) { return (char)(offset*7 + offset/4096); }
+
+
+static void fail(char const *msg)
+{
+	printf("Error: %s\n", msg);
+	exit(-1);
+}
+
+
+static void create_file(char const *path)
+{
+	static char buf[4096];
+
+	int fd = open(path, O_CREAT | O_RDWR);
+	if (fd < 0)
+		fail("could not create file");
+
+	for (size_t offset = 0; offset < FILE_SIZE; offset += sizeof(buf)) {
+		size_t const n = FILE_SIZE - offset < sizeof(buf)
+		               ? FILE_SIZE - offset : sizeof(buf);
+		for (size_t i = 0; i < n; i++)
+			buf[i] = pattern(offset + i);
+
+		if (write(fd, buf, n) != (ssize_t)n)
+			fail("could not write file");
+	}
+	close(fd);
+}
+
+
+static void test_read_only(char const *path)
+{
+	int fd = open(path, O_RDONLY);
+	char *addr = (char *)mmap(0, FILE_SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (addr == MAP_FAILED)
+		fail("read-only mmap failed");
+
+	/* access the mapping backwards to populate it out of order */
+	for (size_t i = FILE_SIZE; i > 0; i -= 997)
+		if (addr[i - 1] != pattern(i - 1))
+			fail("unexpected content of read-only mapping");
+
+	munmap(addr, FILE_SIZE);
+	printf("read-only mapping succeeded\n");
+}
+
+
+static void test_shared_write(char const *path)
+{
+	enum { OFFSET = 64*1024, SIZE = 256*1024 };
+
+	int fd = open(path, O_RDWR);
+	char *addr = (char *)mmap(0, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+	                          fd, OFFSET);
+	if (addr == MAP_FAILED)
+		fail("shared writable mmap failed");
+
+	/* modify every other page */
+	for (size_t i = 0; i < SIZE; i += 8192)
+		addr[i] = ~pattern(OFFSET + i);
+
+	if (msync(addr, SIZE, MS_SYNC) != 0)
+		fail("msync failed");
+
+	for (size_t i = 0; i < SIZE; i += 4096) {
+		char c = 0;
+		if (pread(fd, &c, 1, OFFSET + i) != 1)
+			fail("could not read back file");
+
+		char const expected = (i % 8192) ? pattern(OFFSET + i)
+		                                 : ~pattern(OFFSET + i);
+		if (c != expected)
+			fail("modification was not written back");
+	}
+
+	munmap(addr, SIZE);
+	close(fd);
+	printf("shared writable mapping succeeded\n");
+}
+
+
+/*
+ * Pass a not yet populated mapping as buffer to a file system that holds a
+ * lock while accessing the buffer
+ */
+static void test_copy_from_mapping(char const *from, char const *to)
+{
+	int from_fd = open(from, O_RDONLY);
+	char *addr = (char *)mmap(0, FILE_SIZE, PROT_READ, MAP_PRIVATE, from_fd, 0);
+	close(from_fd);
+
+	if (addr == MAP_FAILED)
+		fail("mmap of source file failed");
+
+	int to_fd = open(to, O_CREAT | O_RDWR);
+	if (to_fd < 0)
+		fail("could not create destination file");
+
+	if (write(to_fd, addr, FILE_SIZE) != FILE_SIZE)
+		fail("could not write from mapping");
+
+	for (size_t i = 0; i < FILE_SIZE; i += 4096) {
+		char c = 0;
+		if (pread(to_fd, &c, 1, i) != 1 || c != pattern(i))
+			fail("unexpected content of copied file");
+	}
+
+	close(to_fd);
+	munmap(addr, FILE_SIZE);
+	printf("copy from mapping succeeded\n");
+}
+
+
+static void test_rom(char const *path)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		fail("could not open ROM file");
+
+	char buf[64];
+	ssize_t const n = read(fd, buf, sizeof(buf));
+
+	char *addr = (char *)mmap(0, n, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (addr == MAP_FAILED || memcmp(addr, buf, n) != 0)
+		fail("mapping of ROM file failed");
+
+	munmap(addr, n);
+	close(fd);
+	printf("ROM mapping succeeded\n");
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- libc mmap test ---\n");
+
+	create_file("/tmp/data");
+	test_read_only("/tmp/data");
+	test_shared_write("/tmp/data");
+
+	create_file("/fs/data");
+	test_copy_from_mapping("/fs/data", "/fs/copy");
+
+	test_rom("/rom/config");
+
+	printf("--- libc mmap test finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_mmap
+LIBS   = libc
+SRC_CC = main.cc
@@ -46,6 +46,7 @@ namespace File_system {
 	struct Status;
 	struct Control;
 	struct Directory_entry;
+	struct Directory_entry_status;
 
 	/*
 	 * Exception types
@@ -106,7 +107,21 @@ class File_system::Packet_descriptor : public Genode::Packet_descriptor
 {
 	public:
 
-		enum Opcode { READ, WRITE };
+		/**
+		 * Packet operations
+		 *
+		 * Besides reading and writing, the packet stream carries
+		 * operations on node meta data so that a client can issue them
+		 * asynchronously instead of performing one RPC per node.
+		 *
+		 * 'STATUS' writes the 'Status' of the node into the packet
+		 * payload. 'CLOSE' releases the node handle and needs no payload.
+		 * 'READ_DIR_STATUS' reads as many 'Directory_entry_status' records
+		 * as fit into the packet, starting at the position, which must be
+		 * a multiple of the record size. At the end of the directory, it
+		 * succeeds with a length of zero.
+		 */
+		enum Opcode { READ, WRITE, STATUS, CLOSE, READ_DIR_STATUS };
 
 	private:
 
@@ -190,9 +205,25 @@ struct File_system::Directory_entry
 };
 
 
+/**
+ * Directory entry along with the status of the named node
+ *
+ * Data structure returned by the 'READ_DIR_STATUS' packet operation.
+ */
+struct File_system::Directory_entry_status
+{
+	Directory_entry entry;
+	Status          status;
+};
+
+
 struct File_system::Session : public Genode::Session
 {
-	enum { TX_QUEUE_SIZE = 16 };
+	/*
+	 * The queue must be deep enough to keep the server busy with
+	 * asynchronously issued meta-data operations of a client.
+	 */
+	enum { TX_QUEUE_SIZE = 128 };
 
 	typedef Packet_stream_policy<File_system::Packet_descriptor,
 	                             TX_QUEUE_SIZE, TX_QUEUE_SIZE,
@@ -17,7 +17,7 @@
 #include <base/env.h>
 #include <base/rpc_server.h>
 #include <os/attached_ram_dataspace.h>
-#include <os/ring_buffer.h>
+#include <util/construct_at.h>
 #include <root/component.h>
 #include <input_session/input_session.h>
 #include <input/event_queue.h>
@@ -29,10 +29,21 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 {
 	private:
 
+		/*
+		 * The dataspace starts with the events copied by 'flush', followed
+		 * by the event ring, which clients can drain without any RPC.
+		 */
 		Genode::Attached_ram_dataspace _ds { Genode::env()->ram_session(),
-		                                     Event_queue::QUEUE_SIZE*sizeof(Input::Event) };
+		                                     Event_ring::ds_size() };
+
+		Event_ring &_ring {
+			*Genode::construct_at<Event_ring>(_ds.local_addr<char>()
+			                                  + Event_ring::offset()) };
 
-		Event_queue _event_queue;
+		Event_queue _event_queue { _ring };
+
+		/* dropped events are reported once per overflow */
+		bool _overflow_reported = false;
 
 	public:
 
@@ -46,11 +57,16 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 		 */
 		void submit(Input::Event event)
 		{
+			if (_event_queue.avail_capacity())
+				_overflow_reported = false;
+
 			try {
 				_event_queue.add(event);
 			} catch (Input::Event_queue::Overflow) {
-				PWRN("input overflow - resetting queue");
-				_event_queue.reset();
+				/* the ring's tail is owned by the client, we can only drop */
+				if (!_overflow_reported)
+					PWRN("input overflow - dropping events");
+				_overflow_reported = true;
 			}
 		}
 
@@ -66,12 +82,10 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 		int flush() override
 		{
 			Input::Event *dst = _ds.local_addr<Input::Event>();
-			
-			unsigned cnt = 0;
-			for (; cnt < Event_queue::QUEUE_SIZE && !_event_queue.empty(); cnt++)
-				*dst++ = _event_queue.get();
 
-			return cnt;
+			/* the ring holds less events than the flush area */
+			return _event_queue.for_each([&] (Input::Event const &ev) {
+				*dst++ = ev; });
 		}
 
 		void sigh(Genode::Signal_context_capability sigh) override
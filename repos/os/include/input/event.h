@@ -15,6 +15,7 @@
 #define _INCLUDE__INPUT__EVENT_H_
 
 #include <input/keycodes.h>
+#include <trace/timestamp.h>
 
 namespace Input { class Event; }
 
@@ -45,6 +46,11 @@ class Input::Event
 		 */
 		int _rx, _ry;
 
+		/*
+		 * Time of the creation of the event by the input driver
+		 */
+		Genode::Trace::Timestamp _timestamp = 0;
+
 	public:
 
 		/**
@@ -67,6 +73,13 @@ class Input::Event
 		int  rx()   const { return _rx; }
 		int  ry()   const { return _ry; }
 
+		Genode::Trace::Timestamp timestamp() const { return _timestamp; }
+
+		/**
+		 * Set creation time, used to track the latency of event processing
+		 */
+		void timestamp(Genode::Trace::Timestamp t) { _timestamp = t; }
+
 		/**
 		 * Return key code for press/release events
 		 */
@@ -15,8 +15,10 @@
 #define _EVENT_QUEUE_H_
 
 #include <base/signal.h>
+#include <base/lock.h>
+#include <base/exception.h>
 #include <input/event.h>
-#include <os/ring_buffer.h>
+#include <input/event_ring.h>
 
 namespace Input { class Event_queue; };
 
@@ -33,13 +35,13 @@ class Input::Event_queue
 		 * generates not more than 16Kbit/s, which would correspond to ca. 66 mouse
 		 * events per 10ms.
 		 */
-		enum { QUEUE_SIZE = 512U };
-
-		typedef Genode::Ring_buffer<Input::Event, QUEUE_SIZE> Ring_buffer;
+		enum { QUEUE_SIZE = Event_ring::SIZE };
 
 	private:
 
-		Ring_buffer _queue;
+		Event_ring &_ring;
+
+		Genode::Lock _add_lock;  /* serialize drivers with multiple threads */
 
 		bool _enabled = false;
 
@@ -47,7 +49,14 @@ class Input::Event_queue
 
 	public:
 
-		typedef Ring_buffer::Overflow Overflow;
+		class Overflow : public Genode::Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \param ring  event ring located in the session dataspace
+		 */
+		Event_queue(Event_ring &ring) : _ring(ring) { }
 
 		void enabled(bool enabled) { _enabled = enabled; }
 
@@ -62,6 +71,10 @@ class Input::Event_queue
 		}
 
 		/**
+		 * Add event to queue
+		 *
+		 * Events without a timestamp are stamped with the current time.
+		 *
 		 * \throw Overflow
 		 */
 		void add(Input::Event ev, bool submit_signal_immediately = true)
@@ -69,19 +82,29 @@ class Input::Event_queue
 			if (!_enabled)
 				return;
 
-			_queue.add(ev);
+			if (!ev.timestamp())
+				ev.timestamp(Genode::Trace::timestamp());
+
+			{
+				Genode::Lock::Guard guard(_add_lock);
+
+				if (!_ring.add(ev))
+					throw Overflow();
+			}
 
 			if (submit_signal_immediately)
 				submit_signal();
 		}
 
-		Input::Event get() { return _queue.get(); }
-
-		bool empty() const { return _queue.empty(); }
+		/**
+		 * Consume pending events, coalescing consecutive motion events
+		 */
+		template <typename FN>
+		unsigned for_each(FN const &fn) { return _ring.for_each(fn); }
 
-		int avail_capacity() const { return _queue.avail_capacity(); }
+		bool empty() const { return _ring.empty(); }
 
-		void reset() { _queue.reset(); }
+		int avail_capacity() const { return _ring.avail_capacity(); }
 };
 
 #endif /* _EVENT_QUEUE_H_ */
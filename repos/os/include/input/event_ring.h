@@ -0,0 +1,227 @@
+/*
+ * \brief  Input-event ring shared between input server and client
+ * \author agent
+ * \date   2015-12-04
+ *
+ * The ring is located in the dataspace of an input session, behind the area
+ * used by the 'flush' RPC function. The server is the only producer and
+ * advances the head index, the client is the only consumer and advances the
+ * tail index. Hence, the client can obtain events without any RPC. Because
+ * the indices reside in memory shared with the other party, each index read
+ * from the ring is sanitized before being used.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__INPUT__EVENT_RING_H_
+#define _INCLUDE__INPUT__EVENT_RING_H_
+
+#include <base/stdint.h>
+#include <cpu/memory_barrier.h>
+#include <input/event.h>
+
+namespace Input { class Event_ring; }
+
+
+class Input::Event_ring
+{
+	public:
+
+		/**
+		 * Number of event slots, the ring holds up to 'SIZE - 1' events
+		 *
+		 * The flush area in front of the ring has the same number of slots.
+		 */
+		enum { SIZE = 512U };
+
+	private:
+
+		enum { MAGIC = 0x45564e52 /* "EVNR" */ };
+
+		unsigned volatile _magic = MAGIC;
+		unsigned volatile _head  = 0;
+		unsigned volatile _tail  = 0;
+
+		Event _events[SIZE];
+
+		/**
+		 * Return true if 'ev' can be merged into the preceding event 'prev'
+		 */
+		static bool _coalescable(Event const &prev, Event const &ev)
+		{
+			return (prev.is_absolute_motion() && ev.is_absolute_motion())
+			    || (prev.is_relative_motion() && ev.is_relative_motion());
+		}
+
+		/**
+		 * Merge two consecutive motion events
+		 *
+		 * The merged event keeps the timestamp of the older event so that
+		 * latency measurements account for the earliest motion.
+		 */
+		static Event _merged(Event const &prev, Event const &ev)
+		{
+			Event merged = ev.is_relative_motion()
+			             ? Event(Event::MOTION, 0, ev.ax(), ev.ay(),
+			                     prev.rx() + ev.rx(), prev.ry() + ev.ry())
+			             : ev;
+
+			merged.timestamp(prev.timestamp() ? prev.timestamp() : ev.timestamp());
+			return merged;
+		}
+
+	public:
+
+		/**
+		 * Offset of the ring within the session dataspace
+		 */
+		static constexpr Genode::size_t offset() { return SIZE*sizeof(Event); }
+
+		/**
+		 * Size of session dataspace containing the flush area and the ring
+		 */
+		static constexpr Genode::size_t ds_size() {
+			return offset() + sizeof(Event_ring); }
+
+		/**
+		 * Return ring contained in the session dataspace
+		 *
+		 * \return  pointer to ring, or 0 if the server does not provide one
+		 */
+		static Event_ring *lookup(void *ds_base, Genode::size_t ds_size)
+		{
+			if (!ds_base || ds_size < Event_ring::ds_size())
+				return 0;
+
+			Event_ring *ring = (Event_ring *)((char *)ds_base + offset());
+			return ring->_magic == MAGIC ? ring : 0;
+		}
+
+		/**
+		 * Obtain pending events of an input session
+		 *
+		 * \param ring        ring of the session, or 0 if the session has none
+		 * \param session     input session, used for the 'flush' RPC if the
+		 *                    server does not provide a ring
+		 * \param flush_area  locally attached session dataspace
+		 * \param fn          functor called with each 'Event const &'
+		 * \return            number of events passed to 'fn'
+		 */
+		template <typename SESSION, typename FN>
+		static unsigned consume(Event_ring *ring, SESSION &session,
+		                        Event const *flush_area, FN const &fn)
+		{
+			if (ring)
+				return ring->for_each(fn);
+
+			unsigned const num = session.flush();
+			for (unsigned i = 0; i < num; i++)
+				fn(flush_area[i]);
+
+			return num;
+		}
+
+		/**
+		 * Return true if no event is pending
+		 */
+		bool empty() const { return _head % SIZE == _tail % SIZE; }
+
+		/**
+		 * Return number of events that can be added without overflow
+		 *
+		 * Called by the producer only.
+		 */
+		unsigned avail_capacity() const
+		{
+			unsigned const head = _head % SIZE, tail = _tail % SIZE;
+			return (tail + SIZE - head - 1) % SIZE;
+		}
+
+		/**
+		 * Place event into ring, called by the producer only
+		 *
+		 * \return  false if the ring is full
+		 */
+		bool add(Event const &ev)
+		{
+			unsigned const head = _head % SIZE;
+			unsigned const next = (head + 1) % SIZE;
+
+			if (next == _tail % SIZE)
+				return false;
+
+			_events[head] = ev;
+
+			/* make the event visible before publishing the new head */
+			Genode::memory_barrier();
+			_head = next;
+			return true;
+		}
+
+		/**
+		 * Consume all pending events, called by the consumer only
+		 *
+		 * Consecutive motion events of the same kind are coalesced into one
+		 * event. Absolute motion events are merged into the latest position,
+		 * relative motion vectors are accumulated.
+		 *
+		 * \param fn  functor called with each 'Event const &'
+		 * \return    number of events passed to 'fn'
+		 */
+		template <typename FN>
+		unsigned for_each(FN const &fn)
+		{
+			unsigned const head = _head % SIZE;
+			unsigned       tail = _tail % SIZE;
+
+			if (head == tail)
+				return 0;
+
+			/* read the events not before observing the head */
+			Genode::memory_barrier();
+
+			unsigned cnt = 0;
+			Event pending;
+			bool  has_pending = false;
+			for (; tail != head; tail = (tail + 1) % SIZE) {
+
+				Event const ev = _events[tail];
+
+				if (has_pending && _coalescable(pending, ev)) {
+					pending = _merged(pending, ev);
+
+					/*
+					 * Drop relative motions that cancel out each other,
+					 * a zero vector would denote an absolute motion.
+					 */
+					if (ev.is_relative_motion() && !pending.rx() && !pending.ry())
+						has_pending = false;
+					continue;
+				}
+
+				if (has_pending) {
+					fn(pending);
+					cnt++;
+				}
+				pending = ev;
+				has_pending = true;
+			}
+
+			/* release the slots only after they have been read */
+			Genode::memory_barrier();
+			_tail = tail;
+
+			if (has_pending) {
+				fn(pending);
+				cnt++;
+			}
+			return cnt;
+		}
+};
+
+#endif /* _INCLUDE__INPUT__EVENT_RING_H_ */
@@ -73,6 +73,8 @@ class Genode::Attached_rom_dataspace
 
 		size_t size() const { return _ds->size(); }
 
+		Dataspace_capability cap() const { return _ds->cap(); }
+
 		/**
 		 * Register signal handler for ROM module changes
 		 */
@@ -0,0 +1,133 @@
+/*
+ * \brief  Dataspace that aliases a page-aligned part of another dataspace
+ * \author agent
+ * \date   2015-11-23
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__DATASPACE_SLICE_H_
+#define _INCLUDE__OS__DATASPACE_SLICE_H_
+
+#include <rm_session/connection.h>
+#include <os/attached_ram_dataspace.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+#include <util/volatile_object.h>
+
+namespace Genode { class Dataspace_slice; }
+
+
+/**
+ * Managed dataspace that exports a byte range of a backing dataspace
+ *
+ * Instead of copying the content of the range into a freshly allocated RAM
+ * dataspace, the whole pages of the range are attached to a managed
+ * dataspace. Hence, the slice does not consume any memory for its content
+ * except for the partially used last page. This page is backed by a private
+ * RAM dataspace that holds a copy of the trailing bytes, which prevents the
+ * user of the slice from observing backing-store content beyond the end of
+ * the range.
+ *
+ * The start of the range must be page-aligned within the backing dataspace.
+ * The managed dataspace is not supported on all kernels (e.g., Linux). In
+ * this case, the constructor throws 'Unsupported' and the user should fall
+ * back to copying the content.
+ */
+class Genode::Dataspace_slice
+{
+	public:
+
+		enum { PAGE_SIZE_LOG2 = 12, PAGE_SIZE = 1 << PAGE_SIZE_LOG2 };
+
+		class Unaligned   : public Exception { };
+		class Unsupported : public Exception { };
+
+		/**
+		 * Return true if a range starting at 'offset' can be aliased
+		 */
+		static bool aligned(off_t offset) {
+			return (offset & (PAGE_SIZE - 1)) == 0; }
+
+		/**
+		 * Return true if aliasing the range is cheaper than copying it
+		 *
+		 * Each slice consumes the session quota of an RM session. For small
+		 * ranges, a plain copy into a RAM dataspace is less expensive.
+		 */
+		static bool worthwhile(off_t offset, size_t size) {
+			return aligned(offset) && size >= (size_t)Rm_connection::RAM_QUOTA; }
+
+	private:
+
+		size_t const _size;
+
+		Lazy_volatile_object<Rm_connection>          _rm;
+		Lazy_volatile_object<Attached_ram_dataspace> _tail;
+
+		Dataspace_capability _ds;
+
+		static size_t _full_pages_size(size_t size) {
+			return size & ~(size_t)(PAGE_SIZE - 1); }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param backing     dataspace that contains the range
+		 * \param local_base  local address of the attached 'backing'
+		 *                    dataspace, used to copy the trailing bytes
+		 * \param offset      start of range within 'backing'
+		 * \param size        size of range in bytes
+		 *
+		 * \throw Unaligned
+		 * \throw Unsupported
+		 * \throw Ram_session::Alloc_failed
+		 * \throw Rm_session::Attach_failed
+		 */
+		Dataspace_slice(Dataspace_capability backing, char const *local_base,
+		                off_t offset, size_t size)
+		: _size(size)
+		{
+			if (!aligned(offset))
+				throw Unaligned();
+
+			try { _rm.construct(0, align_addr(size, PAGE_SIZE_LOG2)); }
+			catch (...) { throw Unsupported(); }
+
+			_ds = _rm->dataspace();
+			if (!_ds.valid())
+				throw Unsupported();
+
+			size_t const full = _full_pages_size(size);
+
+			if (full)
+				_rm->attach_at(backing, 0, full, offset);
+
+			size_t const tail = size - full;
+			if (!tail)
+				return;
+
+			_tail.construct(env()->ram_session(), (size_t)PAGE_SIZE);
+			memcpy(_tail->local_addr<char>(), local_base + offset + full, tail);
+			_rm->attach_at(_tail->cap(), full);
+		}
+
+		/**
+		 * Return capability of the managed dataspace
+		 */
+		Dataspace_capability cap() const { return _ds; }
+
+		/**
+		 * Return size of the range in bytes
+		 */
+		size_t size() const { return _size; }
+};
+
+#endif /* _INCLUDE__OS__DATASPACE_SLICE_H_ */
@@ -17,6 +17,7 @@
 
 #include <base/allocator.h>
 #include <util/bit_array.h>
+#include <util/misc_math.h>
 
 namespace Genode { class Packet_allocator; }
 
@@ -26,17 +27,31 @@ namespace Genode { class Packet_allocator; }
  * packet stream interface. It uses a minimal block size, which is the
  * granularity packets will be allocated with. As backend, it uses a
  * simple bit array to manage free, and allocated blocks.
+ *
+ * Free blocks are searched word by word, skipping completely allocated
+ * words. For each size class of packets (the power of two of the block
+ * count), the allocator remembers where to continue searching. Hence,
+ * packets of the common sizes, e.g., MTU-sized network packets, are
+ * usually found right at the hint.
  */
 class Genode::Packet_allocator : public Genode::Range_allocator
 {
 	private:
 
+		enum {
+			BITS_PER_WORD    = sizeof(addr_t)*8,
+			NUM_SIZE_CLASSES = 8,
+		};
+
 		Allocator      *_md_alloc;   /* meta-data allocator                 */
 		size_t          _block_size; /* granularity of packet allocations   */
-		void           *_bits;       /* memory chunk containing the bits    */
+		addr_t         *_bits;       /* memory chunk containing the bits    */
 		Bit_array_base *_array;      /* bit array managing available blocks */
 		addr_t          _base;       /* allocation base                     */
-		addr_t          _next;       /* next free bit index                 */
+		addr_t          _num_blocks; /* number of managed blocks            */
+
+		/* block index where to continue searching, per size class */
+		addr_t _next[NUM_SIZE_CLASSES];
 
 		/*
 		 * Returns the count of blocks fitting the given size
@@ -47,7 +62,62 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		inline size_t _block_cnt(size_t bytes)
 		{
 			bytes /= _block_size;
-			return bytes - (bytes % (sizeof(addr_t)*8));
+			return bytes - (bytes % BITS_PER_WORD);
+		}
+
+		/**
+		 * Return number of blocks needed for a packet of 'size' bytes
+		 */
+		addr_t _packet_blocks(size_t size) const {
+			return (size + _block_size - 1) / _block_size; }
+
+		static unsigned _size_class(addr_t cnt)
+		{
+			unsigned c = 0;
+			for (; c < NUM_SIZE_CLASSES - 1 && (cnt >> (c + 1)); c++);
+			return c;
+		}
+
+		/**
+		 * Find 'cnt' consecutive free blocks within [from, to)
+		 *
+		 * \return index of first block, or 'to' if no such range exists
+		 */
+		addr_t _find_free(addr_t from, addr_t to, addr_t cnt) const
+		{
+			addr_t i = from;
+			while (i + cnt <= to) {
+
+				/* skip to next free block, treating blocks below 'i' as used */
+				addr_t const offset = i % BITS_PER_WORD;
+				addr_t const used   = _bits[i / BITS_PER_WORD]
+				                    | ((1UL << offset) - 1);
+				if (used == ~0UL) {
+					i += BITS_PER_WORD - offset;
+					continue;
+				}
+				i += __builtin_ctzl(~used) - offset;
+
+				/* measure the free range starting at 'i' */
+				addr_t j = i;
+				while (j < i + cnt && j < to) {
+					addr_t const rest = _bits[j / BITS_PER_WORD]
+					                  >> (j % BITS_PER_WORD);
+					if (!rest) {
+						j += BITS_PER_WORD - j % BITS_PER_WORD;
+						continue;
+					}
+					j += __builtin_ctzl(rest);
+					break;
+				}
+
+				if (j >= i + cnt)
+					return i;
+
+				/* continue searching after the used block at 'j' */
+				i = j;
+			}
+			return to;
 		}
 
 	public:
@@ -60,7 +130,11 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		 */
 		Packet_allocator(Allocator *md_alloc, size_t block_size)
 		: _md_alloc(md_alloc), _block_size(block_size), _bits(0),
-		  _array(nullptr), _base(0) {}
+		  _array(nullptr), _base(0), _num_blocks(0)
+		{
+			for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++)
+				_next[i] = 0;
+		}
 
 
 		/*******************************
@@ -71,11 +145,11 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		{
 			if (_base || _array) return -1;
 
-			_base  = base;
-			_bits  = _md_alloc->alloc(_block_cnt(size)/8);
-			_array = new (_md_alloc) Bit_array_base(_block_cnt(size),
-			                                        (addr_t*)_bits,
-			                                        true);
+			_base       = base;
+			_num_blocks = _block_cnt(size);
+			_bits       = (addr_t *)_md_alloc->alloc(_num_blocks/8);
+			_array      = new (_md_alloc) Bit_array_base(_num_blocks, _bits,
+			                                             true);
 			return 0;
 		}
 
@@ -97,40 +171,39 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 
 		bool alloc(size_t size, void **out_addr) override
 		{
-			addr_t const cnt = (size % _block_size) ? size / _block_size + 1
-			                                        : size / _block_size;
-			addr_t max = ~0UL;
-
-			do {
-				try {
-					/* throws exception if array is accessed outside bounds */
-					for (addr_t i = _next & ~(cnt - 1); i < max; i += cnt) {
-						if (_array->get(i, cnt))
-							continue;
-
-						_array->set(i, cnt);
-						_next = i + cnt;
-						*out_addr = reinterpret_cast<void *>(i * _block_size
-						                                     + _base);
-						return true;
-					}
-				} catch (typename Bit_array_base::Invalid_index_access) { }
-
-				max = _next;
-				_next = 0;
-
-			} while (max != 0);
-
-			return false;
+			addr_t const cnt = _packet_blocks(size);
+			if (!_array || !cnt || cnt > _num_blocks)
+				return false;
+
+			addr_t &next = _next[_size_class(cnt)];
+			if (next >= _num_blocks)
+				next = 0;
+
+			/* search from the hint to the end, then wrap around */
+			addr_t i = _find_free(next, _num_blocks, cnt);
+			if (i == _num_blocks) {
+				addr_t const end = min(next + cnt - 1, _num_blocks);
+				i = _find_free(0, end, cnt);
+				if (i == end)
+					return false;
+			}
+
+			_array->set(i, cnt);
+			next = i + cnt;
+			*out_addr = reinterpret_cast<void *>(i * _block_size + _base);
+			return true;
 		}
 
 		void free(void *addr, size_t size) override
 		{
 			addr_t i   = (((addr_t)addr) - _base) / _block_size;
-			size_t cnt = (size % _block_size) ? size / _block_size + 1
-			                                  : size / _block_size;
-			try { _array->clear(i, cnt); } catch(...) { }
-			_next = i;
+			size_t cnt = _packet_blocks(size);
+			try { _array->clear(i, cnt); } catch(...) { return; }
+
+			/* the freed range satisfies packets of the same or smaller size */
+			for (unsigned c = 0; c <= _size_class(cnt); c++)
+				if (i < _next[c])
+					_next[c] = i;
 		}
 
 
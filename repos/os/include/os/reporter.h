@@ -18,6 +18,7 @@
 #include <os/attached_dataspace.h>
 #include <report_session/connection.h>
 #include <util/xml_generator.h>
+#include <base/printf.h>
 
 
 namespace Genode { class Reporter; }
@@ -33,7 +34,7 @@ class Genode::Reporter : Noncopyable
 
 		Name const _name;
 
-		size_t const _buffer_size;
+		size_t _buffer_size;
 
 		bool _enabled = false;
 
@@ -58,6 +59,49 @@ class Genode::Reporter : Noncopyable
 		 */
 		char *_base() { return _enabled ? _conn->ds.local_addr<char>() : 0; }
 
+		/**
+		 * Re-open report session with a buffer of at least 'size' bytes
+		 */
+		bool _enlarge(size_t size)
+		{
+			if (!_enabled)
+				return false;
+
+			size_t const old_size = _buffer_size;
+
+			/* leave headroom for growing reports */
+			_buffer_size = align_addr(size + size/4, 12);
+
+			/* the report server permits only one session per label */
+			_conn.destruct();
+			try {
+				_conn.construct(_name.string(), _buffer_size);
+				return true;
+			} catch (...) { }
+
+			PWRN("could not enlarge buffer of report \"%s\" to %zu bytes",
+			     _name.string(), _buffer_size);
+
+			_buffer_size = old_size;
+			_conn.construct(_name.string(), _buffer_size);
+			return false;
+		}
+
+		/**
+		 * Report buffer as used by 'Xml_generator'
+		 */
+		struct Buffer : Genode::Xml_generator::Resizable_buffer
+		{
+			Reporter &reporter;
+
+			Buffer(Reporter &reporter) : reporter(reporter) { }
+
+			char  *base()            override { return reporter._base(); }
+			size_t size()            override { return reporter._size(); }
+			bool   resize(size_t sz) override { return reporter._enlarge(sz); }
+
+		} _buffer { *this };
+
 	public:
 
 		Reporter(char const *report_name, size_t buffer_size = 4096)
@@ -106,14 +150,17 @@ class Genode::Reporter : Noncopyable
 
 		/**
 		 * XML generator targeting a reporter
+		 *
+		 * If the report exceeds the buffer of the report session, the
+		 * session is re-opened with a sufficiently large buffer and the
+		 * report is generated a second time.
 		 */
 		struct Xml_generator : public Genode::Xml_generator
 		{
 			template <typename FUNC>
 			Xml_generator(Reporter &reporter, FUNC const &func)
 			:
-				Genode::Xml_generator(reporter._base(),
-				                      reporter._size(),
+				Genode::Xml_generator(reporter._buffer,
 				                      reporter._name.string(),
 				                      func)
 			{
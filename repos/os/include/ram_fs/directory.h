@@ -22,7 +22,12 @@
 #include <ram_fs/file.h>
 #include <ram_fs/symlink.h>
 
-namespace File_system { class Directory; }
+namespace File_system {
+
+	class Directory;
+
+	Status node_status(Node &);
+}
 
 
 class File_system::Directory : public Node
@@ -216,6 +221,42 @@ class File_system::Directory : public Node
 			return sizeof(Directory_entry);
 		}
 
+		/**
+		 * Read directory entries along with the status of each entry
+		 *
+		 * In contrast to 'read', as many entries as fit into 'dst' are
+		 * returned.
+		 */
+		size_t read_status(char *dst, size_t len, seek_off_t seek_offset)
+		{
+			if (seek_offset % sizeof(Directory_entry_status)) {
+				PERR("seek offset not aligned to sizeof(Directory_entry_status)");
+				return 0;
+			}
+
+			Node *node = entry_unsynchronized(seek_offset / sizeof(Directory_entry_status));
+
+			size_t res_length = 0;
+			for (; node && len - res_length >= sizeof(Directory_entry_status);
+			     node = node->next()) {
+
+				Directory_entry_status e;
+
+				e.entry.type = Directory_entry::TYPE_FILE;
+				if (dynamic_cast<Directory *>(node)) e.entry.type = Directory_entry::TYPE_DIRECTORY;
+				if (dynamic_cast<Symlink   *>(node)) e.entry.type = Directory_entry::TYPE_SYMLINK;
+
+				strncpy(e.entry.name, node->name(), sizeof(e.entry.name));
+
+				e.status = node_status(*node);
+
+				/* the packet payload is not necessarily aligned */
+				memcpy(dst + res_length, &e, sizeof(e));
+				res_length += sizeof(e);
+			}
+			return res_length;
+		}
+
 		size_t write(char const *src, size_t len, seek_off_t seek_offset)
 		{
 			/* writing to directory nodes is not supported */
@@ -225,4 +266,36 @@ class File_system::Directory : public Node
 		size_t num_entries() const { return _num_entries; }
 };
 
+
+/**
+ * Return status of file, directory, or symlink node
+ */
+inline File_system::Status File_system::node_status(Node &node)
+{
+	Status s;
+	s.inode = node.inode();
+	s.size  = 0;
+	s.mode  = 0;
+
+	File *file = dynamic_cast<File *>(&node);
+	if (file) {
+		s.size = file->length();
+		s.mode = File_system::Status::MODE_FILE;
+		return s;
+	}
+	Directory *dir = dynamic_cast<Directory *>(&node);
+	if (dir) {
+		s.size = dir->num_entries()*sizeof(Directory_entry);
+		s.mode = File_system::Status::MODE_DIRECTORY;
+		return s;
+	}
+	Symlink *symlink = dynamic_cast<Symlink *>(&node);
+	if (symlink) {
+		s.size = symlink->length();
+		s.mode = File_system::Status::MODE_SYMLINK;
+		return s;
+	}
+	return Status();
+}
+
 #endif /* _INCLUDE__RAM_FS__DIRECTORY_H_ */
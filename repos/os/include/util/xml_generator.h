@@ -28,14 +28,42 @@ class Genode::Xml_generator
 		/**
 		 * Exception type
 		 */
-		class Buffer_exceeded { };
+		class Buffer_exceeded
+		{
+			public:
+
+				/**
+				 * Buffer size needed for the complete output
+				 */
+				size_t const required;
+
+				Buffer_exceeded(size_t required = 0) : required(required) { }
+		};
+
+		/**
+		 * Interface of an output buffer that can be enlarged on demand
+		 */
+		struct Resizable_buffer
+		{
+			virtual char  *base() = 0;
+			virtual size_t size() = 0;
+
+			/**
+			 * Enlarge buffer to at least 'size' bytes
+			 *
+			 * \return  false if the buffer cannot be enlarged
+			 */
+			virtual bool resize(size_t size) = 0;
+		};
 
 	private:
 
 		/**
 		 * Buffer descriptor where the XML output goes to
 		 *
-		 * All 'append' methods may throw a 'Buffer_exceeded' exception.
+		 * Output that exceeds the capacity of the buffer is not written but
+		 * accounted as used. This way, the size needed for the complete
+		 * output is known after a single pass.
 		 */
 		class Out_buffer
 		{
@@ -45,42 +73,48 @@ class Genode::Xml_generator
 				size_t _capacity;
 				size_t _used = 0;
 
-				void _check_advance(size_t const len) const {
-					if (_used + len > _capacity)
-						throw Buffer_exceeded(); }
+				/**
+				 * Return number of bytes of 'len' that fit into the buffer
+				 */
+				size_t _fitting(size_t const len) const {
+					return _used < _capacity ? min(len, _capacity - _used) : 0; }
 
 			public:
 
 				Out_buffer(char *dst, size_t capacity)
 				: _dst(dst), _capacity(capacity) { }
 
-				void advance(size_t const len)
-				{
-					_check_advance(len);
-					_used += len;
-				}
+				void advance(size_t const len) { _used += len; }
 
 				/**
 				 * Append character
 				 */
 				void append(char const c)
 				{
-					_check_advance(1);
-					_dst[_used] = c;
+					if (_used < _capacity)
+						_dst[_used] = c;
 					advance(1);
 				}
 
 				/**
 				 * Append character 'n' times
 				 */
-				void append(char const c, size_t n) {
-					for (; n--; append(c)); }
+				void append(char const c, size_t n)
+				{
+					if (size_t const len = _fitting(n))
+						memset(_dst + _used, c, len);
+					advance(n);
+				}
 
 				/**
 				 * Append character buffer
 				 */
-				void append(char const *src, size_t len) {
-					for (; len--; append(*src++)); }
+				void append(char const *src, size_t len)
+				{
+					if (size_t const n = _fitting(len))
+						memcpy(_dst + _used, src, n);
+					advance(len);
+				}
 
 				/**
 				 * Append null-terminated string
@@ -108,14 +142,33 @@ class Genode::Xml_generator
 				 */
 				void append_sanitized(char const *src, size_t len)
 				{
-					for (; len--; append_sanitized(*src++));
+					auto needs_sanitizing = [] (char const c) {
+						return c == 0 || c == '>' || c == '<' || c == '&'
+						    || c == '"' || c == '\''; };
+
+					while (len) {
+
+						/* append run of characters that need no sanitizing */
+						size_t n = 0;
+						for (; n < len && !needs_sanitizing(src[n]); n++);
+						append(src, n);
+						src += n; len -= n;
+
+						if (len) {
+							append_sanitized(*src++);
+							len--;
+						}
+					}
 				}
 
 				/**
 				 * Return unused part of the buffer
 				 */
-				Out_buffer remainder() const {
-					return Out_buffer(_dst + _used, _capacity - _used); }
+				Out_buffer remainder() const
+				{
+					size_t const used = min(_used, _capacity);
+					return Out_buffer(_dst + used, _capacity - used);
+				}
 
 				/**
 				 * Insert gap into already populated part of the buffer
@@ -126,27 +179,48 @@ class Genode::Xml_generator
 				{
 					/* don't allow the insertion into non-populated part */
 					if (at > _used)
-						return Out_buffer(_dst + at, 0);
+						return Out_buffer(_dst + min(at, _capacity), 0);
+
+					/* account the gap only if the content does not fit */
+					if (_used + len > _capacity) {
+						advance(len);
+						return Out_buffer(_dst + min(at, _capacity), 0);
+					}
 
-					_check_advance(len);
 					memmove(_dst + at + len, _dst + at, _used - at);
 					advance(len);
 
 					return Out_buffer(_dst + at, len);
 				}
 
+				/**
+				 * Write null termination behind the used part if possible
+				 *
+				 * The termination is not accounted as used.
+				 */
+				void terminate()
+				{
+					if (_used < _capacity)
+						_dst[_used] = 0;
+				}
+
+				bool exceeded() const { return _used > _capacity; }
+
 				bool has_trailing_newline() const
 				{
-					return (_used > 1) && (_dst[_used - 1] == '\n');
+					return (_used > 1) && !exceeded() && (_dst[_used - 1] == '\n');
 				}
 
 				/**
-				 * Return number of unused bytes of the buffer
+				 * Return number of used bytes, including the exceeding ones
 				 */
 				size_t used() const { return _used; }
 
 				void discard_trailing_whitespace()
 				{
+					if (exceeded())
+						return;
+
 					for (; _used > 0 && is_whitespace(_dst[_used - 1]); _used--);
 				}
 		};
@@ -209,6 +283,21 @@ class Genode::Xml_generator
 
 				void insert_attribute(char const *name, char const *value)
 				{
+					/*
+					 * As long as the start tag is open, the attribute is
+					 * appended to the output directly.
+					 */
+					if (!_has_content) {
+						_out_buffer.append(' ');
+						_out_buffer.append(name);
+						_out_buffer.append("=\"");
+						_out_buffer.append(value);
+						_out_buffer.append("\"");
+
+						_attr_offset = _out_buffer.used();
+						return;
+					}
+
 					/* ' ' + name + '=' + '"' + value + '"' */
 					size_t const gap = 1 + strlen(name) + 1 + 1 + strlen(value) + 1;
 
@@ -276,8 +365,6 @@ class Genode::Xml_generator
 						_parent_node->_commit_content(_out_buffer);
 					else
 						xml._out_buffer = _out_buffer;
-
-					_out_buffer.append('\0');
 				}
 		};
 
@@ -285,18 +372,70 @@ class Genode::Xml_generator
 		Node      *_curr_node   = 0;
 		unsigned   _curr_indent = 0;
 
+		template <typename FUNC>
+		void _generate(char *dst, size_t dst_len,
+		               char const *name, FUNC const &func)
+		{
+			_out_buffer = Out_buffer(dst, dst_len);
+
+			node(name, func);
+			_out_buffer.append('\n');
+			_out_buffer.terminate();
+		}
+
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \throw Buffer_exceeded  the output does not fit into 'dst', the
+		 *                         exception carries the required size
+		 */
 		template <typename FUNC>
 		Xml_generator(char *dst, size_t dst_len,
 		              char const *name, FUNC const &func)
 		:
 			_out_buffer(dst, dst_len)
 		{
-			if (dst) {
-				node(name, func);
-				_out_buffer.append('\n');
-			}
+			if (!dst)
+				return;
+
+			_generate(dst, dst_len, name, func);
+
+			if (_out_buffer.exceeded())
+				throw Buffer_exceeded(used());
+		}
+
+		/**
+		 * Constructor
+		 *
+		 * If the output does not fit into the buffer, the buffer is enlarged
+		 * to the required size and 'func' is called a second time.
+		 *
+		 * \throw Buffer_exceeded  the buffer cannot be enlarged
+		 */
+		template <typename FUNC>
+		Xml_generator(Resizable_buffer &buffer,
+		              char const *name, FUNC const &func)
+		:
+			_out_buffer(buffer.base(), buffer.size())
+		{
+			if (!buffer.base())
+				return;
+
+			_generate(buffer.base(), buffer.size(), name, func);
+
+			if (!_out_buffer.exceeded())
+				return;
+
+			/* the null termination is not accounted as used */
+			if (!buffer.resize(used() + 1))
+				throw Buffer_exceeded(used());
+
+			_generate(buffer.base(), buffer.size(), name, func);
+
+			if (_out_buffer.exceeded())
+				throw Buffer_exceeded(used());
 		}
 
 		template <typename FUNC>
@@ -276,6 +276,19 @@ class Vfs::Dir_file_system : public File_system
 				fs->release(path, ds_cap);
 		}
 
+		bool dataspace_shared(char const *path) override
+		{
+			path = _sub_path(path);
+			if (!path)
+				return false;
+
+			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+				if (fs->dataspace_shared(path))
+					return true;
+
+			return false;
+		}
+
 		Stat_result stat(char const *path, Stat &out) override
 		{
 			path = _sub_path(path);
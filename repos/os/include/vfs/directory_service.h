@@ -27,6 +27,14 @@ struct Vfs::Directory_service
 	virtual Dataspace_capability dataspace(char const *path) = 0;
 	virtual void release(char const *path, Dataspace_capability) = 0;
 
+	/**
+	 * Return true if 'dataspace' hands out the file content without copying
+	 *
+	 * Such dataspaces are cheap to obtain and may be shared among all users
+	 * of the file, e.g., when mapping the file into memory.
+	 */
+	virtual bool dataspace_shared(char const *path) { return false; }
+
 
 	enum General_error { ERR_FD_INVALID, NUM_GENERAL_ERRORS };
 
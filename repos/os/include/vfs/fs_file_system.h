@@ -46,6 +46,80 @@ class Vfs::Fs_file_system : public File_system
 
 		::File_system::Connection _fs;
 
+		/*
+		 * Not all servers support the 'STATUS', 'CLOSE', and
+		 * 'READ_DIR_STATUS' packet operations. Once a packet failed while
+		 * the equivalent request succeeded, the packet operation is not
+		 * tried again for the session.
+		 */
+		bool _status_packets_supported     = true;
+		bool _dir_status_packets_supported = true;
+
+		/**
+		 * Directory entries and their status obtained at once from the server
+		 *
+		 * A directory traversal calls 'dirent' for each index, often
+		 * followed by 'stat' for the entry. Both are served from the cache.
+		 * The status of each entry is handed out only once to limit the use
+		 * of outdated information. The cache is flushed on each modification
+		 * performed via this file system and at the start of each traversal.
+		 */
+		struct Dir_cache
+		{
+			enum { MAX_ENTRIES = 32 };
+
+			Absolute_path path;
+			file_offset   first = 0;      /* index of first cached entry */
+			unsigned      num   = 0;      /* number of cached entries */
+			bool          end   = false;  /* entries reach end of directory */
+			bool          valid = false;
+
+			::File_system::Directory_entry_status entries[MAX_ENTRIES];
+			bool                                  status_valid[MAX_ENTRIES];
+
+			void invalidate() { valid = false; }
+
+			bool covers(Absolute_path const &dir, file_offset index) const
+			{
+				return valid && path.equals(dir) && index >= first
+				    && (end || index < first + num);
+			}
+
+			::File_system::Directory_entry const *entry(file_offset index) const
+			{
+				return index < first + num ? &entries[index - first].entry : 0;
+			}
+
+			/**
+			 * Return status of the node at 'node_path' if cached
+			 */
+			bool status(char const *node_path, ::File_system::Status &out)
+			{
+				if (!valid)
+					return false;
+
+				Absolute_path dir(node_path);
+				dir.strip_last_element();
+				dir.remove_trailing('/');
+
+				if (!path.equals(dir))
+					return false;
+
+				Absolute_path name(node_path);
+				name.keep_only_last_element();
+
+				for (unsigned i = 0; i < num; i++)
+					if (status_valid[i]
+					 && strcmp(entries[i].entry.name, name.base() + 1) == 0) {
+						status_valid[i] = false;
+						out = entries[i].status;
+						return true;
+					}
+
+				return false;
+			}
+		} _dir_cache;
+
 		class Fs_vfs_handle : public Vfs_handle
 		{
 			private:
@@ -150,6 +224,129 @@ class Vfs::Fs_file_system : public File_system
 			return count;
 		}
 
+		/**
+		 * Fill directory cache with the entries starting at 'index'
+		 *
+		 * \return false if the request failed, e.g., because the server does
+		 *         not support 'READ_DIR_STATUS'
+		 */
+		bool _read_dir_status(Absolute_path const &path, file_offset index)
+		{
+			typedef ::File_system::Packet_descriptor      Packet_descriptor;
+			typedef ::File_system::Directory_entry_status Entry;
+
+			_dir_cache.invalidate();
+
+			if (!_dir_status_packets_supported)
+				return false;
+
+			::File_system::Session::Tx::Source &source = *_fs.tx();
+
+			::File_system::Dir_handle dir_handle = _fs.dir(path.base(), false);
+			Fs_handle_guard dir_guard(_fs, dir_handle);
+
+			file_size const max_len = sizeof(Entry)*Dir_cache::MAX_ENTRIES;
+
+			Packet_descriptor const
+				packet_in(source.alloc_packet(max_len),
+				          dir_handle,
+				          Packet_descriptor::READ_DIR_STATUS,
+				          max_len,
+				          index*sizeof(Entry));
+
+			source.submit_packet(packet_in);
+			Packet_descriptor const packet_out = source.get_acked_packet();
+
+			bool const succeeded = packet_out.succeeded()
+			                    && packet_out.length() <= max_len;
+			if (succeeded) {
+				_dir_cache.path.import(path.base());
+				_dir_cache.first = index;
+				_dir_cache.num   = packet_out.length() / sizeof(Entry);
+				_dir_cache.end   = _dir_cache.num < Dir_cache::MAX_ENTRIES;
+				_dir_cache.valid = true;
+
+				memcpy(_dir_cache.entries, source.packet_content(packet_out),
+				       _dir_cache.num*sizeof(Entry));
+
+				for (unsigned i = 0; i < _dir_cache.num; i++)
+					_dir_cache.status_valid[i] = true;
+			}
+
+			source.release_packet(packet_out);
+			return succeeded;
+		}
+
+		/**
+		 * Obtain status of the node at 'path'
+		 *
+		 * The status request and the release of the node handle are
+		 * submitted together via the packet stream, which saves two RPCs.
+		 * If the server fails the request, e.g., because it does not support
+		 * the operation, the status is obtained via RPC instead and the
+		 * packet operations are no longer used.
+		 *
+		 * \throw Lookup_failed
+		 * \throw Out_of_node_handles
+		 */
+		::File_system::Status _status(char const *path)
+		{
+			typedef ::File_system::Packet_descriptor Packet_descriptor;
+
+			::File_system::Status status;
+			if (_dir_cache.status(path, status))
+				return status;
+
+			if (!_status_packets_supported) {
+				::File_system::Node_handle node = _fs.node(path);
+				Fs_handle_guard node_guard(_fs, node);
+				return _fs.status(node);
+			}
+
+			::File_system::Node_handle node = _fs.node(path);
+
+			::File_system::Session::Tx::Source &source = *_fs.tx();
+
+			source.submit_packet(Packet_descriptor(source.alloc_packet(sizeof(status)),
+			                                       node, Packet_descriptor::STATUS,
+			                                       sizeof(status)));
+
+			/* the close operation carries no payload */
+			source.submit_packet(Packet_descriptor(Packet_descriptor(), node,
+			                                       Packet_descriptor::CLOSE, 0));
+
+			bool status_ok = false, closed = false;
+			for (unsigned i = 0; i < 2; i++) {
+
+				Packet_descriptor const packet = source.get_acked_packet();
+
+				if (packet.operation() == Packet_descriptor::CLOSE) {
+					closed = packet.succeeded();
+					continue;
+				}
+
+				status_ok = packet.succeeded() && packet.length() == sizeof(status);
+				if (status_ok)
+					memcpy(&status, source.packet_content(packet), sizeof(status));
+
+				source.release_packet(packet);
+			}
+
+			if (!closed)
+				_fs.close(node);
+
+			if (status_ok)
+				return status;
+
+			node = _fs.node(path);
+			Fs_handle_guard node_guard(_fs, node);
+			status = _fs.status(node);
+
+			/* the server lacks support for the packet operations */
+			_status_packets_supported = false;
+			return status;
+		}
+
 	public:
 
 		Fs_file_system(Xml_node config)
@@ -247,12 +444,12 @@ class Vfs::Fs_file_system : public File_system
 
 		Stat_result stat(char const *path, Stat &out) override
 		{
+			Lock::Guard guard(_lock);
+
 			::File_system::Status status;
 
 			try {
-				::File_system::Node_handle node = _fs.node(path);
-				Fs_handle_guard node_guard(_fs, node);
-				status = _fs.status(node);
+				status = _status(path);
 			} catch (...) {
 				if (verbose)
 					PDBG("stat failed for path '%s'", path);
@@ -284,6 +481,40 @@ class Vfs::Fs_file_system : public File_system
 			if (strcmp(path, "") == 0)
 				path = "/";
 
+			typedef ::File_system::Directory_entry Directory_entry;
+
+			Absolute_path dir_path(path);
+			dir_path.remove_trailing('/');
+
+			/*
+			 * A traversal starting at index 0 obtains up-to-date entries. If
+			 * the request fails, the entry is read via a 'READ' packet below.
+			 */
+			bool dir_status_failed = false;
+			if (index == 0 || !_dir_cache.covers(dir_path, index))
+				dir_status_failed = !_read_dir_status(dir_path, index);
+
+			if (_dir_cache.covers(dir_path, index)) {
+
+				Directory_entry const *entry = _dir_cache.entry(index);
+
+				out.fileno = index + 1;
+				out.type   = DIRENT_TYPE_END;
+				out.name[0] = 0;
+
+				if (!entry)
+					return DIRENT_OK;
+
+				switch (entry->type) {
+				case Directory_entry::TYPE_DIRECTORY: out.type = DIRENT_TYPE_DIRECTORY; break;
+				case Directory_entry::TYPE_FILE:      out.type = DIRENT_TYPE_FILE;      break;
+				case Directory_entry::TYPE_SYMLINK:   out.type = DIRENT_TYPE_SYMLINK;   break;
+				}
+
+				strncpy(out.name, entry->name, sizeof(out.name));
+				return DIRENT_OK;
+			}
+
 			::File_system::Dir_handle dir_handle = _fs.dir(path, false);
 			Fs_handle_guard dir_guard(_fs, dir_handle);
 
@@ -298,15 +529,16 @@ class Vfs::Fs_file_system : public File_system
 
 			/* pass packet to server side */
 			source.submit_packet(packet);
-			source.get_acked_packet();
+
+			/* the server lacks support for the 'READ_DIR_STATUS' operation */
+			if (source.get_acked_packet().succeeded() && dir_status_failed)
+				_dir_status_packets_supported = false;
 
 			/*
 			 * XXX check if acked packet belongs to request,
 			 *     needed for thread safety
 			 */
 
-			typedef ::File_system::Directory_entry Directory_entry;
-
 			/* copy-out payload into destination buffer */
 			Directory_entry const *entry =
 				(Directory_entry *)source.packet_content(packet);
@@ -336,6 +568,10 @@ class Vfs::Fs_file_system : public File_system
 
 		Unlink_result unlink(char const *path) override
 		{
+			Lock::Guard guard(_lock);
+
+			_dir_cache.invalidate();
+
 			Absolute_path dir_path(path);
 			dir_path.strip_last_element();
 			dir_path.remove_trailing('/');
@@ -387,6 +623,10 @@ class Vfs::Fs_file_system : public File_system
 
 		Rename_result rename(char const *from_path, char const *to_path) override
 		{
+			Lock::Guard guard(_lock);
+
+			_dir_cache.invalidate();
+
 			Absolute_path from_dir_path(from_path);
 			from_dir_path.strip_last_element();
 			from_dir_path.remove_trailing('/');
@@ -418,6 +658,10 @@ class Vfs::Fs_file_system : public File_system
 
 		Mkdir_result mkdir(char const *path, unsigned mode) override
 		{
+			Lock::Guard guard(_lock);
+
+			_dir_cache.invalidate();
+
 			/*
 			 * Canonicalize path (i.e., path must start with '/')
 			 */
@@ -444,6 +688,8 @@ class Vfs::Fs_file_system : public File_system
 			 */
 			Lock::Guard guard(_lock);
 
+			_dir_cache.invalidate();
+
 			/*
 			 * Canonicalize path (i.e., path must start with '/')
 			 */
@@ -477,32 +723,25 @@ class Vfs::Fs_file_system : public File_system
 
 		file_size num_dirent(char const *path) override
 		{
+			Lock::Guard guard(_lock);
+
 			if (strcmp(path, "") == 0)
 				path = "/";
 
 			/*
 			 * XXX handle more exceptions
 			 */
-			::File_system::Node_handle node;
-			try { node = _fs.node(path); } catch (::File_system::Lookup_failed) { return 0; }
-
-			Fs_handle_guard node_guard(_fs, node);
-
-			::File_system::Status status = _fs.status(node);
+			::File_system::Status status;
+			try { status = _status(path); } catch (::File_system::Lookup_failed) { return 0; }
 
 			return status.size / sizeof(::File_system::Directory_entry);
 		}
 
 		bool is_directory(char const *path) override
 		{
-			try {
-				::File_system::Node_handle node = _fs.node(path);
-				Fs_handle_guard node_guard(_fs, node);
-
-				::File_system::Status status = _fs.status(node);
+			Lock::Guard guard(_lock);
 
-				return status.is_directory();
-			}
+			try { return _status(path).is_directory(); }
 			catch (...) { return false; }
 		}
 
@@ -540,9 +779,12 @@ class Vfs::Fs_file_system : public File_system
 
 			bool const create = vfs_mode & OPEN_MODE_CREATE;
 
-			if (create)
+			if (create) {
+				_dir_cache.invalidate();
+
 				if (verbose)
 					PDBG("creation of file %s requested", file_name.base() + 1);
+			}
 
 			try {
 				::File_system::Dir_handle dir = _fs.dir(dir_path.base(), false);
@@ -590,6 +832,8 @@ class Vfs::Fs_file_system : public File_system
 		{
 			Lock::Guard guard(_lock);
 
+			_dir_cache.invalidate();
+
 			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
 
 			out_count = _write(handle->file_handle(), buf, buf_size, handle->seek());
@@ -619,6 +863,10 @@ class Vfs::Fs_file_system : public File_system
 
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
 		{
+			Lock::Guard guard(_lock);
+
+			_dir_cache.invalidate();
+
 			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
 
 			try {
@@ -78,9 +78,22 @@ class Vfs::Rom_file_system : public Single_file_system
 		}
 
 
-		/********************************
-		 ** File I/O service interface **
-		 ********************************/
+		/*
+		 * The ROM dataspace is handed out directly such that all clients
+		 * that map the same ROM module share its pages.
+		 */
+		Dataspace_capability dataspace(char const *path) override
+		{
+			if (!_is_single_file(path))
+				return Dataspace_capability();
+
+			return _rom.is_valid() ? _rom.cap() : Dataspace_capability();
+		}
+
+		void release(char const *, Dataspace_capability) override { }
+
+		bool dataspace_shared(char const *path) override {
+			return _is_single_file(path); }
 
 		Stat_result stat(char const *path, Stat &out) override
 		{
@@ -33,6 +33,8 @@ class Vfs::Single_file_system : public File_system
 		enum { FILENAME_MAX_LEN = 64 };
 		char _filename[FILENAME_MAX_LEN];
 
+	protected:
+
 		bool _is_root(const char *path)
 		{
 			return (strcmp(path, "") == 0) || (strcmp(path, "/") == 0);
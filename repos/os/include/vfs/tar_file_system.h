@@ -15,6 +15,7 @@
 #define _INCLUDE__VFS__TAR_FILE_SYSTEM_H_
 
 #include <rom_session/connection.h>
+#include <os/dataspace_slice.h>
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 
@@ -124,57 +125,23 @@ class Vfs::Tar_file_system : public File_system
 
 	struct Node : List<Node>, List<Node>::Element
 	{
-		char const *name;
+		char const *path;       /* canonical absolute path */
+		char const *name;       /* last path element, points into 'path' */
 		Record const *record;
+		Node *hash_next = 0;    /* chain of the node index */
 
-		Node(char const *name, Record const *record) : name(name), record(record) { }
-
-		Node *lookup(char const *name)
+		static char const *_last_element(char const *path)
 		{
-			Absolute_path lookup_path(name);
-
-			if (verbose)
-				PDBG("lookup_path = %s", lookup_path.base());
-
-			Node *parent_node = this;
-			Node *child_node;
-
-			Path_element_token t(lookup_path.base());
-
-			while (t) {
-
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
-
-				char path_element[MAX_PATH_LEN];
-
-				t.string(path_element, sizeof(path_element));
-
-				if (verbose)
-					PDBG("path_element = %s", path_element);
-
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (verbose)
-						PDBG("comparing with node %s", child_node->name);
-					if (strcmp(child_node->name, path_element) == 0) {
-						if (verbose)
-							PDBG("found matching child node");
-						parent_node = child_node;
-						break;
-					}
-				}
-
-				if (!child_node)
-					return 0;
-
-				t = t.next();
-			}
-
-			return parent_node;
+			char const *result = path;
+			for (; *path; path++)
+				if (path[0] == '/')
+					result = path + 1;
+			return result;
 		}
 
+		Node(char const *path, Record const *record)
+		: path(path), name(_last_element(path)), record(record) { }
+
 
 		Node *lookup_child(int index)
 		{
@@ -197,6 +164,80 @@ class Vfs::Tar_file_system : public File_system
 	} _root_node;
 
 
+	/**
+	 * Hash table of all nodes keyed by their canonical absolute path
+	 *
+	 * The index avoids walking the sibling lists of each path element for
+	 * path lookups, which becomes costly for archives with many files.
+	 */
+	class Node_index
+	{
+		private:
+
+			Node   **_buckets     = 0;
+			unsigned _num_buckets = 0;
+
+			static unsigned _hash(char const *path)
+			{
+				unsigned h = 5381;
+				for (; *path; path++)
+					h = ((h << 5) + h) ^ (unsigned char)*path;
+				return h;
+			}
+
+			Node *&_bucket(char const *path) {
+				return _buckets[_hash(path) & (_num_buckets - 1)]; }
+
+		public:
+
+			/**
+			 * Allocate bucket array dimensioned for 'num_nodes' nodes
+			 */
+			void init(unsigned num_nodes)
+			{
+				for (_num_buckets = 1; _num_buckets < num_nodes; _num_buckets <<= 1);
+
+				Genode::size_t const size = sizeof(Node *)*_num_buckets;
+				_buckets = (Node **)env()->heap()->alloc(size);
+				memset(_buckets, 0, size);
+			}
+
+			void insert(Node &node)
+			{
+				Node *&head = _bucket(node.path);
+				node.hash_next = head;
+				head = &node;
+			}
+
+			/**
+			 * Look up node by canonical path without trailing slash
+			 */
+			Node *lookup(char const *path)
+			{
+				for (Node *node = _bucket(path); node; node = node->hash_next)
+					if (strcmp(node->path, path) == 0)
+						return node;
+				return 0;
+			}
+
+	} _node_index;
+
+
+	/**
+	 * Look up node for the given path
+	 */
+	Node *_lookup(char const *path)
+	{
+		Absolute_path lookup_path(path);
+		lookup_path.remove_trailing('/');
+
+		if (verbose)
+			PDBG("lookup_path = %s", lookup_path.base());
+
+		return _node_index.lookup(lookup_path.base());
+	}
+
+
 	/*
 	 *  Create a Node for a tar record and insert it into the node list
 	 */
@@ -204,11 +245,30 @@ class Vfs::Tar_file_system : public File_system
 	{
 		private:
 
-			Node &_root_node;
+			Node       &_root_node;
+			Node_index &_node_index;
+
+			Node &_create_node(Node &parent_node, char const *path,
+			                   Record const *record)
+			{
+				/*
+				 * TODO: find 'path' in 'record->name' and use the location
+				 * in the record as name pointer to save some memory
+				 */
+				Genode::size_t path_size = strlen(path) + 1;
+				char *node_path = (char*)env()->heap()->alloc(path_size);
+				strncpy(node_path, path, path_size);
+
+				Node *node = new (env()->heap()) Node(node_path, record);
+				parent_node.insert(node);
+				_node_index.insert(*node);
+				return *node;
+			}
 
 		public:
 
-			Add_node_action(Node &root_node) : _root_node(root_node) { }
+			Add_node_action(Node &root_node, Node_index &node_index)
+			: _root_node(root_node), _node_index(node_index) { }
 
 			void operator()(Record const *record)
 			{
@@ -222,7 +282,9 @@ class Vfs::Tar_file_system : public File_system
 				Path_element_token t(current_path.base());
 
 				Node *parent_node = &_root_node;
-				Node *child_node;
+
+				/* path of the nodes visited so far */
+				Absolute_path walked_path;
 
 				while(t) {
 
@@ -235,10 +297,10 @@ class Vfs::Tar_file_system : public File_system
 
 					t.string(path_element, sizeof(path_element));
 
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
+					walked_path.append("/");
+					walked_path.append(path_element);
+
+					Node *child_node = _node_index.lookup(walked_path.base());
 
 					if (child_node) {
 
@@ -257,27 +319,15 @@ class Vfs::Tar_file_system : public File_system
 							if (verbose)
 								PDBG("creating node for %s", path_element);
 
-							/*
-							 * TODO: find 'path_element' in 'record->name'
-							 * and use the location in the record as name
-							 * pointer to save some memory
-							 */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)env()->heap()->alloc(name_size);
-							strncpy(name, path_element, name_size);
-							child_node = new (env()->heap()) Node(name, record);
+							child_node = &_create_node(*parent_node, walked_path.base(), record);
 						} else {
 
 							if (verbose)
 								PDBG("creating node without record for %s", path_element);
 
 							/* create a directory node without record */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)env()->heap()->alloc(name_size);
-							strncpy(name, path_element, name_size);
-							child_node = new (env()->heap()) Node(name, 0);
+							child_node = &_create_node(*parent_node, walked_path.base(), 0);
 						}
-						parent_node->insert(child_node);
 					}
 
 					parent_node = child_node;
@@ -322,14 +372,14 @@ class Vfs::Tar_file_system : public File_system
 
 	struct Num_dirent_cache
 	{
-		Lock             lock;
-		Node            &root_node;
-		bool             valid;              /* true after first lookup */
-		char             key[256];           /* key used for lookup */
-		file_size        cached_num_dirent;  /* cached value */
+		Lock               lock;
+		Tar_file_system   &fs;
+		bool               valid;              /* true after first lookup */
+		char               key[256];           /* key used for lookup */
+		file_size          cached_num_dirent;  /* cached value */
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
+		Num_dirent_cache(Tar_file_system &fs)
+		: fs(fs), valid(false), cached_num_dirent(0) { }
 
 		file_size num_dirent(char const *path)
 		{
@@ -337,7 +387,7 @@ class Vfs::Tar_file_system : public File_system
 
 			/* check for cache miss */
 			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
+				Node *node = fs._lookup(path);
 				if (!node)
 					return 0;
 				strncpy(key, path, sizeof(key));
@@ -348,6 +398,21 @@ class Vfs::Tar_file_system : public File_system
 		}
 	} _cached_num_dirent;
 
+	/**
+	 * Dataspace handed out by 'dataspace()' that aliases the archive content
+	 */
+	struct Mapped_record : List<Mapped_record>::Element
+	{
+		Genode::Dataspace_slice slice;
+
+		Mapped_record(Dataspace_capability tar_ds, char const *tar_base,
+		              Genode::off_t offset, Genode::size_t size)
+		: slice(tar_ds, tar_base, offset, size) { }
+	};
+
+	Lock                _mapped_records_lock;
+	List<Mapped_record> _mapped_records;
+
 	/**
 	 * Walk hardlinks until we reach a file
 	 *
@@ -355,7 +420,7 @@ class Vfs::Tar_file_system : public File_system
 	 */
 	Node const *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _lookup(path);
 		if (!node) return 0;
 
 		Record const *record = node->record;
@@ -373,13 +438,19 @@ class Vfs::Tar_file_system : public File_system
 			_tar_ds(_rom.dataspace()),
 			_tar_base(env()->rm_session()->attach(_tar_ds)),
 			_tar_size(Dataspace_client(_tar_ds).size()),
-			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_root_node("/", 0),
+			_cached_num_dirent(*this)
 		{
 			PINF("tar archive '%s' local at %p, size is %llu",
 			     _rom_name.name, _tar_base, _tar_size);
 
-			_for_each_tar_record_do(Add_node_action(_root_node));
+			/* dimension node index, each record usually yields one node */
+			unsigned num_records = 0;
+			_for_each_tar_record_do([&] (Record const *) { num_records++; });
+			_node_index.init(num_records + 1);
+			_node_index.insert(_root_node);
+
+			_for_each_tar_record_do(Add_node_action(_root_node, _node_index));
 		}
 
 
@@ -400,6 +471,26 @@ class Vfs::Tar_file_system : public File_system
 				return Dataspace_capability();
 			}
 
+			/*
+			 * Alias the record content if it is located at a page boundary
+			 * within the archive, which avoids duplicating large files.
+			 */
+			Genode::off_t const offset = (char *)record->data() - _tar_base;
+			if (Genode::Dataspace_slice::worthwhile(offset, record->size())) {
+				try {
+					Mapped_record *mapped = new (env()->heap())
+						Mapped_record(_tar_ds, _tar_base, offset, record->size());
+
+					Lock::Guard guard(_mapped_records_lock);
+					_mapped_records.insert(mapped);
+					return mapped->slice.cap();
+				}
+				catch (...) {
+					if (verbose)
+						PDBG("could not alias \"%s\", fall back to copy", path);
+				}
+			}
+
 			try {
 				Ram_dataspace_capability ds_cap =
 					env()->ram_session()->alloc(record->size());
@@ -415,8 +506,34 @@ class Vfs::Tar_file_system : public File_system
 			return Dataspace_capability();
 		}
 
+		bool dataspace_shared(char const *path) override
+		{
+			Node const *node = dereference(path);
+			if (!node || !node->record)
+				return false;
+
+			Record const *record = node->record;
+			return record->type() == Record::TYPE_FILE
+			    && Genode::Dataspace_slice::worthwhile((char *)record->data()
+			                                           - _tar_base,
+			                                           record->size());
+		}
+
 		void release(char const *, Dataspace_capability ds_cap) override
 		{
+			{
+				Lock::Guard guard(_mapped_records_lock);
+
+				for (Mapped_record *m = _mapped_records.first(); m; m = m->next()) {
+					if (m->slice.cap().local_name() != ds_cap.local_name())
+						continue;
+
+					_mapped_records.remove(m);
+					destroy(env()->heap(), m);
+					return;
+				}
+			}
+
 			env()->ram_session()->free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
 		}
 
@@ -464,7 +581,7 @@ class Vfs::Tar_file_system : public File_system
 
 		Dirent_result dirent(char const *path, file_offset index, Dirent &out) override
 		{
-			Node *node = _root_node.lookup(path);
+			Node *node = _lookup(path);
 
 			if (!node)
 				return DIRENT_ERR_INVALID_PATH;
@@ -502,7 +619,7 @@ class Vfs::Tar_file_system : public File_system
 		Readlink_result readlink(char const *path, char *buf, file_size buf_size,
 		                         file_size &out_len) override
 		{
-			Node *node = _root_node.lookup(path);
+			Node *node = _lookup(path);
 			Record const *record = node ? node->record : 0;
 
 			if (!record || (record->type() != Record::TYPE_SYMLINK))
@@ -539,7 +656,7 @@ class Vfs::Tar_file_system : public File_system
 
 		bool is_directory(char const *path) override
 		{
-			Node *node = _root_node.lookup(path);
+			Node *node = _lookup(path);
 
 			if (!node)
 				return false;
@@ -556,7 +673,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node *node = _lookup(path);
 			return node ? path : 0;
 		}
 
@@ -0,0 +1,408 @@
+/*
+ * \brief  Sampling CPU profiler
+ * \author agent
+ * \date   2015-12-01
+ *
+ * The profiler periodically queries the instruction pointers of all threads
+ * via core's TRACE service, attributes each sample to the function of the
+ * ELF object containing the instruction pointer, and reports the sample
+ * counts in the folded-stack format used by flame-graph tools.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <trace_session/connection.h>
+#include <timer_session/connection.h>
+#include <os/reporter.h>
+#include <os/server.h>
+#include <os/config.h>
+#include <base/env.h>
+#include <base/snprintf.h>
+
+/* local includes */
+#include "symbol_table.h"
+
+namespace Profiler {
+
+	using namespace Genode;
+
+	typedef Trace::Session_label Session_label;
+	typedef String<64>           Object_name;
+
+	struct Object;
+	struct Component;
+	struct Hit;
+	struct Thread;
+	class  Profile;
+}
+
+namespace Server { struct Main; }
+
+
+/**
+ * ELF object loaded into a component
+ */
+struct Profiler::Object : List<Object>::Element
+{
+	Object_name  const name;
+	addr_t       const base;   /* load address subtracted from samples */
+	Symbol_table      *symbols = nullptr;
+
+	Object(Allocator &alloc, Object_name const &name, addr_t base)
+	:
+		name(name), base(base)
+	{
+		try { symbols = new (&alloc) Symbol_table(alloc, name.string()); }
+		catch (...) {
+			PWRN("no symbols available for \"%s\"", name.string()); }
+	}
+
+	char const *lookup(addr_t ip) const
+	{
+		return (symbols && ip >= base) ? symbols->lookup(ip - base) : nullptr;
+	}
+};
+
+
+/**
+ * Component with the ELF objects used for symbolizing its samples
+ */
+struct Profiler::Component : List<Component>::Element
+{
+	Session_label const label;
+
+	List<Object> objects;
+
+	/**
+	 * Return name of binary, which is the last element of the label
+	 */
+	static Object_name _default_binary(Session_label const &label)
+	{
+		char const *name = label.string();
+		for (char const *s = name; *s; s++)
+			if (s[0] == '-' && s[1] == '>' && s[2] == ' ')
+				name = s + 3;
+
+		return Object_name(name);
+	}
+
+	Component(Allocator &alloc, Session_label const &label)
+	:
+		label(label)
+	{
+		Object_name binary = _default_binary(label);
+
+		/* the dynamic linker is loaded at its link address */
+		objects.insert(new (&alloc) Object(alloc, "ld.lib.so", 0));
+
+		try {
+			config()->xml_node().for_each_sub_node("component", [&] (Xml_node node) {
+
+				if (!node.has_attribute("label")
+				 || !node.attribute("label").has_value(label.string()))
+					return;
+
+				try {
+					char buf[Object_name::capacity()];
+					node.attribute("binary").value(buf, sizeof(buf));
+					binary = Object_name(buf);
+				} catch (...) { }
+
+				/* shared objects at the base addresses reported by ldso */
+				node.for_each_sub_node("object", [&] (Xml_node object) {
+					char   name[Object_name::capacity()];
+					addr_t base = 0;
+					try {
+						object.attribute("name").value(name, sizeof(name));
+						object.attribute("base").value(&base);
+						objects.insert(new (&alloc) Object(alloc, name, base));
+					} catch (...) { PWRN("incomplete <object> node"); }
+				});
+			});
+		} catch (...) { }
+
+		objects.insert(new (&alloc) Object(alloc, binary, 0));
+	}
+
+	/**
+	 * Return symbol containing 'ip' and the object it belongs to
+	 */
+	char const *lookup(addr_t ip, Object const *&object) const
+	{
+		for (Object const *o = objects.first(); o; o = o->next())
+			if (char const *symbol = o->lookup(ip)) {
+				object = o;
+				return symbol;
+			}
+
+		return nullptr;
+	}
+};
+
+
+/**
+ * Number of samples of one thread within one function
+ *
+ * Samples that cannot be symbolized are accounted per instruction pointer.
+ */
+struct Profiler::Hit : List<Hit>::Element
+{
+	Object const * const object;
+	char   const * const symbol;
+	addr_t         const ip;
+
+	unsigned long count = 0;
+
+	Hit(Object const *object, char const *symbol, addr_t ip)
+	: object(object), symbol(symbol), ip(symbol ? 0 : ip) { }
+
+	bool matches(char const *s, addr_t addr) const {
+		return s ? s == symbol : (!symbol && addr == ip); }
+};
+
+
+struct Profiler::Thread : List<Thread>::Element
+{
+	Trace::Subject_id   const id;
+	Trace::Thread_name  const name;
+	Component          &component;
+
+	bool dead = false;
+
+	unsigned long long last_execution_time = 0;
+
+	List<Hit> hits;
+
+	Thread(Trace::Subject_id id, Trace::Thread_name const &name,
+	       Component &component)
+	: id(id), name(name), component(component) { }
+
+	void account(Allocator &alloc, addr_t ip)
+	{
+		Object const *object = nullptr;
+		char   const *symbol = component.lookup(ip, object);
+
+		Hit *hit = hits.first();
+		for (; hit && !hit->matches(symbol, ip); hit = hit->next());
+
+		if (!hit) {
+			hit = new (&alloc) Hit(object, symbol, ip);
+			hits.insert(hit);
+		}
+
+		hit->count++;
+	}
+};
+
+
+class Profiler::Profile
+{
+	private:
+
+		Allocator &_alloc;
+
+		List<Component> _components;
+		List<Thread>    _threads;
+
+		unsigned long _num_samples = 0;
+
+		enum { MAX_SUBJECTS = 512 };
+		Trace::Subject_id _subjects[MAX_SUBJECTS];
+
+		Component &_component(Session_label const &label)
+		{
+			for (Component *c = _components.first(); c; c = c->next())
+				if (c->label == label)
+					return *c;
+
+			Component *c = new (&_alloc) Component(_alloc, label);
+			_components.insert(c);
+			return *c;
+		}
+
+		Thread *_lookup(Trace::Subject_id id)
+		{
+			for (Thread *t = _threads.first(); t; t = t->next())
+				if (t->id == id && !t->dead)
+					return t;
+
+			return nullptr;
+		}
+
+	public:
+
+		Profile(Allocator &alloc) : _alloc(alloc) { }
+
+		/**
+		 * Take one sample of the instruction pointers of all threads
+		 *
+		 * Threads that did not execute since the last sample are skipped
+		 * on kernels that account execution time.
+		 */
+		void sample(Trace::Connection &trace)
+		{
+			size_t const num_subjects = trace.subjects(_subjects, MAX_SUBJECTS);
+
+			for (unsigned i = 0; i < num_subjects; i++) {
+
+				Trace::Subject_id const id = _subjects[i];
+				Trace::Subject_info const info = trace.subject_info(id);
+
+				Thread *t = _lookup(id);
+				if (!t) {
+					t = new (&_alloc)
+						Thread(id, info.thread_name(),
+						       _component(info.session_label()));
+					_threads.insert(t);
+				}
+
+				/* keep the samples of dead threads but release the subject */
+				if (info.state() == Trace::Subject_info::DEAD) {
+					trace.free(id);
+					t->dead = true;
+					continue;
+				}
+
+				unsigned long long const execution_time =
+					info.execution_time().value;
+
+				bool const idle = execution_time
+				               && execution_time == t->last_execution_time;
+
+				t->last_execution_time = execution_time;
+
+				if (idle || !info.instruction_pointer().valid())
+					continue;
+
+				t->account(_alloc, info.instruction_pointer().value);
+				_num_samples++;
+			}
+		}
+
+		unsigned long num_samples() const { return _num_samples; }
+
+		/**
+		 * Write profile in folded-stack format to 'dst'
+		 *
+		 * Each line has the form "label;thread;object`function count".
+		 *
+		 * \return  number of written bytes
+		 */
+		size_t folded(char *dst, size_t dst_len) const
+		{
+			size_t len = 0;
+
+			for (Thread const *t = _threads.first(); t; t = t->next()) {
+				for (Hit const *h = t->hits.first(); h; h = h->next()) {
+
+					char line[512];
+					if (h->symbol)
+						snprintf(line, sizeof(line), "%s;%s;%s`%s %lu\n",
+						         t->component.label.string(), t->name.string(),
+						         h->object->name.string(), h->symbol, h->count);
+					else
+						snprintf(line, sizeof(line), "%s;%s;0x%lx %lu\n",
+						         t->component.label.string(), t->name.string(),
+						         h->ip, h->count);
+
+					size_t const line_len = strlen(line);
+					if (len + line_len > dst_len) {
+						PWRN("profile exceeds report buffer, truncated");
+						return len;
+					}
+
+					memcpy(dst + len, line, line_len);
+					len += line_len;
+				}
+			}
+			return len;
+		}
+};
+
+
+struct Server::Main
+{
+	Entrypoint &ep;
+
+	Genode::Trace::Connection trace { 512*1024, 32*1024, 0 };
+
+	static Genode::size_t report_size()
+	{
+		Genode::size_t size = 64*1024;
+		try { Genode::config()->xml_node().attribute("report_size").value(&size); }
+		catch (...) { }
+		return size;
+	}
+
+	Genode::size_t const buffer_size = report_size();
+
+	char * const buffer = (char *)Genode::env()->heap()->alloc(buffer_size);
+
+	Genode::Reporter reporter { "profile", buffer_size };
+
+	unsigned long sample_ms = 10;
+	unsigned long report_ms = 5000;
+
+	unsigned long elapsed_ms = 0;
+
+	Timer::Connection timer;
+
+	Profiler::Profile profile { *Genode::env()->heap() };
+
+	void handle_sample(unsigned);
+
+	Signal_rpc_member<Main> sample_dispatcher = {
+		ep, *this, &Main::handle_sample};
+
+	Main(Entrypoint &ep) : ep(ep)
+	{
+		Genode::Xml_node config = Genode::config()->xml_node();
+
+		try { config.attribute("sample_ms").value(&sample_ms); } catch (...) { }
+		try { config.attribute("report_ms").value(&report_ms); } catch (...) { }
+
+		sample_ms = Genode::max(sample_ms, 1UL);
+
+		PINF("sample_ms=%ld, report_ms=%ld", sample_ms, report_ms);
+
+		reporter.enabled(true);
+
+		timer.sigh(sample_dispatcher);
+		timer.trigger_periodic(1000*sample_ms);
+	}
+};
+
+
+void Server::Main::handle_sample(unsigned)
+{
+	profile.sample(trace);
+
+	elapsed_ms += sample_ms;
+	if (elapsed_ms < report_ms)
+		return;
+
+	elapsed_ms = 0;
+
+	reporter.report(buffer, profile.folded(buffer, buffer_size));
+
+	PINF("reported profile of %ld samples", profile.num_samples());
+}
+
+
+namespace Server {
+
+	char const *name() { return "profiler_ep"; }
+
+	size_t stack_size() { return 4*1024*sizeof(long); }
+
+	void construct(Entrypoint &ep)
+	{
+		static Main main(ep);
+	}
+}
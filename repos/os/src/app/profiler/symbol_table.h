@@ -0,0 +1,184 @@
+/*
+ * \brief  Function symbols of an ELF object obtained as ROM module
+ * \author agent
+ * \date   2015-12-01
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _SYMBOL_TABLE_H_
+#define _SYMBOL_TABLE_H_
+
+/* Genode includes */
+#include <os/attached_rom_dataspace.h>
+#include <base/allocator.h>
+#include <base/stdint.h>
+
+/* ELF definitions of the base repository */
+#include <elf.h>
+
+namespace Profiler {
+
+	using Genode::addr_t;
+	using Genode::size_t;
+
+	class Symbol_table;
+}
+
+
+class Profiler::Symbol_table
+{
+	private:
+
+		struct Symbol
+		{
+			addr_t      addr;
+			size_t      size;
+			char const *name;
+		};
+
+		Genode::Allocator              &_alloc;
+		Genode::Attached_rom_dataspace  _rom;
+
+		Symbol   *_symbols     = nullptr;
+		unsigned  _num_symbols = 0;
+
+		/**
+		 * Return pointer to 'count' objects at 'offset' within the ROM
+		 *
+		 * \throw Invalid_elf  range lies outside of the ROM module
+		 */
+		template <typename T>
+		T const *_at(size_t offset, size_t count = 1)
+		{
+			if (offset > _rom.size() || count > (_rom.size() - offset)/sizeof(T))
+				throw Invalid_elf();
+
+			return (T const *)(_rom.local_addr<char const>() + offset);
+		}
+
+		Elf_Shdr const *_symtab(Elf_Shdr const *sections, unsigned num,
+		                        unsigned type)
+		{
+			for (unsigned i = 0; i < num; i++)
+				if (sections[i].sh_type == type && sections[i].sh_link < num)
+					return &sections[i];
+
+			return nullptr;
+		}
+
+		void _sort()
+		{
+			/* shell sort by address */
+			for (unsigned gap = _num_symbols/2; gap; gap /= 2)
+				for (unsigned i = gap; i < _num_symbols; i++)
+					for (unsigned j = i; j >= gap
+					  && _symbols[j - gap].addr > _symbols[j].addr; j -= gap) {
+						Symbol const tmp  = _symbols[j];
+						_symbols[j]       = _symbols[j - gap];
+						_symbols[j - gap] = tmp;
+					}
+		}
+
+	public:
+
+		class Invalid_elf : public Genode::Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc     allocator for the sorted symbol array
+		 * \param rom_name  name of the ROM module containing the ELF object
+		 *
+		 * \throw Rom_connection::Rom_connection_failed
+		 * \throw Invalid_elf
+		 *
+		 * The symbols of the '.symtab' section are used if present.
+		 * Otherwise, the dynamic symbols of '.dynsym' are used.
+		 */
+		Symbol_table(Genode::Allocator &alloc, char const *rom_name)
+		:
+			_alloc(alloc), _rom(rom_name)
+		{
+			Elf_Ehdr const &ehdr = *_at<Elf_Ehdr>(0);
+
+			if (Genode::memcmp(ehdr.e_ident, ELFMAG, SELFMAG)
+			 || ehdr.e_shentsize != sizeof(Elf_Shdr))
+				throw Invalid_elf();
+
+			Elf_Shdr const *sections = _at<Elf_Shdr>(ehdr.e_shoff, ehdr.e_shnum);
+
+			Elf_Shdr const *symtab = _symtab(sections, ehdr.e_shnum, SHT_SYMTAB);
+			if (!symtab)
+				symtab = _symtab(sections, ehdr.e_shnum, SHT_DYNSYM);
+			if (!symtab)
+				throw Invalid_elf();
+
+			Elf_Shdr const &strtab = sections[symtab->sh_link];
+
+			size_t    const num  = symtab->sh_size / sizeof(Elf_Sym);
+			Elf_Sym   const *sym = _at<Elf_Sym>(symtab->sh_offset, num);
+			char      const *str = _at<char>(strtab.sh_offset, strtab.sh_size);
+
+			/* count function symbols to dimension the symbol array */
+			for (size_t i = 0; i < num; i++)
+				if (ELF_ST_TYPE(sym[i].st_info) == STT_FUNC && sym[i].st_value
+				 && sym[i].st_name < strtab.sh_size)
+					_num_symbols++;
+
+			if (!_num_symbols)
+				throw Invalid_elf();
+
+			_symbols = new (&_alloc) Symbol[_num_symbols];
+
+			unsigned n = 0;
+			for (size_t i = 0; i < num; i++)
+				if (ELF_ST_TYPE(sym[i].st_info) == STT_FUNC && sym[i].st_value
+				 && sym[i].st_name < strtab.sh_size)
+					_symbols[n++] = { (addr_t)sym[i].st_value,
+					                  (size_t)sym[i].st_size,
+					                  str + sym[i].st_name };
+			_sort();
+		}
+
+		~Symbol_table() { Genode::destroy(&_alloc, _symbols); }
+
+		/**
+		 * Return name of function containing the link address 'addr'
+		 *
+		 * \return  function name, or nullptr if 'addr' is not covered
+		 */
+		char const *lookup(addr_t addr) const
+		{
+			/* find last symbol starting at or below 'addr' */
+			unsigned lo = 0, hi = _num_symbols;
+			while (lo < hi) {
+				unsigned const mid = (lo + hi)/2;
+				if (_symbols[mid].addr <= addr)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+
+			if (lo == 0)
+				return nullptr;
+
+			Symbol const &s = _symbols[lo - 1];
+
+			/* symbols without size extend up to the next symbol */
+			if (s.size && addr >= s.addr + s.size)
+				return nullptr;
+
+			if (!s.size && lo == _num_symbols)
+				return nullptr;
+
+			return s.name;
+		}
+};
+
+#endif /* _SYMBOL_TABLE_H_ */
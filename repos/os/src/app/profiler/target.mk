@@ -0,0 +1,5 @@
+TARGET = profiler
+SRC_CC = main.cc
+LIBS  += base server config
+
+INC_DIR += $(BASE_DIR)/src/base/elf
@@ -114,7 +114,8 @@ struct Trace_subject_registry
 		}
 
 		void report(Genode::Xml_generator &xml,
-		            bool report_affinity, bool report_activity)
+		            bool report_affinity, bool report_activity,
+		            bool report_page_faults)
 		{
 			for (Entry const *e = _entries.first(); e; e = e->next()) {
 				xml.node("subject", [&] () {
@@ -137,6 +138,12 @@ struct Trace_subject_registry
 							xml.attribute("xpos", e->info.affinity().xpos());
 							xml.attribute("ypos", e->info.affinity().ypos());
 						});
+
+					if (report_page_faults)
+						xml.node("page_faults", [&] () {
+							xml.attribute("count", e->info.page_faults().faults);
+							xml.attribute("pages", e->info.page_faults().pages);
+						});
 				});
 			}
 		}
@@ -155,8 +162,9 @@ struct Server::Main
 
 	unsigned long period_ms = default_period_ms();
 
-	bool report_affinity = false;
-	bool report_activity = false;
+	bool report_affinity    = false;
+	bool report_activity    = false;
+	bool report_page_faults = false;
 
 	bool config_report_attribute_enabled(char const *attr) const
 	{
@@ -203,9 +211,10 @@ void Server::Main::handle_config(unsigned)
 
 	report_affinity = config_report_attribute_enabled("affinity");
 	report_activity = config_report_attribute_enabled("activity");
+	report_page_faults = config_report_attribute_enabled("page_faults");
 
-	PINF("period_ms=%ld, report_activity=%d, report_affinity=%d",
-	     period_ms, report_activity, report_affinity);
+	PINF("period_ms=%ld, report_activity=%d, report_affinity=%d, report_page_faults=%d",
+	     period_ms, report_activity, report_affinity, report_page_faults);
 
 	timer.trigger_periodic(1000*period_ms);
 }
@@ -220,7 +229,8 @@ void Server::Main::handle_period(unsigned)
 	reporter.clear();
 	Genode::Reporter::Xml_generator xml(reporter, [&] ()
 	{
-		trace_subject_registry.report(xml, report_affinity, report_activity);
+		trace_subject_registry.report(xml, report_affinity, report_activity,
+		                              report_page_faults);
 	});
 }
 
@@ -81,13 +81,23 @@ class Ps2_mouse : public Input_driver
 		int           _packet_len;
 		int           _packet_idx;
 
-		void _check_for_event_queue_overflow()
+		/* dropped events are reported once per overflow */
+		bool          _overflow_reported = false;
+
+		/**
+		 * Post event to event queue, drop it if the queue is full
+		 */
+		void _post_event(Input::Event const &ev)
 		{
-			if (_ev_queue.avail_capacity())
+			if (!_ev_queue.avail_capacity()) {
+				if (!_overflow_reported)
+					PWRN("event queue overflow - dropping events");
+				_overflow_reported = true;
 				return;
+			}
 
-			PWRN("event queue overflow - dropping events");
-			_ev_queue.reset();
+			_overflow_reported = false;
+			_ev_queue.add(ev);
 		}
 
 		/**
@@ -105,11 +115,9 @@ class Ps2_mouse : public Input_driver
 			if (_verbose)
 				Genode::printf("post %s, key_code = %d\n", new_state ? "PRESS" : "RELEASE", key_code);
 
-			_check_for_event_queue_overflow();
-
-			_ev_queue.add(Input::Event(new_state ? Input::Event::PRESS
-			                                     : Input::Event::RELEASE,
-			                           key_code, 0, 0, 0, 0));
+			_post_event(Input::Event(new_state ? Input::Event::PRESS
+			                                   : Input::Event::RELEASE,
+			                         key_code, 0, 0, 0, 0));
 			*old_state = new_state;
 		}
 
@@ -234,10 +242,8 @@ class Ps2_mouse : public Input_driver
 				if (_verbose)
 					Genode::printf("post MOTION, rel_x = %d, rel_y = %d\n", rel_x, rel_y);
 
-				_check_for_event_queue_overflow();
-
-				_ev_queue.add(Input::Event(Input::Event::MOTION,
-				                           0, 0, 0, rel_x, rel_y));
+				_post_event(Input::Event(Input::Event::MOTION,
+				                         0, 0, 0, rel_x, rel_y));
 			}
 
 			/* generate wheel event */
@@ -256,10 +262,8 @@ class Ps2_mouse : public Input_driver
 				if (_verbose)
 					Genode::printf("post WHEEL, rel_z = %d\n", rel_z);
 
-				_check_for_event_queue_overflow();
-
-				_ev_queue.add(Input::Event(Input::Event::WHEEL,
-				                           0, 0, 0, 0, rel_z));
+				_post_event(Input::Event(Input::Event::WHEEL,
+				                         0, 0, 0, 0, rel_z));
 			}
 
 			/* detect changes of mouse-button state and post corresponding events */
@@ -0,0 +1,307 @@
+/*
+ * \brief  Block session to the device shared by the clients
+ * \author agent
+ * \date   2015-12-10
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _BLK_MUX__BACKEND_H_
+#define _BLK_MUX__BACKEND_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/tslab.h>
+#include <block_session/connection.h>
+#include <os/server.h>
+#include <timer_session/timer_session.h>
+
+/* local includes */
+#include "scheduler.h"
+
+namespace Blk_mux { class Backend; }
+
+
+class Blk_mux::Backend
+{
+	public:
+
+		/*
+		 * Upper bound of a merged request
+		 */
+		enum { MAX_MERGE_BYTES = 256*1024, MAX_MERGE_REQUESTS = 32 };
+
+		enum { TX_BUF_SIZE = 4*1024*1024 };
+
+	private:
+
+		/**
+		 * Request to the device, comprising one or more merged requests
+		 */
+		struct Io : List<Io>::Element
+		{
+			Packet_descriptor packet;
+			bool const        write;
+			Block::sector_t   first;
+			Block::sector_t   end;
+			Request          *requests[MAX_MERGE_REQUESTS];
+			unsigned          count = 0;
+
+			Io(Request &r) : write(r.write()), first(r.first()), end(r.end()) {
+				add(r); }
+
+			void add(Request &r)
+			{
+				requests[count++] = &r;
+				first = min(first, r.first());
+				end   = max(end,   r.end());
+			}
+
+			size_t blocks() const { return end - first; }
+		};
+
+		enum {
+			IO_SLAB_SIZE      = Block::Session::TX_QUEUE_SIZE*sizeof(Io),
+			REQUEST_SLAB_SIZE = Block::Session::TX_QUEUE_SIZE*sizeof(Request)
+		};
+
+		Scheduler                          &_scheduler;
+		Allocator_avl                       _block_alloc;
+		Block::Connection                   _session;
+		Tslab<Io, IO_SLAB_SIZE>             _io_slab;
+		Tslab<Request, REQUEST_SLAB_SIZE>   _request_slab;
+		List<Io>                            _ios;
+		Block::sector_t                     _blk_cnt  = 0;
+		size_t                              _blk_size = 0;
+		Block::Session::Operations          _ops;
+
+		unsigned long _num_ios    = 0;
+		unsigned long _num_merged = 0;
+
+		Signal_context_capability _ack_avail;
+
+		size_t _max_merge_blocks() const {
+			return max(MAX_MERGE_BYTES/_blk_size, (size_t)1); }
+
+		/**
+		 * Merge pending requests adjacent to 'io'
+		 */
+		void _merge(Io &io)
+		{
+			while (io.count < MAX_MERGE_REQUESTS
+			    && io.blocks() < _max_merge_blocks()) {
+
+				Request *r = _scheduler.take_adjacent(io.write, io.first, io.end,
+				                                      _max_merge_blocks() - io.blocks());
+				if (!r)
+					return;
+
+				io.add(*r);
+				_num_merged++;
+			}
+		}
+
+		char *_content(Io &io, Request &r) {
+			return _session.tx()->packet_content(io.packet)
+			       + (r.first() - io.first)*_blk_size; }
+
+		Io *_lookup(Packet_descriptor const &p)
+		{
+			for (Io *io = _ios.first(); io; io = io->next())
+				if (io->packet.offset() == p.offset())
+					return io;
+			return nullptr;
+		}
+
+		void _complete(Io &io, bool success, unsigned long now_ms)
+		{
+			for (unsigned i = 0; i < io.count; i++) {
+				Request &r = *io.requests[i];
+
+				if (r.client)
+					r.client->complete(r, success,
+					                   success && !io.write ? _content(io, r) : nullptr,
+					                   now_ms);
+
+				destroy(&_request_slab, &r);
+			}
+		}
+
+		void _handle_ack(Packet_descriptor const &p, unsigned long now_ms)
+		{
+			if (Io *io = _lookup(p)) {
+				_complete(*io, p.succeeded(), now_ms);
+				_ios.remove(io);
+				destroy(&_io_slab, io);
+			}
+			_session.tx()->release_packet(p);
+		}
+
+		/**
+		 * Return true if writes of 'client' are queued or in flight
+		 */
+		bool _writes_pending(Client const &client)
+		{
+			bool pending = false;
+			_scheduler.for_each(client, [&] (Request const &r) {
+				pending |= r.write(); });
+
+			for (Io *io = _ios.first(); io; io = io->next())
+				for (unsigned i = 0; i < io->count; i++)
+					pending |= io->write && io->requests[i]->client == &client;
+
+			return pending;
+		}
+
+	public:
+
+		Backend(Scheduler &scheduler)
+		:
+			_scheduler(scheduler),
+			_block_alloc(env()->heap()),
+			_session(&_block_alloc, TX_BUF_SIZE),
+			_io_slab(env()->heap()),
+			_request_slab(env()->heap())
+		{
+			_session.info(&_blk_cnt, &_blk_size, &_ops);
+		}
+
+		Block::sector_t            blk_cnt()  const { return _blk_cnt;  }
+		size_t                     blk_size() const { return _blk_size; }
+		Block::Session::Operations ops()      const { return _ops;      }
+
+		/**
+		 * Maximum number of blocks of a client request
+		 *
+		 * Larger requests could never be allocated in the packet buffer
+		 * of the device session.
+		 */
+		size_t max_blocks() const { return (TX_BUF_SIZE/2)/_blk_size; }
+
+		unsigned long num_ios()    const { return _num_ios;    }
+		unsigned long num_merged() const { return _num_merged; }
+
+		/**
+		 * Sync device after all writes of 'client' got acknowledged
+		 *
+		 * While waiting, the acknowledgements are obtained via the
+		 * blocking packet-stream interface. The regular handler is
+		 * triggered afterwards to process acknowledgements that arrived
+		 * meanwhile and to wake up the sessions.
+		 */
+		void sync(Client const &client, Timer::Session &timer)
+		{
+			Block::Session::Tx::Source &source = *_session.tx();
+
+			_session.tx_channel()->sigh_ack_avail(source.sigh_ack_avail());
+
+			for (dispatch(timer.elapsed_ms()); _writes_pending(client);
+			     dispatch(timer.elapsed_ms())) {
+
+				/* no acknowledgement can arrive if nothing is in flight */
+				if (!_ios.first()) {
+					PERR("cannot pass pending writes to the device");
+					break;
+				}
+
+				Packet_descriptor const p = source.get_acked_packet();
+				_handle_ack(p, timer.elapsed_ms());
+			}
+
+			_session.tx_channel()->sigh_ack_avail(_ack_avail);
+			Signal_transmitter(_ack_avail).submit();
+
+			_session.sync();
+		}
+
+		void sigh(Signal_context_capability ack_avail,
+		          Signal_context_capability ready_to_submit)
+		{
+			_ack_avail = ack_avail;
+			_session.tx_channel()->sigh_ack_avail(ack_avail);
+			_session.tx_channel()->sigh_ready_to_submit(ready_to_submit);
+		}
+
+		/**
+		 * Queue request of a client for being dispatched
+		 */
+		void submit(Client &client, Packet_descriptor packet,
+		            unsigned long now_ms)
+		{
+			_scheduler.enqueue(*new (&_request_slab)
+			                   Request(client, packet, now_ms));
+		}
+
+		/**
+		 * Pass pending requests to the device as long as it accepts them
+		 */
+		void dispatch(unsigned long now_ms)
+		{
+			Block::Session::Tx::Source &source = *_session.tx();
+
+			while (!_scheduler.empty() && source.ready_to_submit()) {
+
+				Io &io = *new (&_io_slab) Io(*_scheduler.next(now_ms));
+				_merge(io);
+
+				try {
+					io.packet = Packet_descriptor(
+						_session.dma_alloc_packet(io.blocks()*_blk_size),
+						io.write ? Packet_descriptor::WRITE : Packet_descriptor::READ,
+						io.first, io.blocks());
+
+				} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+
+					/* retry once the device acknowledged packets */
+					for (unsigned i = 0; i < io.count; i++)
+						_scheduler.requeue(*io.requests[i]);
+					destroy(&_io_slab, &io);
+					return;
+				}
+
+				if (io.write)
+					for (unsigned i = 0; i < io.count; i++) {
+						Request &r = *io.requests[i];
+						if (r.client)
+							memcpy(_content(io, r), r.client->content(r.packet),
+							       r.packet.block_count()*_blk_size);
+					}
+
+				_ios.insert(&io);
+				_num_ios++;
+				source.submit_packet(io.packet);
+			}
+		}
+
+		/**
+		 * Complete requests acknowledged by the device
+		 */
+		void handle_acks(unsigned long now_ms)
+		{
+			Block::Session::Tx::Source &source = *_session.tx();
+
+			while (source.ack_avail())
+				_handle_ack(source.get_acked_packet(), now_ms);
+		}
+
+		/**
+		 * Detach client from its requests, called when the session is closed
+		 */
+		void detach(Client &client)
+		{
+			_scheduler.flush(client, [&] (Request &r) {
+				destroy(&_request_slab, &r); });
+
+			for (Io *io = _ios.first(); io; io = io->next())
+				for (unsigned i = 0; i < io->count; i++)
+					if (io->requests[i]->client == &client)
+						io->requests[i]->client = nullptr;
+		}
+};
+
+#endif /* _BLK_MUX__BACKEND_H_ */
@@ -0,0 +1,318 @@
+/*
+ * \brief  Block-session component of the block multiplexer
+ * \author agent
+ * \date   2015-12-10
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _BLK_MUX__COMPONENT_H_
+#define _BLK_MUX__COMPONENT_H_
+
+/* Genode includes */
+#include <block_session/rpc_object.h>
+#include <os/session_policy.h>
+#include <root/component.h>
+#include <timer_session/timer_session.h>
+
+/* local includes */
+#include "backend.h"
+
+namespace Blk_mux {
+
+	struct Stats;
+	class  Session_component_base;
+	class  Session_component;
+	class  Root;
+}
+
+
+/**
+ * Statistics of a client
+ */
+struct Blk_mux::Stats
+{
+	unsigned long      reads          = 0;
+	unsigned long      writes         = 0;
+	unsigned long      failed         = 0;
+	unsigned long long read_bytes     = 0;
+	unsigned long long write_bytes    = 0;
+	unsigned long long latency_sum_ms = 0;
+	unsigned long      latency_max_ms = 0;
+
+	/* number of transferred bytes at the time of the previous report */
+	unsigned long long reported_bytes = 0;
+
+	unsigned long completed() const { return reads + writes + failed; }
+};
+
+
+/**
+ * Communication buffer that must outlive the packet stream of the session
+ */
+class Blk_mux::Session_component_base
+{
+	protected:
+
+		Ram_dataspace_capability _tx_ds;
+
+		Session_component_base(size_t tx_buf_size)
+		: _tx_ds(env()->ram_session()->alloc(tx_buf_size)) { }
+
+		~Session_component_base() { env()->ram_session()->free(_tx_ds); }
+};
+
+
+class Blk_mux::Session_component : public Session_component_base,
+                                   public Block::Session_rpc_object,
+                                   public Client,
+                                   public List<Session_component>::Element
+{
+	private:
+
+		Session_label const _label;
+		Client_policy const _policy;
+		Backend            &_backend;
+		Timer::Session     &_timer;
+		Stats               _stats;
+		unsigned            _in_flight = 0;
+
+		Signal_rpc_member<Session_component> _sink_ack;
+		Signal_rpc_member<Session_component> _sink_submit;
+
+		void _ack(Packet_descriptor const &p)
+		{
+			tx_sink()->acknowledge_packet(p);
+			_in_flight--;
+		}
+
+		bool _valid(Packet_descriptor const &p)
+		{
+			Block::sector_t const cnt = p.block_count();
+
+			return (p.operation() == Packet_descriptor::READ
+			     || p.operation() == Packet_descriptor::WRITE)
+			    && _backend.ops().supported(p.operation())
+			    && cnt && cnt <= _backend.max_blocks()
+			    && p.block_number() < _backend.blk_cnt()
+			    && cnt <= _backend.blk_cnt() - p.block_number()
+			    && p.size() >= cnt*_backend.blk_size()
+			    && tx_sink()->packet_content(p);
+		}
+
+		/**
+		 * Triggered when a packet was placed into the empty submit queue
+		 */
+		void _packet_avail(unsigned)
+		{
+			unsigned long const now_ms = _timer.elapsed_ms();
+
+			/*
+			 * Accept packets as long as we are able to acknowledge them,
+			 * the scheduler decides when they are passed to the device.
+			 */
+			Block::Session::Tx::Sink &sink = *tx_sink();
+			while (sink.packet_avail() && _in_flight < sink.ack_slots_free()) {
+
+				Packet_descriptor p = sink.get_packet();
+				_in_flight++;
+
+				if (!_valid(p)) {
+					p.succeeded(false);
+					_stats.failed++;
+					_ack(p);
+					continue;
+				}
+				_backend.submit(*this, p, now_ms);
+			}
+
+			_backend.dispatch(now_ms);
+		}
+
+		/**
+		 * Triggered when an ack got removed from the full ack queue
+		 */
+		void _ready_to_ack(unsigned) { _packet_avail(0); }
+
+	public:
+
+		Session_component(Session_label const &label, Client_policy const &policy,
+		                  size_t tx_buf_size, Backend &backend,
+		                  Timer::Session &timer, Server::Entrypoint &ep)
+		:
+			Session_component_base(tx_buf_size),
+			Session_rpc_object(_tx_ds, ep.rpc_ep()),
+			_label(label), _policy(policy), _backend(backend), _timer(timer),
+			_sink_ack(ep, *this, &Session_component::_ready_to_ack),
+			_sink_submit(ep, *this, &Session_component::_packet_avail)
+		{
+			_tx.sigh_ready_to_ack(_sink_ack);
+			_tx.sigh_packet_avail(_sink_submit);
+		}
+
+		~Session_component() { _backend.detach(*this); }
+
+		Session_label const &label() const { return _label; }
+
+		Stats &stats() { return _stats; }
+
+		unsigned pending() const { return _in_flight; }
+
+		/**
+		 * Resume taking packets after requests got completed
+		 */
+		void wake_up() { _packet_avail(0); }
+
+
+		/************
+		 ** Client **
+		 ************/
+
+		Client_policy const &policy() const override { return _policy; }
+
+		char *content(Packet_descriptor const &p) override {
+			return tx_sink()->packet_content(p); }
+
+		void complete(Request &r, bool success, char const *data,
+		              unsigned long now_ms) override
+		{
+			Packet_descriptor p = r.packet;
+			size_t const size = p.block_count()*_backend.blk_size();
+
+			if (data)
+				memcpy(content(p), data, size);
+
+			if (!success)
+				_stats.failed++;
+			else if (r.write()) {
+				_stats.writes++;
+				_stats.write_bytes += size;
+			} else {
+				_stats.reads++;
+				_stats.read_bytes += size;
+			}
+
+			unsigned long const latency_ms = now_ms - r.arrival_ms;
+			_stats.latency_sum_ms += latency_ms;
+			_stats.latency_max_ms  = max(_stats.latency_max_ms, latency_ms);
+
+			p.succeeded(success);
+			_ack(p);
+		}
+
+
+		/*******************************
+		 **  Block session interface  **
+		 *******************************/
+
+		void info(Block::sector_t *blk_count, size_t *blk_size,
+		          Block::Session::Operations *ops)
+		{
+			*blk_count = _backend.blk_cnt();
+			*blk_size  = _backend.blk_size();
+			*ops       = _backend.ops();
+		}
+
+		void sync() { _backend.sync(*this, _timer); }
+};
+
+
+class Blk_mux::Root : public Genode::Root_component<Session_component>
+{
+	private:
+
+		Server::Entrypoint      &_ep;
+		Backend                 &_backend;
+		Timer::Session          &_timer;
+		List<Session_component>  _sessions;
+
+		static Client_policy _policy(Session_policy const &policy)
+		{
+			Client_policy p;
+			try { policy.attribute("weight").value(&p.weight); } catch (...) { }
+			try { policy.attribute("read_deadline_ms").value(&p.read_deadline_ms); }
+			catch (...) { }
+			try { policy.attribute("write_deadline_ms").value(&p.write_deadline_ms); }
+			catch (...) { }
+
+			p.weight = max(p.weight, 1U);
+			return p;
+		}
+
+	protected:
+
+		Session_component *_create_session(const char *args)
+		{
+			Session_label label(args);
+
+			Client_policy policy;
+			try { policy = _policy(Session_policy(label)); }
+			catch (Session_policy::No_policy_defined) {
+				PERR("rejecting session request, no matching policy for '%s'",
+				     label.string());
+				throw Root::Unavailable();
+			}
+
+			size_t ram_quota =
+				Arg_string::find_arg(args, "ram_quota"  ).ulong_value(0);
+			size_t tx_buf_size =
+				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
+
+			if (!tx_buf_size)
+				throw Root::Invalid_args();
+
+			/* delete ram quota by the memory needed for the session */
+			size_t session_size = max((size_t)4096, sizeof(Session_component));
+			if (ram_quota < session_size)
+				throw Root::Quota_exceeded();
+
+			/*
+			 * Check if donated ram quota suffices for the communication
+			 * buffer. Also check both sizes separately to handle a possible
+			 * overflow of the sum of both sizes.
+			 */
+			if (tx_buf_size > ram_quota - session_size) {
+				PERR("insufficient 'ram_quota', got %zd, need %zd",
+				     ram_quota, tx_buf_size + session_size);
+				throw Root::Quota_exceeded();
+			}
+
+			Session_component *session = new (md_alloc())
+				Session_component(label, policy, tx_buf_size, _backend,
+				                  _timer, _ep);
+			_sessions.insert(session);
+
+			PLOG("session opened for '%s', weight=%u", label.string(),
+			     policy.weight);
+			return session;
+		}
+
+		void _destroy_session(Session_component *session)
+		{
+			_sessions.remove(session);
+			Genode::Root_component<Session_component>::_destroy_session(session);
+		}
+
+	public:
+
+		Root(Server::Entrypoint &ep, Allocator &md_alloc, Backend &backend,
+		     Timer::Session &timer)
+		:
+			Root_component(&ep.rpc_ep(), &md_alloc),
+			_ep(ep), _backend(backend), _timer(timer)
+		{ }
+
+		template <typename FN>
+		void for_each_session(FN const &fn)
+		{
+			for (Session_component *s = _sessions.first(); s; s = s->next())
+				fn(*s);
+		}
+};
+
+#endif /* _BLK_MUX__COMPONENT_H_ */
@@ -0,0 +1,146 @@
+/*
+ * \brief  Block multiplexer
+ * \author agent
+ * \date   2015-12-10
+ *
+ * The server lets several clients share one block device. Requests of all
+ * clients are ordered by an I/O scheduler and adjacent requests are merged
+ * into one device request.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <os/config.h>
+#include <os/reporter.h>
+#include <os/server.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include "component.h"
+
+namespace Blk_mux { struct Main; }
+
+
+struct Blk_mux::Main
+{
+	Server::Entrypoint &ep;
+
+	Timer::Connection timer;
+
+	static Scheduler &_scheduler()
+	{
+		static Deadline_scheduler deadline;
+		static Fair_scheduler     fair;
+
+		try {
+			if (config()->xml_node().attribute("scheduler").has_value("deadline"))
+				return deadline;
+		} catch (...) { }
+
+		return fair;
+	}
+
+	Scheduler &scheduler = _scheduler();
+
+	Backend backend { scheduler };
+
+	Sliced_heap sliced_heap = { env()->ram_session(), env()->rm_session() };
+
+	Root root { ep, sliced_heap, backend, timer };
+
+	/*
+	 * Statistics report
+	 */
+	Reporter      reporter { "block_statistics", 16*1024 };
+	unsigned long report_ms = 0;
+
+	void handle_acks(unsigned)
+	{
+		unsigned long const now_ms = timer.elapsed_ms();
+
+		backend.handle_acks(now_ms);
+		backend.dispatch(now_ms);
+
+		/* let sessions take the packets they had to leave in their queues */
+		root.for_each_session([&] (Session_component &s) { s.wake_up(); });
+	}
+
+	void handle_ready_to_submit(unsigned) { backend.dispatch(timer.elapsed_ms()); }
+
+	void handle_report(unsigned);
+
+	Signal_rpc_member<Main> ack_dispatcher    { ep, *this, &Main::handle_acks };
+	Signal_rpc_member<Main> submit_dispatcher { ep, *this, &Main::handle_ready_to_submit };
+	Signal_rpc_member<Main> report_dispatcher { ep, *this, &Main::handle_report };
+
+	Main(Server::Entrypoint &ep) : ep(ep)
+	{
+		try { config()->xml_node().attribute("report_ms").value(&report_ms); }
+		catch (...) { }
+
+		if (report_ms) {
+			reporter.enabled(true);
+			timer.sigh(report_dispatcher);
+			timer.trigger_periodic(1000*report_ms);
+		}
+
+		backend.sigh(ack_dispatcher, submit_dispatcher);
+
+		env()->parent()->announce(ep.manage(root));
+	}
+};
+
+
+void Blk_mux::Main::handle_report(unsigned)
+{
+	Reporter::Xml_generator xml(reporter, [&] () {
+
+		xml.attribute("ios",    backend.num_ios());
+		xml.attribute("merged", backend.num_merged());
+
+		root.for_each_session([&] (Session_component &s) {
+
+			Stats &stats = s.stats();
+
+			unsigned long long const bytes = stats.read_bytes + stats.write_bytes;
+			unsigned long long const kib_per_sec =
+				((bytes - stats.reported_bytes)*1000/report_ms)/1024;
+			stats.reported_bytes = bytes;
+
+			xml.node("session", [&] () {
+				xml.attribute("label",          s.label().string());
+				xml.attribute("weight",         (long)s.policy().weight);
+				xml.attribute("reads",          stats.reads);
+				xml.attribute("writes",         stats.writes);
+				xml.attribute("failed",         stats.failed);
+				xml.attribute("read_kib",       (long)(stats.read_bytes/1024));
+				xml.attribute("write_kib",      (long)(stats.write_bytes/1024));
+				xml.attribute("kib_per_sec",    (long)kib_per_sec);
+				xml.attribute("avg_latency_ms", (long)(stats.completed()
+				              ? stats.latency_sum_ms/stats.completed() : 0));
+				xml.attribute("max_latency_ms", stats.latency_max_ms);
+				xml.attribute("pending",        (long)s.pending());
+			});
+		});
+	});
+}
+
+
+/************
+ ** Server **
+ ************/
+
+namespace Server {
+
+	char const *name() { return "blk_mux_ep"; }
+
+	size_t stack_size() { return 2048*sizeof(long); }
+
+	void construct(Entrypoint &ep) { static Blk_mux::Main main(ep); }
+}
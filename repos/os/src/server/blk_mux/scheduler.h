@@ -0,0 +1,334 @@
+/*
+ * \brief  I/O schedulers of the block multiplexer
+ * \author agent
+ * \date   2015-12-10
+ *
+ * A scheduler holds the requests of all clients that are not yet passed to
+ * the backend and decides which request is dispatched next. Requests that
+ * are adjacent to the dispatched one are handed out for merging regardless
+ * of the client they belong to. A request is never handed out while an
+ * older pending request of the same client overlaps it and one of both is
+ * a write, which keeps the order of dependent requests of each client.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _BLK_MUX__SCHEDULER_H_
+#define _BLK_MUX__SCHEDULER_H_
+
+/* Genode includes */
+#include <block_session/block_session.h>
+#include <util/list.h>
+
+namespace Blk_mux {
+
+	using namespace Genode;
+
+	typedef Block::Packet_descriptor Packet_descriptor;
+
+	struct Client_policy;
+	class  Client;
+	struct Request;
+	class  Scheduler;
+	class  Deadline_scheduler;
+	class  Fair_scheduler;
+}
+
+
+/**
+ * Scheduling parameters of a client, obtained from its session policy
+ */
+struct Blk_mux::Client_policy
+{
+	unsigned      weight            = 1;
+	unsigned long read_deadline_ms  = 100;
+	unsigned long write_deadline_ms = 1000;
+};
+
+
+/**
+ * Interface of a client session used by the backend
+ */
+class Blk_mux::Client
+{
+	public:
+
+		/**
+		 * Virtual finish time of the latest request, used by fair queueing
+		 */
+		unsigned long long finish_tag = 0;
+
+		virtual Client_policy const &policy() const = 0;
+
+		/**
+		 * Return payload of a client packet
+		 */
+		virtual char *content(Packet_descriptor const &) = 0;
+
+		/**
+		 * Acknowledge request to the client
+		 *
+		 * \param data    payload read from the backend, or 0 for writes and
+		 *                failed requests
+		 * \param now_ms  completion time
+		 */
+		virtual void complete(Request &, bool success, char const *data,
+		                      unsigned long now_ms) = 0;
+};
+
+
+struct Blk_mux::Request : List<Request>::Element
+{
+	Client            *client;       /* 0 if client vanished meanwhile */
+	Packet_descriptor  packet;       /* packet of the client */
+	unsigned long      arrival_ms;
+	unsigned long      deadline_ms;
+	unsigned long long start_tag  = 0;
+	unsigned long long finish_tag = 0;
+	unsigned long long seq        = 0;  /* arrival order */
+
+	Request(Client &client, Packet_descriptor packet, unsigned long now_ms)
+	:
+		client(&client), packet(packet), arrival_ms(now_ms),
+		deadline_ms(now_ms + (write() ? client.policy().write_deadline_ms
+		                              : client.policy().read_deadline_ms))
+	{ }
+
+	bool write() const {
+		return packet.operation() == Packet_descriptor::WRITE; }
+
+	Block::sector_t first() const { return packet.block_number(); }
+	Block::sector_t end()   const { return first() + packet.block_count(); }
+
+	/**
+	 * Return true if the requests must be executed in their arrival order
+	 */
+	bool depends_on(Request const &other) const
+	{
+		return client && client == other.client
+		    && (write() || other.write())
+		    && first() < other.end() && other.first() < end();
+	}
+};
+
+
+class Blk_mux::Scheduler
+{
+	protected:
+
+		List<Request> _pending;  /* in arrival order */
+
+		unsigned long long _seq = 0;
+
+		/**
+		 * Return true if an older pending request must be dispatched first
+		 */
+		bool _blocked(Request const &r) const
+		{
+			for (Request const *o = _pending.first(); o != &r; o = o->next())
+				if (r.depends_on(*o))
+					return true;
+			return false;
+		}
+
+		/**
+		 * Insert request according to its arrival order
+		 */
+		void _insert(Request &r)
+		{
+			Request *prev = nullptr;
+			for (Request *o = _pending.first(); o && o->seq < r.seq; o = o->next())
+				prev = o;
+			_pending.insert(&r, prev);
+		}
+
+		/**
+		 * Select the request to be dispatched next
+		 *
+		 * Only requests that are not '_blocked' may be selected. The oldest
+		 * pending request is never blocked.
+		 */
+		virtual Request *_select(unsigned long now_ms) = 0;
+
+		/**
+		 * Assign scheduling tags to a new request
+		 */
+		virtual void _tag(Request &) { }
+
+	public:
+
+		virtual ~Scheduler() { }
+
+		bool empty() const { return !_pending.first(); }
+
+		void enqueue(Request &r)
+		{
+			_tag(r);
+			r.seq = ++_seq;
+			_insert(r);
+		}
+
+		/**
+		 * Return request that could not be dispatched to the queue
+		 *
+		 * The request keeps its tags and its position in arrival order.
+		 */
+		void requeue(Request &r) { _insert(r); }
+
+		/**
+		 * Remove and return request to be dispatched next
+		 */
+		Request *next(unsigned long now_ms)
+		{
+			Request *r = _select(now_ms);
+			if (r)
+				_pending.remove(r);
+			return r;
+		}
+
+		/**
+		 * Remove and return a request adjacent to the range 'first...end'
+		 *
+		 * \param max_blocks  maximum size of the returned request
+		 */
+		Request *take_adjacent(bool write, Block::sector_t first,
+		                       Block::sector_t end, size_t max_blocks)
+		{
+			for (Request *r = _pending.first(); r; r = r->next()) {
+				if (r->write() != write || r->packet.block_count() > max_blocks
+				 || _blocked(*r))
+					continue;
+
+				if (r->first() == end || r->end() == first) {
+					_pending.remove(r);
+					return r;
+				}
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Call 'fn' with each pending 'Request const &' of 'client'
+		 */
+		template <typename FN>
+		void for_each(Client const &client, FN const &fn) const
+		{
+			for (Request const *r = _pending.first(); r; r = r->next())
+				if (r->client == &client)
+					fn(*r);
+		}
+
+		/**
+		 * Remove all requests of 'client'
+		 *
+		 * \param fn  functor called with each removed 'Request &'
+		 */
+		template <typename FN>
+		void flush(Client const &client, FN const &fn)
+		{
+			for (Request *r = _pending.first(), *next = nullptr; r; r = next) {
+				next = r->next();
+				if (r->client == &client) {
+					_pending.remove(r);
+					fn(*r);
+				}
+			}
+		}
+};
+
+
+/**
+ * Deadline scheduler
+ *
+ * Requests are served in ascending block order starting at the position of
+ * the previously dispatched request, wrapping around at the end of the
+ * device. A request whose deadline expired takes precedence, the deadline
+ * is given by the policy of the client separately for reads and writes.
+ */
+class Blk_mux::Deadline_scheduler : public Scheduler
+{
+	private:
+
+		Block::sector_t _position = 0;
+
+	protected:
+
+		Request *_select(unsigned long now_ms) override
+		{
+			Request *earliest = nullptr, *ahead = nullptr, *lowest = nullptr;
+
+			for (Request *r = _pending.first(); r; r = r->next()) {
+
+				if (_blocked(*r))
+					continue;
+
+				/* on equal deadlines, the older request is preferred */
+				if (!earliest || (long)(r->deadline_ms - earliest->deadline_ms) < 0)
+					earliest = r;
+
+				if (r->first() >= _position && (!ahead || r->first() < ahead->first()))
+					ahead = r;
+
+				if (!lowest || r->first() < lowest->first())
+					lowest = r;
+			}
+
+			Request *r = ahead ? ahead : lowest;
+			if (earliest && (long)(now_ms - earliest->deadline_ms) >= 0)
+				r = earliest;
+
+			if (r)
+				_position = r->end();
+			return r;
+		}
+};
+
+
+/**
+ * Weighted fair queueing
+ *
+ * Each request is tagged with a virtual start and finish time. The finish
+ * time advances by the size of the request divided by the weight of the
+ * client. The request with the smallest finish time is dispatched first,
+ * which shares the bandwidth of the backend in proportion to the weights
+ * of the clients with pending requests.
+ */
+class Blk_mux::Fair_scheduler : public Scheduler
+{
+	private:
+
+		enum { COST_PER_BLOCK = 1024 };
+
+		unsigned long long _virtual_time = 0;
+
+	protected:
+
+		void _tag(Request &r) override
+		{
+			Client &c = *r.client;
+
+			r.start_tag  = max(_virtual_time, c.finish_tag);
+			r.finish_tag = r.start_tag + (COST_PER_BLOCK * r.packet.block_count())
+			                           / max(c.policy().weight, 1U);
+			c.finish_tag = r.finish_tag;
+		}
+
+		Request *_select(unsigned long) override
+		{
+			Request *first = nullptr;
+			for (Request *r = _pending.first(); r; r = r->next())
+				if (!_blocked(*r) && (!first || r->finish_tag < first->finish_tag))
+					first = r;
+
+			if (first)
+				_virtual_time = max(_virtual_time, first->start_tag);
+			return first;
+		}
+};
+
+#endif /* _BLK_MUX__SCHEDULER_H_ */
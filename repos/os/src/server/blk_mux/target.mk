@@ -0,0 +1,3 @@
+TARGET = blk_mux
+LIBS   = base server config
+SRC_CC = main.cc
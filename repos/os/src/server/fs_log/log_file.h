@@ -68,16 +68,30 @@ class Fs_log::Log_file : public List<Log_file>::Element
 
 		/**
 		 * Write a log message to the packet buffer.
+		 *
+		 * The message may consist of a batch of several log lines, which
+		 * are written with a single packet.
 		 */
 		size_t write(char const *msg, size_t msg_len)
 		{
 			File_system::Session::Tx::Source &source = *_fs.tx();
 
-			File_system::Packet_descriptor raw_packet;
+			/* release the packets already acknowledged by the server */
+			while (source.ack_avail())
+				source.release_packet(source.get_acked_packet());
+
+			/* block for acknowledgements if the queue or buffer is full */
 			if (!source.ready_to_submit())
-				raw_packet = source.get_acked_packet();
-			else
-				raw_packet = source.alloc_packet(Log_session::String::MAX_SIZE);
+				source.release_packet(source.get_acked_packet());
+
+			File_system::Packet_descriptor raw_packet;
+			for (;;) {
+				try {
+					raw_packet = source.alloc_packet(msg_len);
+					break;
+				} catch (File_system::Session::Tx::Source::Packet_alloc_failed) {
+					source.release_packet(source.get_acked_packet()); }
+			}
 
 			File_system::Packet_descriptor
 				packet(raw_packet,
@@ -18,6 +18,7 @@
 #include <root/component.h>
 #include <os/server.h>
 #include <os/session_policy.h>
+#include <os/config.h>
 #include <base/printf.h>
 
 /* Local includes */
@@ -34,6 +35,7 @@ namespace Fs_log {
 
 	enum {
 		 BLOCK_SIZE = Log_session::String::MAX_SIZE,
+		 RING_QUOTA = 16*1024,
 		 QUEUE_SIZE = File_system::Session::TX_QUEUE_SIZE,
 		TX_BUF_SIZE = BLOCK_SIZE * (QUEUE_SIZE*2 + 1)
 	};
@@ -47,10 +49,23 @@ class Fs_log::Root_component :
 {
 	private:
 
+		Server::Entrypoint      &_ep;
 		Allocator_avl            _write_alloc;
 		File_system::Connection  _fs;
 		List<Log_file>           _log_files;
 
+		/*
+		 * Let clients pass messages via a shared ring, which is drained
+		 * in batches
+		 */
+		static bool _ring_enabled()
+		{
+			try { return config()->xml_node().attribute_value("ring", false); }
+			catch (...) { return false; }
+		}
+
+		bool const _ring = _ring_enabled();
+
 		Log_file *lookup(char const *dir, char const *filename)
 		{
 			for (Log_file *file = _log_files.first(); file; file = file->next())
@@ -184,9 +199,15 @@ class Fs_log::Root_component :
 			if (!file)
 				throw Root::Unavailable();
 
+			/* clients with the quota of an older LOG connection lack a ring */
+			size_t const ram_quota =
+				Arg_string::find_arg(args, "ram_quota").ulong_value(0);
+			bool const ring = _ring && ram_quota >= RING_QUOTA;
+
 			if (*label_prefix)
-				return new (md_alloc()) Labeled_session_component(label_prefix, *file);
-			return new (md_alloc()) Unlabeled_session_component(*file);
+				return new (md_alloc())
+					Labeled_session_component(label_prefix, *file, _ep, ring);
+			return new (md_alloc()) Unlabeled_session_component(*file, _ep, ring);
 		}
 
 		void _destroy_session(Session_component *session)
@@ -207,6 +228,7 @@ class Fs_log::Root_component :
 		Root_component(Server::Entrypoint &ep, Allocator &alloc)
 		:
 			Genode::Root_component<Session_component>(&ep.rpc_ep(), &alloc),
+			_ep(ep),
 			_write_alloc(env()->heap()),
 			_fs(_write_alloc, TX_BUF_SIZE)
 		{ }
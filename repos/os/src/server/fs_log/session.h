@@ -19,8 +19,12 @@
 
 /* Genode includes */
 #include <log_session/log_session.h>
+#include <log_session/log_ring.h>
 #include <file_system_session/file_system_session.h>
+#include <os/attached_ram_dataspace.h>
+#include <os/server.h>
 #include <base/rpc_server.h>
+#include <util/construct_at.h>
 
 /* Local includes */
 #include "log_file.h"
@@ -33,86 +37,171 @@ namespace Fs_log {
 
 class Fs_log::Session_component : public Rpc_object<Log_session, Unlabeled_session_component>
 {
+	private:
+
+		/*
+		 * Messages are collected in the batch buffer and written to the
+		 * file with one packet per batch.
+		 */
+		enum { BATCH_SIZE = 4096 };
+
+		char   _batch[BATCH_SIZE];
+		size_t _batch_len = 0;
+
+		/*
+		 * Ring of messages shared with the client, used only if enabled
+		 * via the 'ring' config attribute
+		 */
+		Attached_ram_dataspace *_ring_ds = nullptr;
+		Log_ring               *_ring    = nullptr;
+
+		Signal_rpc_member<Session_component> _ring_dispatcher;
+
+		void _flush_batch()
+		{
+			if (_batch_len)
+				_log_file.write(_batch, _batch_len);
+
+			_batch_len = 0;
+		}
+
+		void _append(char const *msg, size_t msg_len)
+		{
+			if (_batch_len + _prefix_len + msg_len > BATCH_SIZE)
+				_flush_batch();
+
+			memcpy(_batch + _batch_len, _prefix, _prefix_len);
+			memcpy(_batch + _batch_len + _prefix_len, msg, msg_len);
+			_batch_len += _prefix_len + msg_len;
+		}
+
+		void _consume_ring()
+		{
+			if (_ring)
+				_ring->for_each([&] (Log_ring::Message const &m) {
+					_append(m.text, m.len); });
+		}
+
+		void _handle_ring(unsigned)
+		{
+			/* drain until the client observes that we wait for a signal */
+			do { drain(); } while (!_ring->wait_for_producer());
+		}
+
 	protected:
 
 		Log_file &_log_file;
 
-	public:
+		/* text prepended to each message */
+		char const *_prefix     = "";
+		size_t      _prefix_len = 0;
 
-		Session_component(Log_file &log_file)
-		: _log_file(log_file) { _log_file.incr(); }
+	public:
 
-		~Session_component() { _log_file.decr(); }
+		Session_component(Log_file &log_file, Server::Entrypoint &ep,
+		                  bool ring)
+		:
+			_ring_dispatcher(ep, *this, &Session_component::_handle_ring),
+			_log_file(log_file)
+		{
+			_log_file.incr();
 
-		Log_file *file() const { return &_log_file; }
+			if (!ring)
+				return;
 
-		virtual size_t write(String const &string) = 0;
-};
+			_ring_ds = new (env()->heap())
+				Attached_ram_dataspace(env()->ram_session(), sizeof(Log_ring));
+			_ring = construct_at<Log_ring>(_ring_ds->local_addr<void>());
+			_ring->wait_for_producer();
+		}
 
-class Fs_log::Unlabeled_session_component : public Session_component
-{
+		~Session_component()
+		{
+			if (_ring) {
+				drain();
+				destroy(env()->heap(), _ring_ds);
+			}
+			_log_file.decr();
+		}
 
-	public:
+		Log_file *file() const { return &_log_file; }
 
-		/**
-		 * Constructor
-		 */
-		Unlabeled_session_component(Log_file &log_file)
-		: Session_component(log_file) { }
 
 		/*****************
 		 ** Log session **
 		 *****************/
 
-		size_t write(Log_session::String const &msg)
+		size_t write(String const &msg)
 		{
 			if (!msg.is_valid_string()) {
 				PERR("corrupted string");
 				return 0;
 			}
 
+			/* preserve the order of messages already added to the ring */
+			_consume_ring();
+
 			char const *msg_str = msg.string();
 			size_t msg_len = Genode::strlen(msg_str);
 
-			return _log_file.write(msg_str, msg_len);
+			_append(msg_str, msg_len);
+			_flush_batch();
+			return msg_len;
+		}
+
+		Dataspace_capability ring() override
+		{
+			if (!_ring_ds)
+				return Dataspace_capability();
+
+			return _ring_ds->cap();
+		}
+
+		Signal_context_capability ring_sigh() override
+		{
+			if (!_ring)
+				return Signal_context_capability();
+
+			return _ring_dispatcher;
+		}
+
+		void drain() override
+		{
+			_consume_ring();
+			_flush_batch();
 		}
 };
 
+class Fs_log::Unlabeled_session_component : public Session_component
+{
+	public:
+
+		/**
+		 * Constructor
+		 */
+		Unlabeled_session_component(Log_file &log_file, Server::Entrypoint &ep,
+		                            bool ring)
+		: Session_component(log_file, ep, ring) { }
+};
+
 class Fs_log::Labeled_session_component : public Session_component
 {
 	private:
 
 		char      _label[Log_session::String::MAX_SIZE];
-		size_t    _label_len;
 
 	public:
 
 		/**
 		 * Constructor
 		 */
-		Labeled_session_component(char const *label, Log_file &log_file)
-		: Session_component(log_file)
+		Labeled_session_component(char const *label, Log_file &log_file,
+		                          Server::Entrypoint &ep, bool ring)
+		: Session_component(log_file, ep, ring)
 		{
 			snprintf(_label, sizeof(_label), "[%s] ", label);
-			_label_len = strlen(_label);
-		}
-
-		/*****************
-		 ** Log session **
-		 *****************/
-
-		size_t write(Log_session::String const &msg)
-		{
-			if (!msg.is_valid_string()) {
-				PERR("corrupted string");
-				return 0;
-			}
-
-			char const *msg_str = msg.string();
-			size_t msg_len = Genode::strlen(msg_str);
-
-			_log_file.write(_label, _label_len);
-			return _log_file.write(msg_str, msg_len);
+			_prefix     = _label;
+			_prefix_len = strlen(_label);
 		}
 };
 
@@ -46,6 +46,11 @@ namespace Input_merger
 			Input::Session_client session_client;
 			Attached_dataspace    dataspace;
 
+			/* event ring of the source, drained without any RPC */
+			Input::Event_ring * const ring =
+				Input::Event_ring::lookup(dataspace.local_addr<void>(),
+				                          dataspace.size());
+
 			Input_source(const char *label)
 			: session_client(_create_session(label)),
 		  	  dataspace(session_client.dataspace()) { }
@@ -88,9 +93,10 @@ struct Input_merger::Main
 			Input::Event const * const events =
 				input_source->dataspace.local_addr<Input::Event>();
 
-			unsigned const num = input_source->session_client.flush();
-			for (unsigned i = 0; i < num; i++)
-				input_session_component.submit(events[i]);
+			Input::Event_ring::consume(input_source->ring,
+			                           input_source->session_client, events,
+			                           [&] (Input::Event const &ev) {
+				input_session_component.submit(ev); });
 		}
 	}
 
@@ -17,7 +17,10 @@
 #include <base/env.h>
 
 /**
- * Fifo-based physical backing-store allocator
+ * LRU-based physical backing-store allocator
+ *
+ * Blocks are handed out in least-recently-used order. A user of a block
+ * marks the block as recently used by calling 'touch'.
  *
  * \param UMD  user-specific metadata attached to each backing-store block,
  *             for example the corresponding offset within a managed
@@ -67,10 +70,15 @@ class Backing_store
 				 */
 				UMD _user_meta_data;
 
+				/**
+				 * Neighbours within the LRU list
+				 */
+				Block *_lru_prev, *_lru_next;
+
 				/**
 				 * Default constructor used for array allocation
 				 */
-				Block() : _user(0) { }
+				Block() : _user(0), _lru_prev(0), _lru_next(0) { }
 
 				/**
 				 * Used by 'Backing_store::assign'
@@ -134,23 +142,33 @@ class Backing_store
 		Block *_blocks;
 
 		/**
-		 * Block index for next allocation (used for fifo)
+		 * LRU list, the head is the next candidate for eviction
 		 */
-		unsigned long _curr_block_idx;
+		Block *_lru_head, *_lru_tail;
 
-		/**
-		 * Return meta data of next-to-be-allocated block
-		 */
-		Block *_curr_block() const { return &_blocks[_curr_block_idx]; }
+		void _lru_remove(Block *b)
+		{
+			if (b->_lru_prev) b->_lru_prev->_lru_next = b->_lru_next;
+			else              _lru_head               = b->_lru_next;
+
+			if (b->_lru_next) b->_lru_next->_lru_prev = b->_lru_prev;
+			else              _lru_tail               = b->_lru_prev;
+
+			b->_lru_prev = b->_lru_next = 0;
+		}
 
 		/**
-		 * Advance fifo allocation index
+		 * Mark block as most recently used
 		 */
-		void _advance_curr_block()
+		void _lru_append(Block *b)
 		{
-			_curr_block_idx++;
-			if (_curr_block_idx == _num_blocks)
-				_curr_block_idx = 0;
+			b->_lru_prev = _lru_tail;
+			b->_lru_next = 0;
+
+			if (_lru_tail) _lru_tail->_lru_next = b;
+			else           _lru_head            = b;
+
+			_lru_tail = b;
 		}
 
 		/**
@@ -178,31 +196,54 @@ class Backing_store
 			_ds(Genode::env()->ram_session()->alloc(_block_size*_num_blocks)),
 			_ds_addr(Genode::env()->rm_session()->attach(_ds)),
 			_blocks(new (Genode::env()->heap()) Block[_num_blocks]),
-			_curr_block_idx(0)
-		{ }
+			_lru_head(0), _lru_tail(0)
+		{
+			for (unsigned i = 0; i < _num_blocks; i++)
+				_lru_append(&_blocks[i]);
+		}
 
+		/**
+		 * Allocate least recently used block
+		 *
+		 * \return  block, or 0 if all blocks are in the process of being
+		 *          assigned
+		 */
 		Block *alloc()
 		{
 			Genode::Lock::Guard guard(_alloc_lock);
 
 			/* skip blocks that are currently in the process of being assigned */
-			while (_curr_block()->user() == &_not_yet_assigned) {
+			Block *block = _lru_head;
+			while (block && block->user() == &_not_yet_assigned) {
 				PDBG("skipping not-yet assigned block");
-				_advance_curr_block();
+				block = block->_lru_next;
 			}
 
+			if (!block)
+				return 0;
+
 			/* evict block if needed */
-			if (_curr_block()->is_occupied())
-				_curr_block()->evict();
+			if (block->is_occupied())
+				block->evict();
 
 			/* reserve allocated block (prevent eviction prior assignment) */
-			Block *block = _curr_block();
 			block->assign_pseudo_user(&_not_yet_assigned);
 
-			_advance_curr_block();
+			_lru_remove(block);
+			_lru_append(block);
 			return block;
 		}
 
+		/**
+		 * Mark block as recently used
+		 */
+		void touch(Block *block)
+		{
+			Genode::Lock::Guard guard(_alloc_lock);
+			_lru_remove(block);
+			_lru_append(block);
+		}
+
 		/**
 		 * Return dataspace containing the backing store payload
 		 */
@@ -213,6 +254,16 @@ class Backing_store
 		 */
 		Genode::size_t block_size() const { return _block_size; }
 
+		/**
+		 * Return number of physical blocks
+		 */
+		Genode::size_t num_blocks() const { return _num_blocks; }
+
+		/**
+		 * Return block with the specified index
+		 */
+		Block *block(unsigned long index) const { return &_blocks[index]; }
+
 		/**
 		 * Return block index of specified block
 		 */
@@ -0,0 +1,171 @@
+/*
+ * \brief  Cache for ISO sectors
+ * \author agent
+ * \date   2015-11-24
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _BLOCK_CACHE_H_
+#define _BLOCK_CACHE_H_
+
+#include <base/lock.h>
+#include <util/string.h>
+
+/* local includes */
+#include "backing_store.h"
+#include "iso9660.h"
+
+namespace Iso { class Block_cache; }
+
+
+/**
+ * LRU cache of ISO sectors
+ *
+ * The cache is primarily used for directory extents, which are read over
+ * and over again when resolving paths. Cached sectors are found via a hash
+ * table keyed by the sector number.
+ */
+class Iso::Block_cache : private ::Backing_store<unsigned long>::User
+{
+	public:
+
+		struct Stats
+		{
+			unsigned long hits = 0, misses = 0, evictions = 0;
+		};
+
+	private:
+
+		typedef ::Backing_store<unsigned long> Store;
+		typedef Store::Block                   Block;
+
+		enum { INVALID = ~0UL };
+
+		Genode::Lock _lock;
+
+		Store _store;
+
+		Genode::size_t const _num_blocks;
+
+		/*
+		 * Hash table, indexed by backing-store block index
+		 */
+		unsigned long *_blk_nr;      /* sector held by block */
+		unsigned long *_chain;       /* next block within hash bucket */
+		unsigned long *_buckets;     /* first block of each bucket */
+
+		Stats _stats;
+
+		static unsigned long *_alloc_array(Genode::size_t num)
+		{
+			unsigned long *array = new (Genode::env()->heap()) unsigned long[num];
+			for (Genode::size_t i = 0; i < num; i++)
+				array[i] = INVALID;
+			return array;
+		}
+
+		unsigned long &_bucket(unsigned long blk_nr) {
+			return _buckets[blk_nr % _num_blocks]; }
+
+		unsigned long _lookup(unsigned long blk_nr)
+		{
+			unsigned long i = _bucket(blk_nr);
+			for (; i != INVALID && _blk_nr[i] != blk_nr; i = _chain[i]);
+			return i;
+		}
+
+		/**
+		 * Backing_store::User interface, called on eviction
+		 */
+		void detach_block(unsigned long blk_nr) override
+		{
+			unsigned long *link = &_bucket(blk_nr);
+			for (; *link != INVALID; link = &_chain[*link]) {
+				if (_blk_nr[*link] != blk_nr)
+					continue;
+
+				unsigned long const i = *link;
+				*link = _chain[i];
+				_chain[i] = INVALID;
+				_blk_nr[i] = INVALID;
+				_stats.evictions++;
+				return;
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param ram_size  RAM used for the cache including meta data
+		 * \param blk_size  size of one sector
+		 */
+		Block_cache(Genode::size_t ram_size, Genode::size_t blk_size)
+		:
+			/* account the hash-table meta data of each block */
+			_store((ram_size/(blk_size + 3*sizeof(unsigned long)))*blk_size, blk_size),
+			_num_blocks(_store.num_blocks()),
+			_blk_nr (_alloc_array(_num_blocks)),
+			_chain  (_alloc_array(_num_blocks)),
+			_buckets(_alloc_array(_num_blocks))
+		{ }
+
+		/**
+		 * Obtain sector 'blk_nr'
+		 *
+		 * \param fetch  functor called with the sector number and a
+		 *               destination buffer if the sector is not cached
+		 * \param fn     functor called with the sector content
+		 */
+		template <typename FETCH, typename FN>
+		void with_block(unsigned long blk_nr, FETCH const &fetch, FN const &fn)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			unsigned long const i = _lookup(blk_nr);
+			if (i != INVALID) {
+				Block *block = _store.block(i);
+				_store.touch(block);
+				_stats.hits++;
+				fn(_store.local_addr(block));
+				return;
+			}
+
+			_stats.misses++;
+
+			/*
+			 * Blocks are assigned while holding '_lock'. Hence, there is
+			 * always a block available for eviction.
+			 */
+			Block *block = _store.alloc();
+			if (!block)
+				throw Io_error();
+
+			unsigned long const idx = _store.index(block);
+			try { fetch(blk_nr, _store.local_addr(block)); }
+			catch (...) {
+				_store.assign(block, 0, blk_nr);
+				throw;
+			}
+
+			_blk_nr[idx]     = blk_nr;
+			_chain[idx]      = _bucket(blk_nr);
+			_bucket(blk_nr)  = idx;
+			_store.assign(block, this, blk_nr);
+
+			fn(_store.local_addr(block));
+		}
+
+		Stats stats() const { return _stats; }
+
+		Genode::size_t num_blocks() const { return _num_blocks; }
+};
+
+#endif /* _BLOCK_CACHE_H_ */
@@ -17,10 +17,14 @@
 #include <base/printf.h>
 #include <base/stdint.h>
 #include <block_session/connection.h>
+#include <os/config.h>
+#include <os/reporter.h>
+#include <util/avl_string.h>
 #include <util/misc_math.h>
 #include <util/token.h>
 
 #include "iso9660.h"
+#include "block_cache.h"
 
 using namespace Genode;
 
@@ -36,6 +40,9 @@ namespace Iso {
 			enum {
 				MAX_SECTORS = 32, /* max. number sectors that can be read in one
 				                     transaction */
+
+				MAX_IN_FLIGHT = 4, /* max. number of outstanding transactions
+				                      during sequential reads */
 			};
 
 			static Block::Connection          *_blk;
@@ -89,8 +96,142 @@ namespace Iso {
 
 			static unsigned long to_blk(unsigned long bytes) {
 				return ((bytes + blk_size() - 1) & ~(blk_size() - 1)) / blk_size(); }
+
+			/**
+			 * Read 'count' sectors starting at 'blk_nr' into 'dst'
+			 *
+			 * Up to 'MAX_IN_FLIGHT' transactions are kept in flight such
+			 * that the device reads ahead while the content of completed
+			 * transactions is copied. Transactions may complete in any
+			 * order.
+			 *
+			 * \return number of sectors that were read ahead
+			 */
+			static unsigned long read_sequential(unsigned long blk_nr,
+			                                     unsigned long count, void *dst)
+			{
+				Lock::Guard lock_guard(_lock);
+
+				unsigned long next = blk_nr, end = blk_nr + count;
+				unsigned long read_ahead = 0;
+				unsigned in_flight = 0;
+				bool failed = false;
+
+				while ((next < end && !failed) || in_flight) {
+
+					/* submit further transactions while the device is busy */
+					while (next < end && !failed && in_flight < MAX_IN_FLIGHT
+					    && _source->ready_to_submit()) {
+
+						unsigned long const n = min<unsigned long>(MAX_SECTORS, end - next);
+
+						Block::Packet_descriptor p;
+						try {
+							p = Block::Packet_descriptor(
+								_blk->dma_alloc_packet(blk_size() * n),
+								Block::Packet_descriptor::READ,
+								(Block::sector_t)next * blk_size() / _blk_size,
+								n * blk_size() / _blk_size);
+						} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+
+							/* packet buffer exhausted, wait for completions */
+							if (in_flight) break;
+
+							PERR("Packet overrun!");
+							throw Io_error();
+						}
+
+						_source->submit_packet(p);
+
+						if (in_flight)
+							read_ahead += n;
+
+						next += n;
+						in_flight++;
+					}
+
+					/* never block for an acknowledgement that cannot arrive */
+					if (!in_flight) {
+						if (failed || next >= end)
+							break;
+
+						PERR("cannot submit block request");
+						throw Io_error();
+					}
+
+					Block::Packet_descriptor p = _source->get_acked_packet();
+					in_flight--;
+
+					if (p.succeeded()) {
+						Genode::uint64_t const offset = (Genode::uint64_t)p.block_number()*_blk_size
+						                              - (Genode::uint64_t)blk_nr*blk_size();
+						memcpy((char *)dst + offset, _source->packet_content(p), p.size());
+					} else {
+						PERR("Could not read block %llu", (unsigned long long)p.block_number());
+						failed = true;
+					}
+
+					_source->release_packet(p);
+				}
+
+				if (failed)
+					throw Io_error();
+
+				return read_ahead;
+			}
 	};
 
+
+	/**
+	 * Statistics of the caches, used for sizing the block cache
+	 */
+	struct Stats
+	{
+		unsigned long dir_hits = 0, dir_misses = 0;
+		unsigned long read_ahead = 0;
+	};
+
+	static Stats &stats()
+	{
+		static Stats inst;
+		return inst;
+	}
+
+
+	/**
+	 * Return size of the sector cache as configured
+	 */
+	static size_t config_cache_size()
+	{
+		enum { DEFAULT_CACHE_SIZE = 1024*1024, MIN_CACHE_SIZE = 64*1024 };
+
+		Number_of_bytes size = DEFAULT_CACHE_SIZE;
+		try { config()->xml_node().attribute("cache_size").value(&size); }
+		catch (...) { }
+
+		return max((size_t)size, (size_t)MIN_CACHE_SIZE);
+	}
+
+
+	/**
+	 * Cache for sectors of directory extents
+	 */
+	static Block_cache &block_cache()
+	{
+		static Block_cache inst(config_cache_size(), Sector::blk_size());
+		return inst;
+	}
+
+
+	/**
+	 * Fetch a single sector into 'dst', used to populate the block cache
+	 */
+	static void fetch_sector(unsigned long blk_nr, void *dst)
+	{
+		Sector sec(blk_nr, 1);
+		memcpy(dst, sec.addr<void *>(), Sector::blk_size());
+	}
+
 	/**
 	 * Rock ridge extension (see IEEE P1282)
 	 */
@@ -363,35 +504,21 @@ namespace Iso {
 	{
 		uint8_t *buf = (uint8_t *)buf_ptr;
 		if (info->size() <= (size_t)(length + file_offset))
-			length = info->size() - file_offset - 1;
+			length = info->size() - file_offset;
 
-		unsigned long total_blk_count = ((length + (Sector::blk_size() - 1)) &
-		                                 ~((Sector::blk_size()) - 1)) / Sector::blk_size();
-		unsigned long ret = total_blk_count;
-		unsigned long blk_count;
+		unsigned long total_blk_count = Sector::to_blk(length);
 		unsigned long blk_nr = info->blk_nr() + (file_offset / Sector::blk_size());
 
 		if (verbose)
 			PDBG("Read blk %lu count %lu, file_offset: %08lx length %u", blk_nr, total_blk_count, file_offset, length);
 
-		while ((blk_count = min<unsigned long>(Sector::MAX_SECTORS, total_blk_count))) {
-			Sector sec(blk_nr, blk_count);
-
-			total_blk_count -= blk_count;
-			blk_nr          += blk_count;
+		stats().read_ahead += Sector::read_sequential(blk_nr, total_blk_count, buf);
 
-			unsigned long copy_length = blk_count * Sector::blk_size();
-			memcpy(buf, sec.addr<void *>(), copy_length);
+		/* zero out rest of page */
+		if (total_blk_count % 2)
+			memset(buf + total_blk_count*Sector::blk_size(), 0, Sector::blk_size());
 
-			length -= copy_length;
-			buf    += copy_length;
-
-			/* zero out rest of page */
-			if (!total_blk_count && (blk_count % 2))
-				memset(buf, 0, Sector::blk_size());
-		}
-	
-		return ret * Sector::blk_size();
+		return total_blk_count * Sector::blk_size();
 	}
 
 
@@ -406,16 +533,103 @@ namespace Iso {
 	typedef ::Genode::Token<Scanner_policy_file> Token;
 
 
+	/**
+	 * Location of a directory record on disk
+	 */
+	struct Record_info
+	{
+		uint32_t blk_nr;
+		uint32_t data_length;
+		bool     directory;
+	};
+
+
+	/**
+	 * Index of already resolved paths
+	 *
+	 * The index avoids the repeated parsing of directory extents when
+	 * opening files located in the same directory.
+	 */
+	class Dir_index
+	{
+		private:
+
+			struct Entry : Avl_string<PATH_LENGTH>
+			{
+				Record_info const info;
+
+				Entry(char const *path, Record_info const &info)
+				: Avl_string<PATH_LENGTH>(path), info(info) { }
+			};
+
+			Avl_tree<Avl_string_base> _tree;
+
+		public:
+
+			Record_info const *lookup(char const *path)
+			{
+				Avl_string_base *node = _tree.first();
+				Entry *e = node ? static_cast<Entry *>(node->find_by_name(path)) : 0;
+				return e ? &e->info : 0;
+			}
+
+			void insert(char const *path, Record_info const &info) {
+				_tree.insert(new (env()->heap()) Entry(path, info)); }
+	};
+
+
+	/**
+	 * Search directory extent 'dir' for record named 'name'
+	 *
+	 * \throw File_not_found
+	 */
+	static Record_info lookup_record(Record_info const &dir, char *name)
+	{
+		for (unsigned long i = 0; i < Sector::to_blk(dir.data_length); i++) {
+
+			Record_info result;
+			bool found = false;
+
+			block_cache().with_block(dir.blk_nr + i, fetch_sector, [&] (void *data) {
+
+				Directory_record *record =
+					static_cast<Directory_record *>(data)->locate(name);
+
+				if (!record) return;
+
+				result.blk_nr      = record->blk_nr();
+				result.data_length = record->data_length();
+				result.directory   = record->is_directory();
+				found = true;
+			});
+
+			if (found)
+				return result;
+		}
+
+		throw File_not_found();
+	}
+
+
 	/**
 	 * ISO interface
 	 */
 	File_info *file_info(char *path)
 	{
+		static Lock      lock;
+		static Dir_index dir_index;
+
+		Lock::Guard guard(lock);
+
 		char level[PATH_LENGTH];
 
+		/* path resolved so far */
+		char walked[PATH_LENGTH];
+		walked[0] = 0;
+
 		Token t(path);
-		Directory_record *dir = root_dir();
-		uint32_t blk_nr = 0, data_length = 0;
+		Directory_record *root = root_dir();
+		Record_info curr = { root->blk_nr(), root->data_length(), true };
 
 		/* determine block nr and file length on disk, parse directory records */
 		while (t) {
@@ -427,45 +641,77 @@ namespace Iso {
 
 			t.string(level, PATH_LENGTH);
 
-			/* load extent of directory record and search for level */
-			for (unsigned long i = 0; i < Sector::to_blk(dir->data_length()); i++) {
-				Sector sec(dir->blk_nr() + i, 1);
-				Directory_record *tmp = sec.addr<Directory_record *>()->locate(level);
-
-				if (!tmp && i == Sector::to_blk(dir->data_length()) - 1) {
-					PERR("File not found: %s", path);
-					throw File_not_found();
-				}
-
-				if (!tmp) continue;
-
-				dir = tmp;
+			size_t const walked_len = strlen(walked);
+			if (!curr.directory || walked_len + strlen(level) + 2 > sizeof(walked)) {
+				PERR("File not found: %s", path);
+				throw File_not_found();
+			}
 
-				if (verbose)
-					PDBG("Found %s", level);
+			walked[walked_len] = '/';
+			strncpy(walked + walked_len + 1, level, sizeof(walked) - walked_len - 1);
 
-				if (!dir->is_directory()) {
-					blk_nr      = dir->blk_nr();
-					data_length = dir->data_length();
+			Record_info const *cached = dir_index.lookup(walked);
+			if (cached) {
+				curr = *cached;
+				stats().dir_hits++;
+			} else {
+				try { curr = lookup_record(curr, level); }
+				catch (File_not_found) {
+					PERR("File not found: %s", path);
+					throw;
 				}
-
-				break;
+				dir_index.insert(walked, curr);
+				stats().dir_misses++;
 			}
 
+			if (verbose)
+				PDBG("Found %s", level);
+
 			t = t.next();
 		}
 
-		/* Warning: Don't access 'dir' after this point, since the sector is gone */
-
-		if (!blk_nr && !data_length) {
+		if (curr.directory) {
 			PERR("File not found: %s", path);
 			throw File_not_found();
 		}
 
 		if (verbose)
-			PDBG("Path: %s Block nr: %u Length: %u", path, blk_nr, data_length);
+			PDBG("Path: %s Block nr: %u Length: %u", path, curr.blk_nr, curr.data_length);
 
-		return new(env()->heap()) File_info(blk_nr, data_length);
+		return new(env()->heap()) File_info(curr.blk_nr, curr.data_length);
+	}
+
+
+	void report_stats()
+	{
+		static Reporter reporter("cache");
+
+		try {
+			reporter.enabled(config()->xml_node().sub_node("report")
+			                                     .attribute("cache")
+			                                     .has_value("yes"));
+		} catch (...) { reporter.enabled(false); }
+
+		if (!reporter.is_enabled())
+			return;
+
+		Block_cache::Stats const blk = block_cache().stats();
+
+		Reporter::Xml_generator xml(reporter, [&] () {
+			xml.node("blocks", [&] () {
+				xml.attribute("size",      block_cache().num_blocks());
+				xml.attribute("hits",      blk.hits);
+				xml.attribute("misses",    blk.misses);
+				xml.attribute("evictions", blk.evictions);
+			});
+			xml.node("paths", [&] () {
+				xml.attribute("hits",   stats().dir_hits);
+				xml.attribute("misses", stats().dir_misses);
+			});
+			xml.node("read_ahead", [&] () {
+				xml.attribute("blocks", stats().read_ahead);
+			});
+		});
 	}
 
 
@@ -483,8 +729,10 @@ namespace Iso {
 	 */
 	void __attribute__((constructor)) init()
 	{
+		enum { TX_BUF_SIZE = Sector::MAX_IN_FLIGHT * Sector::MAX_SECTORS * 2048 + 4096 };
+
 		static Allocator_avl block_alloc(env()->heap());
-		static Block::Connection _blk(&block_alloc);
+		static Block::Connection _blk(&block_alloc, TX_BUF_SIZE);
 
 		Sector::_blk    = &_blk;
 		Sector::_source  = _blk.tx();
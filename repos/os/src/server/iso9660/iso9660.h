@@ -11,6 +11,9 @@
  * under the terms of the GNU General Public License version 2.
  */
 
+#ifndef _ISO9660_H_
+#define _ISO9660_H_
+
 #include <rom_session/rom_session.h>
 #include <base/stdint.h>
 
@@ -78,4 +81,11 @@ namespace Iso {
 	 */
 	unsigned long read_file(File_info *info, Genode::off_t file_offset,
 	                        Genode::uint32_t length, void *buf);
+
+	/**
+	 * Report cache statistics if enabled by the configuration
+	 */
+	void report_stats();
 }
+
+#endif /* _ISO9660_H_ */
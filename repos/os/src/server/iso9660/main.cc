@@ -143,7 +143,9 @@ namespace Iso {
 					PDBG("Request for file %s lrn %zu", _path, strlen(_path));
 
 				try {
-					return new (md_alloc()) Rom_component(_path);
+					Rom_component *rom = new (md_alloc()) Rom_component(_path);
+					report_stats();
+					return rom;
 				}
 				catch (Io_error)       { throw Root::Unavailable(); }
 				catch (Non_data_disc)  { throw Root::Unavailable(); }
@@ -1,3 +1,3 @@
 TARGET = iso9660
 SRC_CC = main.cc iso9660.cc
-LIBS   = base
+LIBS   = base config
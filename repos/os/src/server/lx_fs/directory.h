@@ -63,6 +63,65 @@ class File_system::Directory : public Node
 			return fd;
 		}
 
+		static size_t _num_entries(DIR *fd)
+		{
+			unsigned num = 0;
+
+			rewinddir(fd);
+			while (readdir(fd)) ++num;
+
+			return num;
+		}
+
+		/**
+		 * Obtain type and status of directory entry
+		 *
+		 * \return  false if the entry is not a file, directory, or symlink
+		 */
+		bool _entry_status(char const *name, Directory_entry_status &e)
+		{
+			struct stat s;
+			if (fstatat(dirfd(_fd), name, &s, AT_SYMLINK_NOFOLLOW) == -1)
+				return false;
+
+			e.status.inode = s.st_ino;
+			e.status.size  = s.st_size;
+
+			if (S_ISREG(s.st_mode)) {
+				e.entry.type  = Directory_entry::TYPE_FILE;
+				e.status.mode = Status::MODE_FILE;
+				return true;
+			}
+
+			if (S_ISLNK(s.st_mode)) {
+				e.entry.type  = Directory_entry::TYPE_SYMLINK;
+				e.status.mode = Status::MODE_SYMLINK;
+				return true;
+			}
+
+			if (!S_ISDIR(s.st_mode))
+				return false;
+
+			e.entry.type  = Directory_entry::TYPE_DIRECTORY;
+			e.status.mode = Status::MODE_DIRECTORY;
+
+			/* the size of a directory is given by its number of entries */
+			e.status.size = 0;
+			int const fd = openat(dirfd(_fd), name, O_RDONLY | O_DIRECTORY);
+			if (fd == -1)
+				return true;
+
+			DIR *dir = fdopendir(fd);
+			if (!dir) {
+				close(fd);
+				return true;
+			}
+
+			e.status.size = _num_entries(dir)*sizeof(Directory_entry);
+			closedir(dir);
+			return true;
+		}
+
 	public:
 
 		Directory(Allocator &alloc, char const *path, bool create)
@@ -174,15 +233,47 @@ class File_system::Directory : public Node
 			return 0;
 		}
 
-		size_t num_entries() const
+		/**
+		 * Read directory entries along with the status of each entry
+		 *
+		 * In contrast to 'read', the directory stream is traversed only
+		 * once for all entries that fit into 'dst'.
+		 */
+		size_t read_status(char *dst, size_t len, seek_off_t seek_offset)
 		{
-			unsigned num = 0;
+			if (seek_offset % sizeof(Directory_entry_status)) {
+				PERR("seek offset not aligned to sizeof(Directory_entry_status)");
+				return 0;
+			}
+
+			seek_off_t const index = seek_offset / sizeof(Directory_entry_status);
 
 			rewinddir(_fd);
-			while (readdir(_fd)) ++num;
+			for (seek_off_t i = 0; i < index; i++)
+				if (!readdir(_fd))
+					return 0;
 
-			return num;
+			size_t res_length = 0;
+			while (len - res_length >= sizeof(Directory_entry_status)) {
+
+				struct dirent *dent = readdir(_fd);
+				if (!dent)
+					break;
+
+				Directory_entry_status e;
+				if (!_entry_status(dent->d_name, e))
+					break;
+
+				strncpy(e.entry.name, dent->d_name, sizeof(e.entry.name));
+
+				/* the packet payload is not necessarily aligned */
+				Genode::memcpy(dst + res_length, &e, sizeof(e));
+				res_length += sizeof(e);
+			}
+			return res_length;
 		}
+
+		size_t num_entries() const { return _num_entries(_fd); }
 };
 
 #endif /* _DIRECTORY_H_ */
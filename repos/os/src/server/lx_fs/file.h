@@ -22,8 +22,45 @@ class File_system::File : public Node
 {
 	private:
 
+		/*
+		 * Amount of data the host is asked to read ahead when sequential
+		 * reads are detected
+		 */
+		enum { READ_AHEAD_SIZE = 512*1024 };
+
 		int _fd;
 
+		/**
+		 * Serializes the determination of the file end with the write
+		 * operation when appending
+		 */
+		Genode::Lock _append_lock;
+
+		/**
+		 * End of the most recent read, used to detect sequential access
+		 */
+		Genode::Lock _read_state_lock;
+		seek_off_t   _read_end = 0;
+
+		/**
+		 * Ask the host to read ahead if the read continues the previous one
+		 *
+		 * Reads may be executed concurrently by multiple I/O threads.
+		 */
+		void _read_ahead(size_t len, seek_off_t seek_offset)
+		{
+			bool sequential = false;
+			{
+				Genode::Lock::Guard guard(_read_state_lock);
+				sequential = (seek_offset == _read_end);
+				_read_end  = seek_offset + len;
+			}
+
+			if (sequential)
+				posix_fadvise(_fd, seek_offset + len, READ_AHEAD_SIZE,
+				              POSIX_FADV_WILLNEED);
+		}
+
 		unsigned long _inode(int dir, char const *name, bool create)
 		{
 			int ret;
@@ -97,6 +134,8 @@ class File_system::File : public Node
 
 		size_t read(char *dst, size_t len, seek_off_t seek_offset)
 		{
+			_read_ahead(len, seek_offset);
+
 			int ret = pread(_fd, dst, len, seek_offset);
 
 			return ret == -1 ? 0 : ret;
@@ -106,10 +145,14 @@ class File_system::File : public Node
 		{
 			/* should we append? */
 			if (seek_offset == ~0ULL) {
+				Genode::Lock::Guard guard(_append_lock);
+
 				::off_t off = lseek(_fd, 0, SEEK_END);
 				if (off == -1)
 					return 0;
-				seek_offset = off;
+
+				int ret = pwrite(_fd, src, len, off);
+				return ret == -1 ? 0 : ret;
 			}
 
 			int ret = pwrite(_fd, src, len, seek_offset);
@@ -0,0 +1,210 @@
+/*
+ * \brief  Pool of threads performing host file I/O
+ * \author agent
+ * \date   2015-11-25
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _IO_POOL_H_
+#define _IO_POOL_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <util/fifo.h>
+
+/* local includes */
+#include <file.h>
+
+
+namespace File_system {
+	struct Io_job;
+	class  Io_pool;
+}
+
+
+/**
+ * Packet operation on a file to be executed by the I/O pool
+ */
+struct File_system::Io_job : Genode::Fifo<Io_job>::Element
+{
+	struct Owner
+	{
+		/**
+		 * Called in the context of an I/O thread once the job is completed
+		 */
+		virtual void completed(Io_job &) = 0;
+	};
+
+	Owner             *owner   = 0;
+	File              *file    = 0;
+	char              *content = 0;
+	Packet_descriptor  packet;
+};
+
+
+/**
+ * Threads that execute blocking host I/O on behalf of the entrypoint
+ *
+ * The entrypoint hands out file read and write operations to the pool
+ * such that a slow host file does not stall the other clients. Jobs are
+ * executed concurrently and may complete in any order. A job is never
+ * started while an older job that accesses an overlapping range of the
+ * same file is pending or executed and one of both jobs is a write.
+ */
+class File_system::Io_pool
+{
+	private:
+
+		enum { STACK_SIZE = 4096*sizeof(long) };
+
+		Genode::Lock         _lock;
+		Genode::Fifo<Io_job> _pending;  /* in submission order */
+		Genode::Fifo<Io_job> _active;   /* executed by a worker */
+		unsigned             _idle = 0; /* workers waiting for a job */
+		Genode::Semaphore    _wakeup;
+
+		struct Worker : Genode::Thread<STACK_SIZE>
+		{
+			Io_pool &pool;
+
+			Worker(Io_pool &pool) : Thread("lx_fs_io"), pool(pool) { start(); }
+
+			void entry() override
+			{
+				for (;;)
+					pool._execute(pool._dequeue());
+			}
+		};
+
+		static bool _write(Io_job const &job) {
+			return job.packet.operation() == Packet_descriptor::WRITE; }
+
+		/**
+		 * Return true if the order of the jobs must be preserved
+		 */
+		static bool _conflict(Io_job const &a, Io_job const &b)
+		{
+			if (a.file != b.file || (!_write(a) && !_write(b)))
+				return false;
+
+			seek_off_t const a_end = a.packet.position() + a.packet.length();
+			seek_off_t const b_end = b.packet.position() + b.packet.length();
+
+			return a.packet.position() < b_end && b.packet.position() < a_end;
+		}
+
+		/**
+		 * Return true if 'job' conflicts with an active or older pending job
+		 */
+		bool _blocked(Io_job const &job) const
+		{
+			for (Io_job *j = _active.head(); j; j = j->next())
+				if (_conflict(*j, job))
+					return true;
+
+			for (Io_job *j = _pending.head(); j != &job; j = j->next())
+				if (_conflict(*j, job))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Wake up workers waiting for a job, called with '_lock' held
+		 */
+		void _wake(unsigned count)
+		{
+			for (; count && _idle; count--, _idle--)
+				_wakeup.up();
+		}
+
+		Io_job &_dequeue()
+		{
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_lock);
+
+					for (Io_job *job = _pending.head(); job; job = job->next()) {
+						if (_blocked(*job))
+							continue;
+
+						_pending.remove(job);
+						_active.enqueue(job);
+						return *job;
+					}
+					_idle++;
+				}
+				_wakeup.down();
+			}
+		}
+
+		void _execute(Io_job &job)
+		{
+			Packet_descriptor &packet = job.packet;
+
+			size_t const     length = packet.length();
+			seek_off_t const offset = packet.position();
+
+			/* resulting length */
+			size_t res_length = 0;
+
+			switch (packet.operation()) {
+
+			case Packet_descriptor::READ:
+				res_length = job.file->read(job.content, length, offset);
+				break;
+
+			case Packet_descriptor::WRITE:
+				res_length = job.file->write(job.content, length, offset);
+				break;
+
+			default:
+				break;
+			}
+
+			/* jobs that waited for this one may proceed now */
+			{
+				Genode::Lock::Guard guard(_lock);
+				_active.remove(&job);
+				_wake(~0U);
+			}
+
+			packet.length(res_length);
+			packet.succeeded(res_length > 0);
+
+			job.owner->completed(job);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc        allocator used for the worker threads
+		 * \param num_threads  number of concurrently executed jobs
+		 */
+		Io_pool(Allocator &alloc, unsigned num_threads)
+		{
+			for (unsigned i = 0; i < num_threads; i++)
+				new (&alloc) Worker(*this);
+		}
+
+		/**
+		 * Schedule job for execution
+		 */
+		void submit(Io_job &job)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_pending.enqueue(&job);
+			_wake(1);
+		}
+};
+
+#endif /* _IO_POOL_H_ */
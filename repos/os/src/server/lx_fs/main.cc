@@ -23,6 +23,7 @@
 
 /* local includes */
 #include <directory.h>
+#include <io_pool.h>
 
 
 namespace File_system {
@@ -32,7 +33,8 @@ namespace File_system {
 }
 
 
-class File_system::Session_component : public Session_rpc_object
+class File_system::Session_component : public Session_rpc_object,
+                                       private Io_job::Owner
 {
 	private:
 
@@ -41,9 +43,100 @@ class File_system::Session_component : public Session_rpc_object
 		Directory            &_root;
 		Node_handle_registry  _handle_registry;
 		bool                  _writable;
+		Io_pool              &_io_pool;
 
 		Signal_rpc_member<Session_component> _process_packet_dispatcher;
 
+		/*
+		 * Jobs for file operations executed by the I/O pool, at most one
+		 * job per packet that fits into the submit queue
+		 */
+		enum { MAX_JOBS = TX_QUEUE_SIZE };
+
+		Io_job       _jobs[MAX_JOBS];
+		Fifo<Io_job> _free_jobs;      /* accessed by the entrypoint only */
+
+		Lock         _completed_lock;
+		Fifo<Io_job> _completed_jobs;
+		unsigned     _jobs_in_flight = 0;
+		bool         _closing        = false;
+		Semaphore    _closed_sem;
+
+		/**
+		 * Io_job::Owner interface, called by an I/O thread
+		 */
+		void completed(Io_job &job) override
+		{
+			Lock::Guard guard(_completed_lock);
+
+			_completed_jobs.enqueue(&job);
+			_jobs_in_flight--;
+
+			if (_closing) {
+				_closed_sem.up();
+				return;
+			}
+
+			/*
+			 * Submit the signal while holding the lock to prevent the
+			 * destruction of the session in the meanwhile.
+			 */
+			Signal_transmitter(_process_packet_dispatcher).submit();
+		}
+
+		/**
+		 * Acknowledge packets of completed jobs
+		 */
+		void _ack_completed_jobs()
+		{
+			while (tx_sink()->ready_to_ack()) {
+
+				Io_job *job = 0;
+				{
+					Lock::Guard guard(_completed_lock);
+					job = _completed_jobs.dequeue();
+				}
+				if (!job)
+					return;
+
+				tx_sink()->acknowledge_packet(job->packet);
+				_free_jobs.enqueue(job);
+			}
+		}
+
+		/**
+		 * Hand out file read or write operation to the I/O pool
+		 *
+		 * \return false if the packet must be processed synchronously
+		 */
+		bool _submit_job(Packet_descriptor const &packet, Node &node)
+		{
+			bool const io = packet.operation() == Packet_descriptor::READ
+			             || packet.operation() == Packet_descriptor::WRITE;
+
+			File *file = dynamic_cast<File *>(&node);
+			if (!io || !file)
+				return false;
+
+			void * const content = tx_sink()->packet_content(packet);
+			if (!content || (packet.length() > packet.size()))
+				return false;
+
+			Io_job &job = *_free_jobs.dequeue();
+			job.owner   = this;
+			job.file    = file;
+			job.content = (char *)content;
+			job.packet  = packet;
+
+			{
+				Lock::Guard guard(_completed_lock);
+				_jobs_in_flight++;
+			}
+
+			_io_pool.submit(job);
+			return true;
+		}
+
 
 		/******************************
 		 ** Packet-stream processing **
@@ -77,6 +170,27 @@ class File_system::Session_component : public Session_rpc_object
 			case Packet_descriptor::WRITE:
 				res_length = node.write((char const *)content, length, offset);
 				break;
+
+			case Packet_descriptor::STATUS:
+				if (length >= sizeof(Status)) {
+					Status const status = _node_status(node);
+					Genode::memcpy(content, &status, sizeof(status));
+					res_length = sizeof(status);
+				}
+				break;
+
+			case Packet_descriptor::READ_DIR_STATUS:
+				if (Directory *dir = dynamic_cast<Directory *>(&node)) {
+
+					/* reaching the end of the directory is no error */
+					packet.length(dir->read_status((char *)content, length, offset));
+					packet.succeeded(true);
+					return;
+				}
+				break;
+
+			case Packet_descriptor::CLOSE:
+				break;
 			}
 
 			packet.length(res_length);
@@ -90,10 +204,26 @@ class File_system::Session_component : public Session_rpc_object
 			/* assume failure by default */
 			packet.succeeded(false);
 
+			/* the handle must not be locked while being released */
+			if (packet.operation() == Packet_descriptor::CLOSE) {
+				close(packet.handle());
+				packet.succeeded(true);
+				tx_sink()->acknowledge_packet(packet);
+				return;
+			}
+
 			try {
 				Node *node = _handle_registry.lookup_and_lock(packet.handle());
 				Node_lock_guard guard(node);
 
+				/*
+				 * File operations are executed asynchronously. Nodes are
+				 * never destructed by lx_fs, so the job may outlive the
+				 * handle.
+				 */
+				if (_submit_job(packet, *node))
+					return;
+
 				_process_packet_op(packet, *node);
 			}
 			catch (Invalid_handle)     { PERR("Invalid_handle");     }
@@ -112,6 +242,8 @@ class File_system::Session_component : public Session_rpc_object
 		 */
 		void _process_packets(unsigned)
 		{
+			_ack_completed_jobs();
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -129,10 +261,44 @@ class File_system::Session_component : public Session_rpc_object
 				if (!tx_sink()->ready_to_ack())
 					return;
 
+				/*
+				 * Defer packet processing until a job completed if all
+				 * jobs are in use. A file operation executed synchronously
+				 * could overtake older jobs of the I/O pool.
+				 */
+				if (_free_jobs.empty())
+					return;
+
 				_process_packet();
 			}
 		}
 
+		static Status _node_status(Node &node)
+		{
+			Status s;
+			s.inode = node.inode();
+			s.size  = 0;
+			s.mode  = 0;
+
+			File *file = dynamic_cast<File *>(&node);
+			if (file) {
+				s.size = file->length();
+				s.mode = File_system::Status::MODE_FILE;
+				return s;
+			}
+
+			Directory *dir = dynamic_cast<Directory *>(&node);
+			if (dir) {
+				s.size = dir->num_entries()*sizeof(Directory_entry);
+				s.mode = File_system::Status::MODE_DIRECTORY;
+				return s;
+			}
+
+			PERR("%s for symlinks not implemented", __func__);
+
+			return Status();
+		}
+
 		/**
 		 * Check if string represents a valid path (must start with '/')
 		 */
@@ -153,15 +319,20 @@ class File_system::Session_component : public Session_rpc_object
 		                  Server::Entrypoint &ep,
 		                  char const         *root_dir,
 		                  bool                writable,
-		                  Allocator          &md_alloc)
+		                  Allocator          &md_alloc,
+		                  Io_pool            &io_pool)
 		:
 			Session_rpc_object(env()->ram_session()->alloc(tx_buf_size), ep.rpc_ep()),
 			_ep(ep),
 			_md_alloc(md_alloc),
 			_root(*new (&_md_alloc) Directory(_md_alloc, root_dir, false)),
 			_writable(writable),
+			_io_pool(io_pool),
 			_process_packet_dispatcher(ep, *this, &Session_component::_process_packets)
 		{
+			for (unsigned i = 0; i < MAX_JOBS; i++)
+				_free_jobs.enqueue(&_jobs[i]);
+
 			/*
 			 * Register '_process_packets' dispatch function as signal
 			 * handler for packet-avail and ready-to-ack signals.
@@ -175,6 +346,17 @@ class File_system::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			/* wait for the completion of jobs that refer to the packet buffer */
+			for (;;) {
+				{
+					Lock::Guard guard(_completed_lock);
+					_closing = true;
+					if (!_jobs_in_flight)
+						break;
+				}
+				_closed_sem.down();
+			}
+
 			Dataspace_capability ds = tx_sink()->dataspace();
 			env()->ram_session()->free(static_cap_cast<Ram_dataspace>(ds));
 			destroy(&_md_alloc, &_root);
@@ -252,28 +434,7 @@ class File_system::Session_component : public Session_rpc_object
 			Node *node = _handle_registry.lookup_and_lock(node_handle);
 			Node_lock_guard guard(node);
 
-			Status s;
-			s.inode = node->inode();
-			s.size  = 0;
-			s.mode  = 0;
-
-			File *file = dynamic_cast<File *>(node);
-			if (file) {
-				s.size = file->length();
-				s.mode = File_system::Status::MODE_FILE;
-				return s;
-			}
-
-			Directory *dir = dynamic_cast<Directory *>(node);
-			if (dir) {
-				s.size = dir->num_entries()*sizeof(Directory_entry);
-				s.mode = File_system::Status::MODE_DIRECTORY;
-				return s;
-			}
-
-			PERR("%s for symlinks not implemented", __func__);
-
-			return Status();
+			return _node_status(*node);
 		}
 
 		void control(Node_handle, Control)
@@ -320,6 +481,7 @@ class File_system::Root : public Root_component<Session_component>
 	private:
 
 		Server::Entrypoint &_ep;
+		Io_pool            &_io_pool;
 
 	protected:
 
@@ -403,7 +565,8 @@ class File_system::Root : public Root_component<Session_component>
 
 			try {
 				return new (md_alloc())
-				       Session_component(tx_buf_size, _ep, root_dir, writeable, *md_alloc());
+				       Session_component(tx_buf_size, _ep, root_dir, writeable,
+				                         *md_alloc(), _io_pool);
 			} catch (Lookup_failed) {
 				PERR("Session root directory \"%s\" does not exist", root);
 				throw Root::Unavailable();
@@ -419,11 +582,12 @@ class File_system::Root : public Root_component<Session_component>
 		 * \param sig_rec     signal receiver used for handling the
 		 *                    data-flow signals of packet streams
 		 * \param md_alloc    meta-data allocator
+		 * \param io_pool     threads executing file operations
 		 */
-		Root(Server::Entrypoint &ep, Allocator &md_alloc)
+		Root(Server::Entrypoint &ep, Allocator &md_alloc, Io_pool &io_pool)
 		:
 			Root_component<Session_component>(&ep.rpc_ep(), &md_alloc),
-			_ep(ep)
+			_ep(ep), _io_pool(io_pool)
 		{ }
 };
 
@@ -437,7 +601,23 @@ struct File_system::Main
 	 */
 	Sliced_heap sliced_heap = { env()->ram_session(), env()->rm_session() };
 
-	Root fs_root = { ep, sliced_heap };
+	/*
+	 * Number of threads executing host I/O concurrently
+	 */
+	static unsigned _num_io_threads()
+	{
+		enum { DEFAULT_IO_THREADS = 4 };
+
+		unsigned num = DEFAULT_IO_THREADS;
+		try { config()->xml_node().attribute("io_threads").value(&num); }
+		catch (...) { }
+
+		return max(num, 1U);
+	}
+
+	Io_pool io_pool = { *env()->heap(), _num_io_threads() };
+
+	Root fs_root = { ep, sliced_heap, io_pool };
 
 	Main(Server::Entrypoint &ep) : ep(ep)
 	{
@@ -58,6 +58,10 @@ static Input::Event merge_motion_events(Input::Event const *ev, unsigned n)
 	for (unsigned i = 0; i < n; i++, ev++)
 		res = Input::Event(Input::Event::MOTION, 0, ev->ax(), ev->ay(),
 		                   res.rx() + ev->rx(), res.ry() + ev->ry());
+
+	/* account the latency of the merged event from its oldest motion */
+	if (n)
+		res.timestamp((ev - n)->timestamp());
 	return res;
 }
 
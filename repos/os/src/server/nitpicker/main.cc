@@ -18,6 +18,7 @@
 #include <base/allocator_guard.h>
 #include <os/attached_ram_dataspace.h>
 #include <input/event.h>
+#include <input/event_ring.h>
 #include <input/keycodes.h>
 #include <root/component.h>
 #include <dataspace/client.h>
@@ -728,12 +729,17 @@ class Nitpicker::Session_component : public Genode::Rpc_object<Session>,
 			 * Transpose absolute coordinates by session-specific vertical
 			 * offset.
 			 */
-			if (e.ax() || e.ay())
+			if (e.ax() || e.ay()) {
+				Genode::Trace::Timestamp const timestamp = e.timestamp();
+
 				e = Event(e.type(), e.code(),
 				          Genode::max(0, e.ax() - origin_offset.x()),
 				          Genode::max(0, e.ay() - origin_offset.y()),
 				          e.rx(), e.ry());
 
+				e.timestamp(timestamp);
+			}
+
 			_input_session_component.submit(&e);
 		}
 
@@ -1100,8 +1106,66 @@ struct Nitpicker::Main
 	Framebuffer::Connection framebuffer;
 	Input::Connection       input;
 
-	Input::Event * const ev_buf =
-		env()->rm_session()->attach(input.dataspace());
+	Attached_dataspace ev_ds = { input.dataspace() };
+
+	Input::Event * const ev_buf = ev_ds.local_addr<Input::Event>();
+
+	/*
+	 * Event ring of the input driver, which allows us to obtain the events
+	 * of each period without a 'flush' RPC
+	 */
+	Input::Event_ring * const ev_ring =
+		Input::Event_ring::lookup(ev_ds.local_addr<void>(), ev_ds.size());
+
+	/*
+	 * Events of the current period, taken from the ring or the flush area
+	 */
+	Input::Event imported_events[Input::Event_ring::SIZE];
+
+	/**
+	 * Statistics about the time between the creation of input events by
+	 * the driver and the refresh of the framebuffer that follows their
+	 * processing, measured in timestamp ticks
+	 */
+	struct Input_latency
+	{
+		enum { PERIODS_PER_LOG = 100 };
+
+		bool enabled = false;
+
+		Genode::Trace::Timestamp oldest = 0;  /* of current period */
+		Genode::Trace::Timestamp sum = 0, max = 0;
+		unsigned                 cnt = 0;
+
+		void imported(Input::Event const &ev)
+		{
+			if (ev.timestamp() && (!oldest || ev.timestamp() < oldest))
+				oldest = ev.timestamp();
+		}
+
+		void refreshed()
+		{
+			Genode::Trace::Timestamp const first = oldest;
+			oldest = 0;
+
+			if (!enabled || !first)
+				return;
+
+			Genode::Trace::Timestamp const latency =
+				Genode::Trace::timestamp() - first;
+
+			sum   += latency;
+			max    = Genode::max(max, latency);
+
+			if (++cnt < PERIODS_PER_LOG)
+				return;
+
+			PINF("input-to-refresh latency: avg=%llu max=%llu ticks",
+			     (unsigned long long)(sum/cnt), (unsigned long long)max);
+
+			sum = max = cnt = 0;
+		}
+	} input_latency;
 
 	typedef Pixel_rgb565 PT;  /* physical pixel type */
 
@@ -1253,7 +1317,15 @@ void Nitpicker::Main::handle_input(unsigned)
 	bool        const old_user_active     = user_active;
 
 	/* handle batch of pending events */
-	if (import_input_events(ev_buf, input.flush(), user_state)) {
+	unsigned num_ev = 0;
+	Input::Event_ring::consume(ev_ring, input, ev_buf, [&] (Input::Event const &ev) {
+		if (num_ev < Input::Event_ring::SIZE)
+			imported_events[num_ev++] = ev;
+
+		input_latency.imported(ev);
+	});
+
+	if (import_input_events(imported_events, num_ev, user_state)) {
 		last_active_period = period_cnt;
 		user_active        = true;
 	}
@@ -1301,6 +1373,8 @@ void Nitpicker::Main::handle_input(unsigned)
 		framebuffer.refresh(rect.x1(), rect.y1(),
 		                    rect.w(),  rect.h()); });
 
+	input_latency.refreshed();
+
 	user_state.mark_all_views_as_clean();
 
 	/* deliver framebuffer synchronization events */
@@ -1338,6 +1412,12 @@ void Nitpicker::Main::handle_config(unsigned)
 		.attribute("color").value(&background.color);
 	} catch (...) { }
 
+	/* enable or disable the measurement of the input latency */
+	try {
+		input_latency.enabled =
+			config()->xml_node().attribute("input_latency").has_value("yes");
+	} catch (...) { input_latency.enabled = false; }
+
 	/* enable or disable redraw debug mode */
 	try {
 		tmp_fb = nullptr;
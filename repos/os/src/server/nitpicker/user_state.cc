@@ -45,8 +45,9 @@ void User_state::_update_all()
 
 void User_state::handle_event(Input::Event ev)
 {
-	Input::Keycode     const keycode = ev.keycode();
-	Input::Event::Type const type    = ev.type();
+	Input::Keycode           const keycode   = ev.keycode();
+	Input::Event::Type       const type      = ev.type();
+	Genode::Trace::Timestamp const timestamp = ev.timestamp();
 
 	/*
 	 * Mangle incoming events
@@ -79,6 +80,8 @@ void User_state::handle_event(Input::Event ev)
 	} else
 		ev = Input::Event(type, keycode, ax, ay, rx, ry);
 
+	ev.timestamp(timestamp);
+
 	_pointer_pos = Point(ax, ay);
 
 	/* count keys */
@@ -75,6 +75,27 @@ namespace File_system {
 				case Packet_descriptor::WRITE:
 					res_length = node.write((char const *)content, length, offset);
 					break;
+
+				case Packet_descriptor::STATUS:
+					if (length >= sizeof(Status)) {
+						Status const status = node_status(node);
+						memcpy(content, &status, sizeof(status));
+						res_length = sizeof(status);
+					}
+					break;
+
+				case Packet_descriptor::READ_DIR_STATUS:
+					if (Directory *dir = dynamic_cast<Directory *>(&node)) {
+
+						/* reaching the end of the directory is no error */
+						packet.length(dir->read_status((char *)content, length, offset));
+						packet.succeeded(true);
+						return;
+					}
+					break;
+
+				case Packet_descriptor::CLOSE:
+					break;
 				}
 
 				packet.length(res_length);
@@ -88,6 +109,14 @@ namespace File_system {
 				/* assume failure by default */
 				packet.succeeded(false);
 
+				/* the handle must not be locked while being released */
+				if (packet.operation() == Packet_descriptor::CLOSE) {
+					close(packet.handle());
+					packet.succeeded(true);
+					tx_sink()->acknowledge_packet(packet);
+					return;
+				}
+
 				try {
 					Node *node = _handle_registry.lookup_and_lock(packet.handle());
 					Node_lock_guard guard(node);
@@ -301,30 +330,7 @@ namespace File_system {
 				Node *node = _handle_registry.lookup_and_lock(node_handle);
 				Node_lock_guard guard(node);
 
-				Status s;
-				s.inode = node->inode();
-				s.size  = 0;
-				s.mode  = 0;
-
-				File *file = dynamic_cast<File *>(node);
-				if (file) {
-					s.size = file->length();
-					s.mode = File_system::Status::MODE_FILE;
-					return s;
-				}
-				Directory *dir = dynamic_cast<Directory *>(node);
-				if (dir) {
-					s.size = dir->num_entries()*sizeof(Directory_entry);
-					s.mode = File_system::Status::MODE_DIRECTORY;
-					return s;
-				}
-				Symlink *symlink = dynamic_cast<Symlink *>(node);
-				if (symlink) {
-					s.size = symlink->length();
-					s.mode = File_system::Status::MODE_SYMLINK;
-					return s;
-				}
-				return Status();
+				return node_status(*node);
 			}
 
 			void control(Node_handle, Control) { }
@@ -22,149 +22,228 @@
 #include <base/env.h>
 #include <base/printf.h>
 #include <os/config.h>
+#include <os/attached_ram_dataspace.h>
+#include <os/dataspace_slice.h>
+#include <util/volatile_object.h>
+#include <util/list.h>
 
 
 /**
- * A 'Rom_session_component' exports a single file of the tar archive
+ * Index of the files contained in the tar archive
+ *
+ * The index is built once at startup so that session requests do not need
+ * to scan the archive. Records are looked up via a hash table keyed by the
+ * file name.
  */
-class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
+class Tar_index
 {
-	private:
-
-		const char *_tar_addr, *_filename, *_file_addr;
-		Genode::size_t _file_size, _tar_size;
-		Genode::Ram_dataspace_capability _file_ds;
+	public:
 
 		enum {
 			/* length of on data block in tar */
-			_BLOCK_LEN = 512,
+			BLOCK_LEN = 512,
 
 			/* length of the header field "file-size" in tar */
-			_FIELD_SIZE_LEN = 124
+			FIELD_SIZE_LEN = 124
 		};
 
-		/**
-		 * Copy file content into dataspace
-		 *
-		 * \param dst  destination dataspace
-		 */
-		void _copy_content_to_dataspace(Genode::Dataspace_capability dst)
+		struct Entry : Genode::List<Entry>::Element
 		{
-			using namespace Genode;
+			char const     *name;
+			Genode::off_t   offset;  /* offset of content within archive */
+			Genode::size_t  size;
+
+			Entry(char const *name, Genode::off_t offset, Genode::size_t size)
+			: name(name), offset(offset), size(size) { }
+		};
+
+	private:
 
-			/* map dataspace locally */
-			char *dst_addr = env()->rm_session()->attach(dst);
-			Dataspace_client dst_client(dst);
+		char const    *_tar_addr;
+		Genode::size_t _tar_size;
 
-			/* copy content */
-			size_t dst_ds_size   = Dataspace_client(dst).size();
-			size_t bytes_to_copy = min(_file_size, dst_ds_size);
-			memcpy(dst_addr, _file_addr, bytes_to_copy);
+		Genode::List<Entry> *_buckets;
+		unsigned             _num_buckets;
 
-			/* unmap dataspace */
-			env()->rm_session()->detach(dst_addr);
+		static unsigned _hash(char const *name)
+		{
+			unsigned h = 5381;
+			for (; *name; name++)
+				h = ((h << 5) + h) ^ (unsigned char)*name;
+			return h;
 		}
 
+		Genode::List<Entry> &_bucket(char const *name) {
+			return _buckets[_hash(name) & (_num_buckets - 1)]; }
+
 		/**
-		 * Initialize dataspace containing the content of the archived file
+		 * Call 'fn' for each record with its name, content offset, and size
 		 */
-		Genode::Ram_dataspace_capability _init_file_ds()
+		template <typename FN>
+		void _for_each_record(FN const &fn)
 		{
-			bool file_found = false;
-
 			/* measure size of archive in blocks */
-			unsigned block_id = 0, block_cnt = _tar_size/_BLOCK_LEN;
+			Genode::size_t block_id = 0, block_cnt = _tar_size/BLOCK_LEN;
 
 			/* scan metablocks of archive */
 			while (block_id < block_cnt) {
 
 				unsigned long file_size = 0;
-				Genode::ascii_to_unsigned(_tar_addr + block_id*_BLOCK_LEN +
-				                          _FIELD_SIZE_LEN, file_size, 8);
+				Genode::ascii_to_unsigned(_tar_addr + block_id*BLOCK_LEN +
+				                          FIELD_SIZE_LEN, file_size, 8);
 
 				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
+				char const *record_filename = _tar_addr + block_id*BLOCK_LEN;
 
 				/* skip leading dot of path if present */
 				if (record_filename[0] == '.' && record_filename[1] == '/')
 					record_filename++;
 
-				/* get infos about current file */
-				if (Genode::strcmp(_filename, record_filename) == 0) {
-					_file_size = file_size;
-					_file_addr = _tar_addr + (block_id+1) * _BLOCK_LEN;
-					file_found = true;
-					break;
-				}
+				fn(record_filename, (Genode::off_t)(block_id + 1)*BLOCK_LEN,
+				   (Genode::size_t)file_size);
 
 				/* some datablocks */       /* one metablock */
-				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
+				block_id = block_id + (file_size / BLOCK_LEN) + 1;
 
 				/* round up */
-				if (file_size % _BLOCK_LEN != 0) block_id++;
+				if (file_size % BLOCK_LEN != 0) block_id++;
 
 				/* check for end of tar archive */
-				if (block_id*_BLOCK_LEN >= _tar_size)
+				if (block_id*BLOCK_LEN >= _tar_size)
 					break;
 
 				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
+				if (*(_tar_addr + (block_id*BLOCK_LEN)) == 0x00)
+					if (*(_tar_addr + (block_id*BLOCK_LEN + 1)) == 0x00)
 						break;
 			}
+		}
+
+	public:
+
+		Tar_index(char const *tar_addr, Genode::size_t tar_size,
+		          Genode::Allocator &alloc)
+		:
+			_tar_addr(tar_addr), _tar_size(tar_size), _buckets(0), _num_buckets(1)
+		{
+			using namespace Genode;
+
+			unsigned num_records = 0;
+			_for_each_record([&] (char const *, off_t, size_t) { num_records++; });
+
+			/* use a power of two for the number of buckets */
+			while (_num_buckets < num_records)
+				_num_buckets <<= 1;
+
+			_buckets = new (&alloc) List<Entry>[_num_buckets];
+
+			unsigned num_aligned = 0;
+			_for_each_record([&] (char const *name, off_t offset, size_t size) {
+				_bucket(name).insert(new (&alloc) Entry(name, offset, size));
+				if (Dataspace_slice::aligned(offset))
+					num_aligned++;
+			});
+
+			PINF("indexed %u files, %u with page-aligned content",
+			     num_records, num_aligned);
+		}
+
+		/**
+		 * Return entry for the file 'name', or 0 if it does not exist
+		 *
+		 * If the archive contains multiple records with the same name, the
+		 * first one in archive order is returned.
+		 */
+		Entry const *lookup(char const *name)
+		{
+			Entry const *match = 0;
+			for (Entry const *e = _bucket(name).first(); e; e = e->next())
+				if (Genode::strcmp(e->name, name) == 0 && (!match || e->offset < match->offset))
+					match = e;
+			return match;
+		}
+};
+
+
+/**
+ * A 'Rom_session_component' exports a single file of the tar archive
+ *
+ * If the file content is located at a page-aligned position within the
+ * archive, the exported dataspace aliases the archive content. Otherwise,
+ * the content is copied into a freshly allocated RAM dataspace.
+ */
+class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
+{
+	private:
 
-			if (!file_found) {
-				PERR("couldn't find file '%s', empty result", _filename);
-				return Genode::Ram_dataspace_capability();
+		Tar_index::Entry const &_entry;
+
+		Genode::Lazy_volatile_object<Genode::Dataspace_slice>        _slice;
+		Genode::Lazy_volatile_object<Genode::Attached_ram_dataspace> _copy;
+
+		Genode::Dataspace_capability _file_ds;
+
+		/**
+		 * Initialize dataspace containing the content of the archived file
+		 */
+		Genode::Dataspace_capability _init_file_ds(Genode::Dataspace_capability tar_ds,
+		                                           char const *tar_addr)
+		{
+			using namespace Genode;
+
+			if (Dataspace_slice::worthwhile(_entry.offset, _entry.size)) {
+				try {
+					_slice.construct(tar_ds, tar_addr, _entry.offset, _entry.size);
+					return _slice->cap();
+				}
+				catch (Dataspace_slice::Unsupported) { }
+				catch (...) {
+					PWRN("could not alias content of '%s', fall back to copy",
+					     _entry.name);
+				}
+
+				/* release partially constructed slice */
+				_slice.destruct();
 			}
 
 			/* try to allocate memory for file */
-			Genode::Ram_dataspace_capability file_ds;
 			try {
-				file_ds = Genode::env()->ram_session()->alloc(_file_size);
-
-				/* get content of file copied into dataspace and return */
-				_copy_content_to_dataspace(file_ds);
+				_copy.construct(env()->ram_session(), _entry.size);
 			} catch (...) {
 				PERR("couldn't allocate memory for file, empty result\n");
-				return file_ds;
+				return Dataspace_capability();
 			}
 
-			return file_ds;
+			/* get content of file copied into dataspace */
+			memcpy(_copy->local_addr<char>(), tar_addr + _entry.offset, _entry.size);
+			return _copy->cap();
 		}
 
 	public:
 
 		/**
-		 * Constructor scans and seeks to file
+		 * Constructor
 		 *
+		 * \param  tar_ds    dataspace of the tar archive
 		 * \param  tar_addr  local address to tar archive
-		 * \param  tar_size  size of tar archive in bytes
-		 * \param  filename  name of the requested file
+		 * \param  entry     index entry of the requested file
 		 */
-		Rom_session_component(const char *tar_addr, unsigned tar_size,
-		                      const char *filename)
+		Rom_session_component(Genode::Dataspace_capability tar_ds,
+		                      char const *tar_addr,
+		                      Tar_index::Entry const &entry)
 		:
-			_tar_addr(tar_addr), _filename(filename), _file_addr(0), _file_size(0),
-			_tar_size(tar_size),
-			_file_ds(_init_file_ds())
+			_entry(entry), _file_ds(_init_file_ds(tar_ds, tar_addr))
 		{
 			if (!_file_ds.valid())
 				throw Genode::Root::Invalid_args();
 		}
 
-		/**
-		 * Destructor
-		 */
-		~Rom_session_component() { Genode::env()->ram_session()->free(_file_ds); }
-
 		/**
 		 * Return dataspace with content of file
 		 */
 		Genode::Rom_dataspace_capability dataspace()
 		{
-			Genode::Dataspace_capability ds = _file_ds;
-			return Genode::static_cap_cast<Genode::Rom_dataspace>(ds);
+			return Genode::static_cap_cast<Genode::Rom_dataspace>(_file_ds);
 		}
 
 		void sigh(Genode::Signal_context_capability) { }
@@ -175,8 +254,9 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 {
 	private:
 
-		char    *_tar_addr;
-		unsigned _tar_size;
+		Genode::Dataspace_capability _tar_ds;
+		char                        *_tar_addr;
+		Tar_index                   &_index;
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -186,8 +266,14 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 
 			PINF("connection for file '%s' requested\n", filename);
 
+			Tar_index::Entry const *entry = _index.lookup(filename);
+			if (!entry) {
+				PERR("couldn't find file '%s', empty result", filename);
+				throw Genode::Root::Invalid_args();
+			}
+
 			/* create new session for the requested file */
-			return new (md_alloc()) Rom_session_component(_tar_addr, _tar_size, filename);
+			return new (md_alloc()) Rom_session_component(_tar_ds, _tar_addr, *entry);
 		}
 
 	public:
@@ -197,15 +283,17 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 		 *
 		 * \param  entrypoint  entrypoint to be used for ROM sessions
 		 * \param  md_alloc    meta-data allocator used for ROM sessions
+		 * \param  tar_ds      dataspace of tar archive
 		 * \param  tar_base    local address of tar archive
-		 * \param  tar_size    size of tar archive in bytes
+		 * \param  index       index of the archived files
 		 */
 		Rom_root(Genode::Rpc_entrypoint *entrypoint,
 		         Genode::Allocator      *md_alloc,
-		         char *tar_addr, Genode::size_t tar_size)
+		         Genode::Dataspace_capability tar_ds,
+		         char *tar_addr, Tar_index &index)
 		:
 			Genode::Root_component<Rom_session_component>(entrypoint, md_alloc),
-			_tar_addr(tar_addr), _tar_size(tar_size)
+			_tar_ds(tar_ds), _tar_addr(tar_addr), _index(index)
 		{ }
 };
 
@@ -229,10 +317,12 @@ int main(void)
 	/* obtain dataspace of tar archive from ROM service */
 	static char  *tar_base = 0;
 	static size_t tar_size = 0;
+	static Dataspace_capability tar_ds;
 	try {
 		static Rom_connection tar_rom(tar_filename);
-		tar_base = env()->rm_session()->attach(tar_rom.dataspace());
-		tar_size = Dataspace_client(tar_rom.dataspace()).size();
+		tar_ds   = tar_rom.dataspace();
+		tar_base = env()->rm_session()->attach(tar_ds);
+		tar_size = Dataspace_client(tar_ds).size();
 	} catch (...) {
 		PERR("Could not obtain tar archive from ROM service");
 		return -2;
@@ -240,6 +330,8 @@ int main(void)
 
 	PINF("using tar archive '%s' with size %zd", tar_filename, tar_size);
 
+	static Tar_index index(tar_base, tar_size, *env()->heap());
+
 	/* connection to capability service needed to create capabilities */
 	static Cap_connection cap;
 
@@ -249,7 +341,7 @@ int main(void)
 
 	enum { STACK_SIZE = 8*1024 };
 	static Rpc_entrypoint ep(&cap, STACK_SIZE, "tar_rom_ep");
-	static Rom_root rom_root(&ep, &sliced_heap, tar_base, tar_size);
+	static Rom_root rom_root(&ep, &sliced_heap, tar_ds, tar_base, index);
 
 	/* announce server*/
 	env()->parent()->announce(ep.manage(&rom_root));
@@ -13,13 +13,16 @@
 
 #include <base/env.h>
 #include <base/rpc_server.h>
-#include <base/sleep.h>
 #include <root/component.h>
 #include <util/string.h>
+#include <util/construct_at.h>
+#include <os/attached_ram_dataspace.h>
+#include <os/config.h>
+#include <os/server.h>
 
 #include <terminal_session/connection.h>
-#include <cap_session/connection.h>
 #include <log_session/log_session.h>
+#include <log_session/log_ring.h>
 
 
 namespace Genode {
@@ -33,36 +36,54 @@ namespace Genode {
 		private:
 
 			char                  _label[LABEL_LEN];
+			size_t                _label_len;
 			Terminal::Connection *_terminal;
 
-		public:
+			/*
+			 * Output is collected in the batch buffer and passed to the
+			 * terminal with a single write per batch.
+			 */
+			enum { BATCH_SIZE = 4096 };
 
-			/**
-			 * Constructor
+			char   _batch[BATCH_SIZE];
+			size_t _batch_len = 0;
+
+			/*
+			 * Ring of messages shared with the client, if enabled
 			 */
-			Termlog_component(const char *label, Terminal::Connection *terminal)
-			: _terminal(terminal) { snprintf(_label, LABEL_LEN, "[%s] ", label); }
+			Attached_ram_dataspace *_ring_ds = nullptr;
+			Log_ring               *_ring    = nullptr;
 
+			Signal_rpc_member<Termlog_component> _ring_dispatcher;
 
-			/*****************
-			 ** Log session **
-			 *****************/
+			void _flush_batch()
+			{
+				if (_batch_len)
+					_terminal->write(_batch, _batch_len);
+
+				_batch_len = 0;
+			}
+
+			void _append(char const *s, size_t len)
+			{
+				if (_batch_len + len > BATCH_SIZE)
+					_flush_batch();
+
+				memcpy(_batch + _batch_len, s, len);
+				_batch_len += len;
+			}
 
 			/**
-			 * Write a log-message to the terminal.
+			 * Format log message
 			 *
 			 * The following function's code is a modified variant of the one in:
 			 * 'base/src/core/include/log_session_component.h'
 			 */
-			size_t write(String const &string_buf)
+			void _append_message(char const *string, size_t len)
 			{
-				if (!(string_buf.is_valid_string())) {
-					PERR("corrupted string");
-					return 0;
-				}
-
-				char const *string = string_buf.string();
-				int len = strlen(string);
+				/* ensure that the whole message ends up in one batch */
+				if (_batch_len + _label_len + len + 1 > BATCH_SIZE)
+					_flush_batch();
 
 				/*
 				 * Heuristic: The Log console implementation flushes
@@ -73,20 +94,113 @@ namespace Genode {
 				 *            character).
 				 */
 				enum { ESC = 27 };
-				if ((string[0] == ESC) && (len == 5) && (string[4] == '\n')) {
-					_terminal->write(string, len - 1);
-					return len;
+				if ((len == 5) && (string[0] == ESC) && (string[4] == '\n')) {
+					_append(string, len - 1);
+					return;
 				}
 
-				_terminal->write(_label, strlen(_label));
-				_terminal->write(string, len);
+				_append(_label, _label_len);
+				_append(string, len);
 
 				/* if last character of string was not a line break, add one */
 				if ((len > 0) && (string[len - 1] != '\n'))
-					_terminal->write("\n", 1);
+					_append("\n", 1);
+			}
+
+			void _consume_ring()
+			{
+				if (_ring)
+					_ring->for_each([&] (Log_ring::Message const &m) {
+						_append_message(m.text, m.len); });
+			}
+
+			void _handle_ring(unsigned)
+			{
+				do { drain(); } while (!_ring->wait_for_producer());
+			}
+
+		public:
+
+			/**
+			 * Constructor
+			 *
+			 * \param ring  provide a ring for passing messages without RPC
+			 */
+			Termlog_component(const char *label, Terminal::Connection *terminal,
+			                  Server::Entrypoint &ep, bool ring)
+			:
+				_terminal(terminal),
+				_ring_dispatcher(ep, *this, &Termlog_component::_handle_ring)
+			{
+				snprintf(_label, LABEL_LEN, "[%s] ", label);
+				_label_len = strlen(_label);
+
+				if (!ring)
+					return;
+
+				_ring_ds = new (env()->heap())
+					Attached_ram_dataspace(env()->ram_session(), sizeof(Log_ring));
+				_ring = construct_at<Log_ring>(_ring_ds->local_addr<void>());
+				_ring->wait_for_producer();
+			}
+
+			~Termlog_component()
+			{
+				if (!_ring)
+					return;
+
+				drain();
+				destroy(env()->heap(), _ring_ds);
+			}
+
+
+			/*****************
+			 ** Log session **
+			 *****************/
+
+			/**
+			 * Write a log-message to the terminal.
+			 */
+			size_t write(String const &string_buf)
+			{
+				if (!(string_buf.is_valid_string())) {
+					PERR("corrupted string");
+					return 0;
+				}
+
+				/* preserve the order of messages already added to the ring */
+				_consume_ring();
+
+				char const *string = string_buf.string();
+				int len = strlen(string);
+
+				_append_message(string, len);
+				_flush_batch();
 
 				return len;
 			}
+
+			Dataspace_capability ring() override
+			{
+				if (!_ring_ds)
+					return Dataspace_capability();
+
+				return _ring_ds->cap();
+			}
+
+			Signal_context_capability ring_sigh() override
+			{
+				if (!_ring)
+					return Signal_context_capability();
+
+				return _ring_dispatcher;
+			}
+
+			void drain() override
+			{
+				_consume_ring();
+				_flush_batch();
+			}
 	};
 
 
@@ -95,6 +209,15 @@ namespace Genode {
 		private:
 
 			Terminal::Connection *_terminal;
+			Server::Entrypoint   &_ep;
+
+			static bool _ring_enabled()
+			{
+				try { return config()->xml_node().attribute_value("ring", false); }
+				catch (...) { return false; }
+			}
+
+			bool const _ring = _ring_enabled();
 
 		protected:
 
@@ -111,12 +234,17 @@ namespace Genode {
 				if (ram_quota < session_size)
 					throw Root::Quota_exceeded();
 
+				/* the ring is accounted to the remaining quota of the client */
+				bool const ring = _ring
+				               && ram_quota >= session_size + sizeof(Log_ring);
+
 				char label_buf[Termlog_component::LABEL_LEN];
 
 				Arg label_arg = Arg_string::find_arg(args, "label");
 				label_arg.string(label_buf, sizeof(label_buf), "");
 
-				return new (md_alloc()) Termlog_component(label_buf, _terminal);
+				return new (md_alloc())
+					Termlog_component(label_buf, _terminal, _ep, ring);
 			}
 
 		public:
@@ -124,42 +252,44 @@ namespace Genode {
 			/**
 			 * Constructor
 			 *
-			 * \param session_ep  entry point for managing cpu session objects
-			 * \param md_alloc    meta-data allocator to be used by root component
+			 * \param ep        entry point for managing the session objects
+			 * \param md_alloc  meta-data allocator to be used by root component
 			 */
-			Termlog_root(Rpc_entrypoint *session_ep, Allocator *md_alloc,
-			         Terminal::Connection *terminal)
-			: Root_component<Termlog_component>(session_ep, md_alloc),
-			  _terminal(terminal) { }
+			Termlog_root(Server::Entrypoint &ep, Allocator *md_alloc,
+			             Terminal::Connection *terminal)
+			: Root_component<Termlog_component>(&ep.rpc_ep(), md_alloc),
+			  _terminal(terminal), _ep(ep) { }
 	};
 }
 
 
-int main(int argc, char **argv)
+namespace Server { struct Main; }
+
+
+struct Server::Main
 {
-	using namespace Genode;
-
-	/*
-	 * Open Terminal session
-	 */
-	static Terminal::Connection terminal;
-
-	/*
-	 * Initialize server entry point
-	 */
-	enum { STACK_SIZE = 4096 };
-	static Cap_connection cap;
-	static Rpc_entrypoint ep(&cap, STACK_SIZE, "termlog_ep");
-	static Termlog_root termlog_root(&ep, env()->heap(), &terminal);
-
-	/*
-	 * Announce services
-	 */
-	env()->parent()->announce(ep.manage(&termlog_root));
-
-	/**
-	 * Got to sleep forever
-	 */
-	sleep_forever();
-	return 0;
+	Entrypoint &ep;
+
+	Terminal::Connection terminal;
+
+	Genode::Termlog_root termlog_root { ep, Genode::env()->heap(), &terminal };
+
+	Main(Entrypoint &ep) : ep(ep)
+	{
+		Genode::env()->parent()->announce(ep.manage(termlog_root));
+	}
+};
+
+
+/************
+ ** Server **
+ ************/
+
+namespace Server {
+
+	char const *name() { return "termlog_ep"; }
+
+	size_t stack_size() { return 4*1024*sizeof(long); }
+
+	void construct(Entrypoint &ep) { static Main main(ep); }
 }
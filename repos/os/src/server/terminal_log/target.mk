@@ -1,3 +1,3 @@
 TARGET = terminal_log
 SRC_CC = main.cc
-LIBS   = base
+LIBS   = base server config
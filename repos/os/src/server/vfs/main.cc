@@ -47,6 +47,44 @@ namespace File_system {
 };
 
 
+/**
+ * Obtain status of the node at 'path'
+ *
+ * \return  false if the node does not exist
+ */
+bool File_system::vfs_status(char const *path, Status &fs_stat)
+{
+	Directory_service::Stat vfs_stat;
+
+	if (root()->stat(path, vfs_stat) != Directory_service::STAT_OK)
+		return false;
+
+	fs_stat.inode = vfs_stat.inode;
+
+	switch (vfs_stat.mode & (
+		Directory_service::STAT_MODE_DIRECTORY |
+		Directory_service::STAT_MODE_SYMLINK |
+		File_system::Status::MODE_FILE)) {
+
+	case Directory_service::STAT_MODE_DIRECTORY:
+		fs_stat.mode = File_system::Status::MODE_DIRECTORY;
+		fs_stat.size = root()->num_dirent(path) * sizeof(Directory_entry);
+		return true;
+
+	case Directory_service::STAT_MODE_SYMLINK:
+		fs_stat.mode = File_system::Status::MODE_SYMLINK;
+		break;
+
+	default: /* Directory_service::STAT_MODE_FILE */
+		fs_stat.mode = File_system::Status::MODE_FILE;
+		break;
+	}
+
+	fs_stat.size = vfs_stat.size;
+	return true;
+}
+
+
 class File_system::Session_component : public Session_rpc_object
 {
 	private:
@@ -70,6 +108,13 @@ class File_system::Session_component : public Session_rpc_object
 			size_t     const length  = packet.length();
 			seek_off_t const offset  = packet.position();
 
+			/* the handle must not be locked while being released */
+			if (packet.operation() == Packet_descriptor::CLOSE) {
+				close(packet.handle());
+				packet.succeeded(true);
+				return;
+			}
+
 			if ((!(content && length)) || (packet.length() > packet.size())) {
 				packet.succeeded(false);
 				return;
@@ -95,6 +140,35 @@ class File_system::Session_component : public Session_rpc_object
 				res_length = node->write((char const *)content, length, offset);
 				break;
 			}
+
+			case Packet_descriptor::STATUS: {
+				if (length < sizeof(Status)) return;
+				Node *node;
+				try { node = _handle_registry.lookup_and_lock(packet.handle()); }
+				catch (Invalid_handle) { return; }
+				Node_lock_guard guard(node);
+				Status node_status;
+				if (!vfs_status(node->path(), node_status)) return;
+				memcpy(content, &node_status, sizeof(node_status));
+				res_length = sizeof(node_status);
+				break;
+			}
+
+			case Packet_descriptor::READ_DIR_STATUS: {
+				Node *node = _handle_registry.lookup_read(packet.handle());
+				if (!node) return;
+				Node_lock_guard guard(node);
+				if (Directory *dir = dynamic_cast<Directory *>(node)) {
+
+					/* reaching the end of the directory is no error */
+					packet.length(dir->read_status((char *)content, length, offset));
+					packet.succeeded(true);
+				}
+				return;
+			}
+
+			case Packet_descriptor::CLOSE:
+				break;
 			}
 
 			if (res_length) {
@@ -278,40 +352,13 @@ class File_system::Session_component : public Session_rpc_object
 
 		Status status(Node_handle node_handle)
 		{
-			Directory_service::Stat vfs_stat;
-			File_system::Status      fs_stat;
+			File_system::Status fs_stat;
 			Node *node;
 			try { node = _handle_registry.lookup_and_lock(node_handle); }
 			catch (Invalid_handle) { return fs_stat; }
 			Node_lock_guard guard(node);
 
-			char const *path_str = node->path();
-
-			if (root()->stat(path_str, vfs_stat) != Directory_service::STAT_OK)
-				return fs_stat;
-
-			fs_stat.inode = vfs_stat.inode;
-
-			switch (vfs_stat.mode & (
-				Directory_service::STAT_MODE_DIRECTORY |
-				Directory_service::STAT_MODE_SYMLINK |
-				File_system::Status::MODE_FILE)) {
-
-			case Directory_service::STAT_MODE_DIRECTORY:
-				fs_stat.mode = File_system::Status::MODE_DIRECTORY;
-				fs_stat.size = root()->num_dirent(path_str) * sizeof(Directory_entry);
-				return fs_stat;
-
-			case Directory_service::STAT_MODE_SYMLINK:
-				fs_stat.mode = File_system::Status::MODE_SYMLINK;
-				break;
-
-			default: /* Directory_service::STAT_MODE_FILE */
-				fs_stat.mode = File_system::Status::MODE_FILE;
-				break;
-			}
-
-			fs_stat.size = vfs_stat.size;
+			vfs_status(node->path(), fs_stat);
 			return fs_stat;
 		}
 
@@ -31,6 +31,8 @@ namespace File_system {
 	typedef Avl_string<MAX_PATH_LEN> Avl_path_string;
 
 	Vfs::File_system *root();
+
+	bool vfs_status(char const *path, Status &);
 }
 
 
@@ -136,6 +138,53 @@ struct File_system::Directory : Node
 		}
 		return len - remains;
 	}
+
+	/**
+	 * Read directory entries along with the status of each entry
+	 */
+	size_t read_status(char *dst, size_t len, seek_off_t seek_offset)
+	{
+		if (seek_offset % sizeof(Directory_entry_status))
+			return 0;
+
+		Directory_service::Dirent vfs_dirent;
+		int index = seek_offset / sizeof(Directory_entry_status);
+
+		size_t res_length = 0;
+		for (; len - res_length >= sizeof(Directory_entry_status); index++) {
+
+			memset(&vfs_dirent, 0x00, sizeof(vfs_dirent));
+			if (root()->dirent(path(), index, vfs_dirent)
+				!= Vfs::Directory_service::DIRENT_OK
+			 || vfs_dirent.type == Vfs::Directory_service::DIRENT_TYPE_END)
+				break;
+
+			Directory_entry_status e;
+			memset(&e, 0, sizeof(e));
+
+			switch (vfs_dirent.type) {
+			case Vfs::Directory_service::DIRENT_TYPE_DIRECTORY:
+				e.entry.type = File_system::Directory_entry::TYPE_DIRECTORY;
+				break;
+			case Vfs::Directory_service::DIRENT_TYPE_SYMLINK:
+				e.entry.type = File_system::Directory_entry::TYPE_SYMLINK;
+				break;
+			case Vfs::Directory_service::DIRENT_TYPE_FILE:
+			default:
+				e.entry.type = File_system::Directory_entry::TYPE_FILE;
+				break;
+			}
+			strncpy(e.entry.name, vfs_dirent.name, MAX_NAME_LEN);
+
+			Genode::Path<MAX_PATH_LEN> entry_path(vfs_dirent.name, path());
+			vfs_status(entry_path.base(), e.status);
+
+			/* the packet payload is not necessarily aligned */
+			memcpy(dst + res_length, &e, sizeof(e));
+			res_length += sizeof(e);
+		}
+		return res_length;
+	}
 };
 
 
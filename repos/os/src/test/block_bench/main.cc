@@ -5,6 +5,9 @@
  *
  * Test block device, read blocks add one to the data, write block back, read
  * block again and compare outputs
+ *
+ * If the config contains '<client>' nodes, the benchmark instead runs the
+ * described workloads concurrently, each via a separate block session.
  */
 
 /*
@@ -17,8 +20,11 @@
 /* Genode includes */
 #include <base/allocator_avl.h>
 #include <base/printf.h>
+#include <base/semaphore.h>
 #include <base/sleep.h>
+#include <base/thread.h>
 #include <block_session/connection.h>
+#include <os/config.h>
 #include <util/string.h>
 #include <timer_session/connection.h>
 
@@ -142,10 +148,223 @@ void print_bench_head()
 	printf("----------------------------------------------\n");
 }
 
+
+/**
+ * Client of a multi-client workload, running in a thread of its own
+ */
+struct Client : Thread<8*1024*sizeof(long)>
+{
+	enum Workload { SEQ_READ, SEQ_WRITE, RAND_READ, RAND_WRITE, MIXED };
+
+	enum { TX_BUF_SIZE = 1024*1024, MAX_DEPTH = 32 };
+
+	typedef Genode::String<64> Label;
+
+	Label         label;
+	Workload      workload     = SEQ_READ;
+	size_t        request_size = 4096;
+	unsigned      depth        = 1;
+	unsigned long duration_ms  = 5000;
+
+	/* results */
+	unsigned long      requests       = 0;
+	unsigned long      failed         = 0;
+	unsigned long long bytes          = 0;
+	unsigned long long latency_sum_ms = 0;
+	unsigned long      latency_max_ms = 0;
+	unsigned long      elapsed_ms     = 0;
+
+	Semaphore &done;
+
+	/* submit time of the packets in flight, identified by their offset */
+	struct In_flight { off_t offset; unsigned long submit_ms; bool used; };
+	In_flight in_flight[MAX_DEPTH];
+
+	unsigned long random = 1;
+
+	static Workload _workload(Xml_node node)
+	{
+		char buf[16];
+		try { node.attribute("workload").value(buf, sizeof(buf)); }
+		catch (...) { return SEQ_READ; }
+
+		if (!strcmp(buf, "seq_write"))  return SEQ_WRITE;
+		if (!strcmp(buf, "rand_read"))  return RAND_READ;
+		if (!strcmp(buf, "rand_write")) return RAND_WRITE;
+		if (!strcmp(buf, "mixed"))      return MIXED;
+		return SEQ_READ;
+	}
+
+	Client(Xml_node node, unsigned long duration_ms, Semaphore &done)
+	:
+		Thread("client"), workload(_workload(node)),
+		duration_ms(duration_ms), done(done)
+	{
+		char buf[Label::capacity()] = "";
+		try { node.attribute("label").value(buf, sizeof(buf)); } catch (...) { }
+		label = Label(buf);
+
+		try { node.attribute("request_size").value(&request_size); } catch (...) { }
+		try { node.attribute("depth").value(&depth); }               catch (...) { }
+
+		depth  = max(1U, min(depth, (unsigned)MAX_DEPTH));
+		random = 1 + strlen(buf);
+	}
+
+	unsigned long _random()
+	{
+		/* xorshift */
+		random ^= random << 13;
+		random ^= random >> 7;
+		random ^= random << 17;
+		return random;
+	}
+
+	bool _write()
+	{
+		switch (workload) {
+		case SEQ_WRITE: case RAND_WRITE: return true;
+		case MIXED:                      return _random() % 10 < 3;
+		default:                         return false;
+		}
+	}
+
+	void entry() override
+	{
+		Allocator_avl     block_alloc(env()->heap());
+		Block::Connection block(&block_alloc, TX_BUF_SIZE, label.string());
+		Timer::Connection timer;
+
+		size_t                     block_size = 0;
+		Block::sector_t            block_cnt  = 0;
+		Block::Session::Operations ops;
+		block.info(&block_cnt, &block_size, &ops);
+
+		Block::Session::Tx::Source &source = *block.tx();
+
+		size_t          const count     = max(request_size/block_size, (size_t)1);
+		Block::sector_t const positions = max(block_cnt/count, (Block::sector_t)1);
+		Block::sector_t       next      = 0;
+
+		memset(in_flight, 0, sizeof(in_flight));
+
+		unsigned long const start_ms = timer.elapsed_ms();
+		unsigned long       now_ms   = start_ms;
+		unsigned            pending  = 0;
+
+		while (now_ms - start_ms < duration_ms || pending) {
+
+			/* keep 'depth' requests in flight until the time is up */
+			while (now_ms - start_ms < duration_ms && pending < depth) {
+
+				bool const write = _write();
+				bool const rand  = workload == RAND_READ || workload == RAND_WRITE
+				                || workload == MIXED;
+
+				Block::sector_t const pos = rand ? _random() % positions : next;
+				next = (next + 1) % positions;
+
+				Block::Packet_descriptor p(
+					source.alloc_packet(count*block_size),
+					write ? Block::Packet_descriptor::WRITE
+					      : Block::Packet_descriptor::READ,
+					pos*count, count);
+
+				for (unsigned i = 0; i < depth; i++)
+					if (!in_flight[i].used) {
+						in_flight[i] = { p.offset(), now_ms, true };
+						break;
+					}
+
+				source.submit_packet(p);
+				pending++;
+			}
+
+			/* block for the next acknowledgement */
+			Block::Packet_descriptor p = source.get_acked_packet();
+			now_ms = timer.elapsed_ms();
+			pending--;
+
+			for (unsigned i = 0; i < depth; i++)
+				if (in_flight[i].used && in_flight[i].offset == p.offset()) {
+					unsigned long const latency_ms = now_ms - in_flight[i].submit_ms;
+					latency_sum_ms += latency_ms;
+					latency_max_ms  = max(latency_max_ms, latency_ms);
+					in_flight[i].used = false;
+				}
+
+			if (p.succeeded()) {
+				requests++;
+				bytes += p.block_count()*block_size;
+			} else
+				failed++;
+
+			source.release_packet(p);
+		}
+
+		elapsed_ms = max(now_ms - start_ms, 1UL);
+		done.up();
+	}
+};
+
+
+static void run_clients(Xml_node config)
+{
+	unsigned long duration_ms = 5000;
+	try { config.attribute("duration_ms").value(&duration_ms); } catch (...) { }
+
+	enum { MAX_CLIENTS = 16 };
+	Client   *clients[MAX_CLIENTS];
+	unsigned  num_clients = 0;
+	Semaphore done;
+
+	config.for_each_sub_node("client", [&] (Xml_node node) {
+		if (num_clients < MAX_CLIENTS)
+			clients[num_clients++] = new (env()->heap())
+				Client(node, duration_ms, done);
+	});
+
+	printf("multi-client bench (%u clients, %lu ms)\n", num_clients, duration_ms);
+	printf("==========\n");
+
+	/* start all clients at once */
+	for (unsigned i = 0; i < num_clients; i++)
+		clients[i]->start();
+
+	for (unsigned i = 0; i < num_clients; i++)
+		done.down();
+
+	printf("\n");
+	printf("client           requests  failed      KiB/s  avg lat ms  max lat ms\n");
+	printf("--------------------------------------------------------------------\n");
+
+	for (unsigned i = 0; i < num_clients; i++) {
+		Client const &c = *clients[i];
+		printf("%-16s %8lu  %6lu  %9llu  %10llu  %10lu\n",
+		       c.label.string(), c.requests, c.failed,
+		       (c.bytes*1000/c.elapsed_ms)/1024,
+		       (c.requests + c.failed)
+		       ? c.latency_sum_ms/(c.requests + c.failed) : 0ULL,
+		       c.latency_max_ms);
+	}
+}
+
+
 int main(int argc, char **argv)
 {
 	using namespace Genode;
 
+	bool multi_client = false;
+	try { multi_client = Genode::config()->xml_node().has_sub_node("client"); }
+	catch (...) { }
+
+	if (multi_client) {
+		run_clients(Genode::config()->xml_node());
+		printf("\n");
+		printf("benchmark finished\n");
+		sleep_forever();
+	}
+
 	printf("AHCI bench\n");
 	printf("==========\n");
 
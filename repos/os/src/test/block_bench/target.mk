@@ -1,3 +1,3 @@
 TARGET = test-block_bench
 SRC_CC = main.cc
-LIBS   = base
+LIBS   = base config
@@ -0,0 +1,203 @@
+/*
+ * \brief  File-system throughput benchmark with concurrent clients
+ * \author agent
+ * \date   2015-11-25
+ *
+ * The benchmark opens one file-system session per client. For an increasing
+ * number of concurrently active clients, each client writes and reads back
+ * its own file. The aggregated throughput shows how well the file-system
+ * server scales with the number of clients.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/printf.h>
+#include <base/semaphore.h>
+#include <base/snprintf.h>
+#include <base/sleep.h>
+#include <base/thread.h>
+#include <file_system_session/connection.h>
+#include <os/config.h>
+#include <timer_session/connection.h>
+#include <util/string.h>
+
+using namespace Genode;
+
+
+struct Parameters
+{
+	unsigned        max_clients  = 4;
+	Number_of_bytes file_size    = 4*1024*1024;
+	Number_of_bytes request_size = 16*1024;
+
+	Parameters()
+	{
+		Xml_node config = Genode::config()->xml_node();
+
+		try { config.attribute("clients").value(&max_clients); }        catch (...) { }
+		try { config.attribute("file_size").value(&file_size); }        catch (...) { }
+		try { config.attribute("request_size").value(&request_size); } catch (...) { }
+
+		max_clients = max(max_clients, 1U);
+	}
+};
+
+
+class Client : public Thread<8*1024*sizeof(long)>
+{
+	public:
+
+		enum Operation { WRITE, READ };
+
+	private:
+
+		enum { TX_BUF_SIZE = 256*1024 };
+
+		Allocator_avl             _tx_alloc { env()->heap() };
+		File_system::Connection   _fs;
+		File_system::File_handle  _file;
+		Parameters const         &_params;
+
+		Semaphore  _start;
+		Semaphore &_done;
+		Operation  _op = READ;
+		bool       _success = true;
+
+		static File_system::File_handle _open(File_system::Session &fs,
+		                                      char const *name)
+		{
+			File_system::Dir_handle dir = fs.dir("/", false);
+			File_system::File_handle file =
+				fs.file(dir, name, File_system::READ_WRITE, true);
+			fs.close(dir);
+			return file;
+		}
+
+		void _run()
+		{
+			using File_system::Packet_descriptor;
+			using File_system::seek_off_t;
+
+			File_system::Session::Tx::Source &source = *_fs.tx();
+
+			size_t const request_size = _params.request_size;
+
+			Packet_descriptor::Opcode const op = _op == READ
+			                                   ? Packet_descriptor::READ
+			                                   : Packet_descriptor::WRITE;
+
+			for (seek_off_t offset = 0; offset < _params.file_size; offset += request_size) {
+
+				Packet_descriptor packet(source.alloc_packet(request_size),
+				                         _file, op, request_size, offset);
+
+				if (_op == WRITE)
+					memset(source.packet_content(packet), offset & 0xff, request_size);
+
+				source.submit_packet(packet);
+				packet = source.get_acked_packet();
+
+				if (!packet.succeeded() || packet.length() != request_size)
+					_success = false;
+
+				source.release_packet(packet);
+			}
+		}
+
+	public:
+
+		Client(unsigned id, Parameters const &params, Semaphore &done)
+		:
+			Thread("client"),
+			_fs(_tx_alloc, TX_BUF_SIZE),
+			_file(_open(_fs, _name(id).string())),
+			_params(params), _done(done)
+		{
+			start();
+		}
+
+		static String<32> _name(unsigned id)
+		{
+			char buf[32];
+			snprintf(buf, sizeof(buf), "client-%u.dat", id);
+			return String<32>(buf);
+		}
+
+		/**
+		 * Start operation, completion is signalled via the 'done' semaphore
+		 */
+		void run(Operation op) { _op = op; _start.up(); }
+
+		bool success() const { return _success; }
+
+		void entry() override
+		{
+			for (;;) {
+				_start.down();
+				_run();
+				_done.up();
+			}
+		}
+};
+
+
+static void run_benchmark(Timer::Session &timer, Parameters const &params,
+                          Client **clients, unsigned num_clients,
+                          Semaphore &done, Client::Operation op)
+{
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < num_clients; i++)
+		clients[i]->run(op);
+
+	for (unsigned i = 0; i < num_clients; i++)
+		done.down();
+
+	unsigned long const ms = max(timer.elapsed_ms() - start_ms, 1UL);
+
+	unsigned long long const bytes = (unsigned long long)params.file_size*num_clients;
+	unsigned long const kib_per_sec = (unsigned long)((bytes*1000/ms) / 1024);
+
+	printf("%5s %2u client%s: %8llu KiB in %6lu ms -> %8lu KiB/s\n",
+	       op == Client::READ ? "read" : "write", num_clients,
+	       num_clients == 1 ? " " : "s", bytes / 1024, ms, kib_per_sec);
+}
+
+
+int main()
+{
+	static Parameters params;
+	static Timer::Connection timer;
+	static Semaphore done;
+
+	printf("--- file-system benchmark (file size %zu KiB, request size %zu KiB) ---\n",
+	       (size_t)params.file_size / 1024, (size_t)params.request_size / 1024);
+
+	Client **clients = new (env()->heap()) Client*[params.max_clients];
+	for (unsigned i = 0; i < params.max_clients; i++)
+		clients[i] = new (env()->heap()) Client(i, params, done);
+
+	/* populate the files of all clients */
+	run_benchmark(timer, params, clients, params.max_clients, done, Client::WRITE);
+
+	for (unsigned n = 1; n <= params.max_clients; n *= 2) {
+		run_benchmark(timer, params, clients, n, done, Client::WRITE);
+		run_benchmark(timer, params, clients, n, done, Client::READ);
+	}
+
+	for (unsigned i = 0; i < params.max_clients; i++)
+		if (!clients[i]->success()) {
+			PERR("client %u encountered an I/O error", i);
+			return -1;
+		}
+
+	printf("--- benchmark finished ---\n");
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * \brief  Packet-allocator stress benchmark
+ * \author agent
+ * \date   2015-11-28
+ *
+ * The benchmark fragments the packet buffer with a mix of MTU-sized and
+ * larger packets, and then measures the average costs of allocating and
+ * freeing packets in timestamp ticks (e.g., CPU cycles on x86). The
+ * scenarios resemble the use of the allocator by NIC and block sessions.
+ */
+
+/*
+ * Copyright (C) 2015 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <os/packet_allocator.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+enum {
+	BUFFER_SIZE = 4*1024*1024,
+	NUM_ROUNDS  = 64*1024,
+	MAX_PACKETS = 8*1024,
+};
+
+
+/**
+ * Simple linear congruential generator for reproducible packet sizes
+ */
+struct Random
+{
+	unsigned long _value = 1;
+
+	unsigned long next()
+	{
+		_value = _value*1103515245 + 12345;
+		return (_value >> 16) & 0x7fff;
+	}
+};
+
+
+struct Packet { void *addr = 0; size_t size = 0; };
+
+
+struct Scenario
+{
+	char const *name;
+	size_t      block_size;
+	size_t      small_size;   /* size of most packets */
+	size_t      large_size;   /* size of every fourth packet */
+};
+
+
+static void run_scenario(Scenario const &s)
+{
+	static Packet packets[MAX_PACKETS];
+
+	Packet_allocator alloc(env()->heap(), s.block_size);
+	alloc.add_range(0x1000, BUFFER_SIZE);
+
+	Random random;
+
+	auto packet_size = [&] () {
+		return random.next() % 4 ? s.small_size : s.large_size; };
+
+	/* fill the buffer */
+	unsigned num_packets = 0;
+	for (; num_packets < MAX_PACKETS; num_packets++) {
+		Packet &p = packets[num_packets];
+		p.size = packet_size();
+		if (!alloc.alloc(p.size, &p.addr))
+			break;
+	}
+
+	/* fragment the buffer by releasing every other packet */
+	for (unsigned i = 0; i < num_packets; i += 2) {
+		alloc.free(packets[i].addr, packets[i].size);
+		packets[i].addr = 0;
+	}
+
+	/* replace random packets, keeping the buffer fragmented */
+	Trace::Timestamp alloc_ticks = 0, free_ticks = 0;
+	unsigned long    num_allocs  = 0, num_failed = 0;
+
+	for (unsigned r = 0; r < NUM_ROUNDS; r++) {
+
+		Packet &p = packets[random.next() % num_packets];
+
+		if (p.addr) {
+			Trace::Timestamp const start = Trace::timestamp();
+			alloc.free(p.addr, p.size);
+			free_ticks += Trace::timestamp() - start;
+			p.addr = 0;
+		}
+
+		p.size = packet_size();
+
+		Trace::Timestamp const start = Trace::timestamp();
+		bool const ok = alloc.alloc(p.size, &p.addr);
+		alloc_ticks += Trace::timestamp() - start;
+
+		num_allocs++;
+		if (!ok) {
+			p.addr = 0;
+			num_failed++;
+		}
+	}
+
+	for (unsigned i = 0; i < num_packets; i++)
+		if (packets[i].addr)
+			alloc.free(packets[i].addr, packets[i].size);
+
+	alloc.remove_range(0x1000, BUFFER_SIZE);
+
+	printf("%-6s block size %4zu: %5u packets, alloc %6llu ticks, "
+	       "free %6llu ticks, %lu failed\n",
+	       s.name, s.block_size, num_packets,
+	       (unsigned long long)(alloc_ticks / num_allocs),
+	       (unsigned long long)(free_ticks / num_allocs), num_failed);
+}
+
+
+int main()
+{
+	printf("--- packet-allocator benchmark ---\n");
+
+	static Scenario const scenarios[] = {
+		{ "nic",   1600, 1600,  1600 },
+		{ "nic",    512, 1514,   128 },
+		{ "block",  512, 4096, 65536 },
+		{ "block", 4096, 4096, 65536 },
+	};
+
+	for (Scenario const &s : scenarios)
+		run_scenario(s);
+
+	printf("--- packet-allocator benchmark finished ---\n");
+	return 0;
+}
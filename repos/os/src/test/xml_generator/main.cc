@@ -66,8 +66,15 @@ int main(int argc, char **argv)
 	 */
 	try {
 		fill_buffer_with_xml(dst, 20); }
-	catch (Genode::Xml_generator::Buffer_exceeded) {
-		printf("buffer exceeded (expected error)\n"); }
+	catch (Genode::Xml_generator::Buffer_exceeded &e) {
+		printf("buffer exceeded (expected error)\n");
+
+		/* the exception reports the size needed for the complete output */
+		if (e.required != used) {
+			printf("unexpected required size %zd\n", e.required);
+			return 1;
+		}
+	}
 
 	/*
 	 * Test the sanitizing of XML node content